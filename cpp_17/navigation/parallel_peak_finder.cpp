@@ -0,0 +1,196 @@
+#include <algorithm>
+
+#include "parallel_peak_finder.h"
+
+namespace Navtech {
+
+    Parallel_peak_finder::Parallel_peak_finder(std::size_t worker_count, std::size_t in_flight) :
+        slots(std::max<std::size_t>(in_flight, 1))
+    {
+        worker_count = std::max<std::size_t>(worker_count, 1);
+
+        for (std::size_t n = 0; n < worker_count; ++n) {
+            auto worker = allocate_owned<Worker>();
+            auto& owned = *worker;
+
+            // The worker's slot is not touched by any other thread until
+            // the worker marks it done
+            //
+            owned.finder.set_target_callback([&owned](const Azimuth_target& target) {
+                owned.slot->target      = target;
+                owned.slot->has_targets = true;
+            });
+            workers.push_back(std::move(worker));
+        }
+
+        for (auto& worker : workers) {
+            worker->thread = std::thread(&Parallel_peak_finder::work, this, std::ref(*worker));
+        }
+    }
+
+
+    Parallel_peak_finder::~Parallel_peak_finder()
+    {
+        {
+            std::lock_guard lock { mutex };
+            stopping = true;
+        }
+        work_ready.notify_all();
+        slot_freed.notify_all();
+
+        for (auto& worker : workers) {
+            if (worker->thread.joinable()) worker->thread.join();
+        }
+    }
+
+
+    std::size_t Parallel_peak_finder::default_worker_count()
+    {
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+
+    void Parallel_peak_finder::set_target_callback(std::function<void(const Azimuth_target&)> fn)
+    {
+        std::lock_guard lock { callback_mutex };
+        target_callback = std::move(fn);
+    }
+
+
+    void Parallel_peak_finder::fft_data_handler(const Fft_data::Pointer& fft_data)
+    {
+        std::unique_lock lock { mutex };
+        if (!configured) return;
+
+        slot_freed.wait(lock, [this] { return stopping || slots[submitted % slots.size()].state == Slot_state::free; });
+        if (stopping) return;
+
+        auto& slot       = slots[submitted % slots.size()];
+        slot.sequence    = submitted;
+        slot.state       = Slot_state::queued;
+        slot.fft_data    = fft_data;
+        slot.has_targets = false;
+        ++submitted;
+
+        lock.unlock();
+        work_ready.notify_all();
+    }
+
+
+    void Parallel_peak_finder::configure(const Configuration_data::Pointer& config,
+                                         const Configuration_data::ProtobufPointer& protobuf,
+                                         double thresh,
+                                         std::uint8_t bins_to_operate_upon,
+                                         std::uint16_t min_bin_to_operate_upon,
+                                         BufferModes mode,
+                                         std::size_t buf_length,
+                                         std::uint32_t max_peaks_per_azi,
+                                         Integration_window buffer_window)
+    {
+        flush();
+
+        std::lock_guard lock { mutex };
+        for (auto& worker : workers) {
+            worker->finder.configure(config,
+                                     protobuf,
+                                     thresh,
+                                     bins_to_operate_upon,
+                                     min_bin_to_operate_upon,
+                                     mode,
+                                     buf_length,
+                                     max_peaks_per_azi,
+                                     buffer_window);
+        }
+
+        // A buffered search depends on the azimuths before it, so only the
+        // first worker is used
+        //
+        auto shared = (mode == BufferModes::off);
+        stride      = shared ? workers.size() : 1;
+        for (std::size_t n = 0; n < workers.size(); ++n) {
+            workers[n]->next = (shared || n == 0) ? submitted + n : idle;
+        }
+        configured = true;
+    }
+
+
+    void Parallel_peak_finder::set_threshold(double thresh)
+    {
+        flush();
+
+        std::lock_guard lock { mutex };
+        for (auto& worker : workers) {
+            worker->finder.set_threshold(thresh);
+        }
+    }
+
+
+    void Parallel_peak_finder::flush()
+    {
+        std::unique_lock lock { mutex };
+        slot_freed.wait(lock, [this] { return stopping || delivered == submitted; });
+    }
+
+
+    void Parallel_peak_finder::work(Worker& worker)
+    {
+        auto ready = [this, &worker] {
+            if (stopping) return true;
+            if (worker.next == idle) return false;
+
+            auto& slot = slots[worker.next % slots.size()];
+            return slot.state == Slot_state::queued && slot.sequence == worker.next;
+        };
+
+        std::unique_lock lock { mutex };
+        while (true) {
+            work_ready.wait(lock, ready);
+            if (stopping) return;
+
+            worker.slot   = &slots[worker.next % slots.size()];
+            auto fft_data = std::move(worker.slot->fft_data);
+            lock.unlock();
+
+            worker.finder.fft_data_handler(fft_data);
+
+            lock.lock();
+            worker.slot->state = Slot_state::done;
+            worker.next += stride;
+            lock.unlock();
+
+            deliver();
+            lock.lock();
+        }
+    }
+
+
+    // Deliver every finished azimuth that is next in sequence. Whichever
+    // worker finishes the oldest azimuth delivers it, and any finished
+    // after it.
+    //
+    void Parallel_peak_finder::deliver()
+    {
+        std::lock_guard delivering { callback_mutex };
+
+        while (true) {
+            Slot* slot = nullptr;
+            {
+                std::lock_guard lock { mutex };
+                if (delivered == submitted) return;
+
+                slot = &slots[delivered % slots.size()];
+                if (slot->state != Slot_state::done || slot->sequence != delivered) return;
+            }
+
+            if (slot->has_targets && target_callback != nullptr) target_callback(slot->target);
+
+            {
+                std::lock_guard lock { mutex };
+                slot->state = Slot_state::free;
+                ++delivered;
+            }
+            slot_freed.notify_all();
+        }
+    }
+
+} // namespace Navtech
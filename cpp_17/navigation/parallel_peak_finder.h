@@ -0,0 +1,110 @@
+#ifndef PARALLEL_PEAK_FINDER_H
+#define PARALLEL_PEAK_FINDER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../utility/pointer_types.h"
+#include "peak_finder.h"
+
+namespace Navtech {
+
+    // --------------------------------------------------------------------------------------------------
+    // A Peak_finder front-end that searches azimuths on a pool of worker
+    // threads, each with its own Peak_finder, and delivers the targets in
+    // the order the azimuths arrived. The targets, and the order of the
+    // callbacks, are the same as from a single Peak_finder.
+    //
+    // Azimuths are dealt to the workers in turn. In the buffer modes each
+    // FFT is integrated with those before it, so all azimuths go to one
+    // worker; that still takes the search off the calling thread.
+    //
+    // Up to in_flight azimuths may be queued, being searched or waiting
+    // for an earlier azimuth to finish. fft_data_handler() blocks while
+    // they are all in use. The target callback is called on a worker
+    // thread, one call at a time; it must not call back into the finder.
+    //
+    // configure() and set_threshold() wait for the azimuths already handed
+    // in to be delivered, then apply to every worker.
+    //
+    class Parallel_peak_finder {
+    public:
+        explicit Parallel_peak_finder(std::size_t worker_count = default_worker_count(), std::size_t in_flight = 32);
+        ~Parallel_peak_finder();
+
+        Parallel_peak_finder(const Parallel_peak_finder&) = delete;
+        Parallel_peak_finder& operator=(const Parallel_peak_finder&) = delete;
+
+        void set_target_callback(std::function<void(const Azimuth_target&)> fn = nullptr);
+        void fft_data_handler(const Fft_data::Pointer& fft_data);
+        void configure(const Configuration_data::Pointer& data,
+                       const Configuration_data::ProtobufPointer& protobuf_configuration,
+                       double threshold,
+                       std::uint8_t bins_to_operate_upon,
+                       std::uint16_t min_bin_to_operate_upon,
+                       BufferModes mode,
+                       std::size_t buf_length,
+                       std::uint32_t max_peaks_per_azi,
+                       Integration_window buffer_window = Integration_window::block);
+        void set_threshold(double thresh);
+
+        // Wait until every azimuth handed in has been delivered
+        //
+        void flush();
+
+        std::size_t worker_count() const { return workers.size(); }
+        std::size_t in_flight_depth() const { return slots.size(); }
+
+        static std::size_t default_worker_count();
+
+    private:
+        enum class Slot_state { free, queued, done };
+
+        struct Slot
+        {
+            std::uint64_t sequence { 0 };
+            Slot_state state { Slot_state::free };
+            Fft_data::Pointer fft_data {};
+            Azimuth_target target { 0, 0.0, 0, 0 };
+            bool has_targets { false };
+        };
+
+        static constexpr std::uint64_t idle { std::numeric_limits<std::uint64_t>::max() };
+
+        // Each worker searches every stride'th azimuth from next
+        //
+        struct Worker
+        {
+            Peak_finder finder {};
+            Slot* slot { nullptr };
+            std::uint64_t next { idle };
+            std::thread thread {};
+        };
+
+        std::mutex mutex;
+        std::condition_variable work_ready;
+        std::condition_variable slot_freed;
+        bool configured { false };
+        bool stopping { false };
+
+        std::vector<Slot> slots;
+        std::vector<Owner_of<Worker>> workers {};
+        std::uint64_t stride { 1 };
+        std::uint64_t submitted { 0 };
+        std::uint64_t delivered { 0 };
+
+        std::mutex callback_mutex;
+        std::function<void(const Azimuth_target&)> target_callback = nullptr;
+
+        void work(Worker& worker);
+        void deliver();
+    };
+
+} // namespace Navtech
+
+#endif // PARALLEL_PEAK_FINDER_H
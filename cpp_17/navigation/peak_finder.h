@@ -3,23 +3,27 @@
 
 #include <atomic>
 #include <cstdint>
-#include <deque>
 #include <functional>
 #include <vector>
 
 #include "../network/radar_client.h"
+#include "../rotation/temporal_integrator.h"
+#include "peak_resolve.h"
 
 namespace Navtech {
 
-    // Buffer modes are really only useful with a staring radar
+    // Buffer modes are really only useful with a staring radar. Peaks are
+    // found in the power average, or the maximum, of each buf_length FFTs
+    // (a block window) or of the latest buf_length FFTs (a sliding window).
     //
     enum class BufferModes { off = 0, average = 1, max = 2 };
 
     struct Target
     {
+        Target() = default;
         Target(double rng, double pow) : range { rng }, power { pow } { }
-        double range;
-        double power;
+        double range { 0.0 };
+        double power { 0.0 };
     };
 
     struct Azimuth_target
@@ -45,37 +49,55 @@ namespace Navtech {
                        std::uint16_t min_bin_to_operate_upon,
                        BufferModes mode,
                        std::size_t buf_length,
-                       std::uint32_t max_peaks_per_azi);
+                       std::uint32_t max_peaks_per_azi,
+                       Integration_window buffer_window = Integration_window::block);
         void set_threshold(double thresh);
 
+        // Find the peaks in one azimuth of size samples, which must be
+        // range_in_bins long, writing up to capacity (and no more than
+        // max_peaks_per_azimuth) targets. Returns the number written.
+        // Sample is std::uint8_t, for FFT data, or double. The samples are
+        // searched in place and nothing is allocated once configured.
+        //
+        template <typename Sample>
+        std::size_t find_targets(const Sample* data, std::size_t size, Target* targets, std::size_t capacity);
+
     private:
         double threshold { 0 };
-        std::uint8_t bins_to_operate_on { 4 };
+        std::uint8_t bins_to_operate_on { 5 };
+        Peak_resolve::Resolver resolver { nullptr };
         std::uint16_t min_bin_to_operate_on { 50 };
         bool awaiting_rise { false };
-        std::deque<std::vector<double>> data_buffer {};
+        Temporal_integrator data_buffer {};
+        std::vector<double> buffered_data {};
+
+        // FFT data is searched for peaks on its uint8 samples; see
+        // Peak_kernels
+        //
+        std::vector<std::uint32_t> falling_mask {};
+        std::vector<std::uint32_t> candidate_mask {};
         BufferModes buffer_mode { BufferModes::off };
         std::size_t buffer_length { 10 };
         std::uint32_t max_peaks_per_azimuth { 10 };
 
+        // Reused for every azimuth, with capacity for target_capacity
+        // targets
+        //
+        Azimuth_target azimuth_target { 0, 0.0, 0, 0 };
+        std::size_t target_capacity { 1 };
+
         Configuration_data::Pointer configuration;
         Configuration_data::ProtobufPointer protobuf_configuration;
+        Range_table::Pointer range_table;
 
         std::function<void(const Azimuth_target&)> target_callback = nullptr;
 
-        double peak_resolve(const std::vector<double>& data,
-                            const std::uint16_t& peak_bin,
-                            const std::uint8_t& bins_to_operate_upon);
-        uint16_t find_peak_bin(const std::vector<double>& data,
+        template <typename Sample>
+        double peak_resolve(const Sample* data, std::uint16_t peak_bin) const;
+        uint16_t find_peak_bin(const double* data,
                                const std::uint16_t& start_bin,
                                const std::uint16_t& end_bin,
                                const std::uint8_t& bins_to_operate_upon);
-
-        void find_peaks(std::uint16_t azimuth,
-                        double angle,
-                        std::uint32_t ntp_seconds,
-                        std::uint32_t ntp_split_seconds,
-                        const std::vector<double>& data);
     };
 
 } // namespace Navtech
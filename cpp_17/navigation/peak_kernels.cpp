@@ -0,0 +1,221 @@
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "peak_kernels.h"
+
+namespace Navtech::Peak_kernels {
+
+    static inline unsigned lowest_set_bit(std::uint32_t bits)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, bits);
+        return index;
+#else
+        return static_cast<unsigned>(__builtin_ctz(bits));
+#endif
+    }
+
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+    // One bit per lane, from the top bit of each lane
+    //
+    static inline std::uint32_t movemask(uint8x16_t lanes)
+    {
+        const uint8x16_t weights = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+
+        auto bits = vandq_u8(lanes, weights);
+        bits      = vpaddq_u8(bits, bits);
+        bits      = vpaddq_u8(bits, bits);
+        bits      = vpaddq_u8(bits, bits);
+        return vgetq_lane_u8(bits, 0) | (vgetq_lane_u8(bits, 1) << 8);
+    }
+#endif
+
+
+    void find_candidates(const std::uint8_t* data,
+                         std::size_t size,
+                         double threshold,
+                         std::uint32_t* falling,
+                         std::uint32_t* candidates)
+    {
+        std::memset(falling, 0, mask_words(size) * sizeof(std::uint32_t));
+        std::memset(candidates, 0, mask_words(size) * sizeof(std::uint32_t));
+
+        // Samples are whole numbers, so sample > threshold is the same as
+        // sample > floor(threshold). A NaN threshold passes nothing.
+        //
+        auto level      = std::floor(threshold);
+        auto above_all  = level < 0.0;
+        auto above_none = !(level < 255.0);
+        auto level_byte = static_cast<std::uint8_t>(above_all || above_none ? 0 : level);
+
+        std::size_t n = 0;
+
+        // Each block compares 32 bins with the 32 after them, so stops one
+        // bin short of the end
+        //
+#if defined(__AVX2__)
+        const auto bias            = _mm256_set1_epi8(static_cast<char>(0x80));
+        const auto threshold_lanes = _mm256_xor_si256(_mm256_set1_epi8(static_cast<char>(level_byte)), bias);
+
+        for (; n + 33 <= size; n += 32) {
+            auto here = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + n)), bias);
+            auto next = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + n + 1)), bias);
+
+            auto fall  = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(here, next)));
+            auto above = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(here, threshold_lanes)));
+            if (above_all) above = ~0u;
+            if (above_none) above = 0;
+
+            falling[n / 32]    = fall;
+            candidates[n / 32] = fall & above;
+        }
+#elif defined(__SSE2__)
+        const auto bias            = _mm_set1_epi8(static_cast<char>(0x80));
+        const auto threshold_lanes = _mm_xor_si128(_mm_set1_epi8(static_cast<char>(level_byte)), bias);
+
+        for (; n + 33 <= size; n += 32) {
+            std::uint32_t fall  = 0;
+            std::uint32_t above = 0;
+
+            for (auto half = 0; half < 2; ++half) {
+                auto src  = data + n + half * 16;
+                auto here = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), bias);
+                auto next = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 1)), bias);
+
+                fall |= static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(here, next))) << (half * 16);
+                above |= static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(here, threshold_lanes)))
+                         << (half * 16);
+            }
+            if (above_all) above = ~0u;
+            if (above_none) above = 0;
+
+            falling[n / 32]    = fall;
+            candidates[n / 32] = fall & above;
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        const auto threshold_lanes = vdupq_n_u8(level_byte);
+
+        for (; n + 33 <= size; n += 32) {
+            std::uint32_t fall  = 0;
+            std::uint32_t above = 0;
+
+            for (auto half = 0; half < 2; ++half) {
+                auto src  = data + n + half * 16;
+                auto here = vld1q_u8(src);
+
+                fall |= movemask(vcgtq_u8(here, vld1q_u8(src + 1))) << (half * 16);
+                above |= movemask(vcgtq_u8(here, threshold_lanes)) << (half * 16);
+            }
+            if (above_all) above = ~0u;
+            if (above_none) above = 0;
+
+            falling[n / 32]    = fall;
+            candidates[n / 32] = fall & above;
+        }
+#endif
+
+        for (; n + 1 < size; ++n) {
+            if (data[n] <= data[n + 1]) continue;
+
+            auto bit = 1u << (n % 32);
+            falling[n / 32] |= bit;
+            if (above_none || (!above_all && data[n] <= level_byte)) continue;
+            candidates[n / 32] |= bit;
+        }
+    }
+
+
+    std::size_t next_set(const std::uint32_t* mask, std::size_t from, std::size_t to)
+    {
+        if (from >= to) return to;
+
+        auto word = from / 32;
+        auto bits = mask[word] & (~0u << (from % 32));
+
+        while (bits == 0) {
+            if (++word * 32 >= to) return to;
+            bits = mask[word];
+        }
+
+        auto bin = word * 32 + lowest_set_bit(bits);
+        return (bin < to) ? bin : to;
+    }
+
+
+    std::size_t next_clear(const std::uint32_t* mask, std::size_t from, std::size_t to)
+    {
+        if (from >= to) return to;
+
+        auto word = from / 32;
+        auto bits = ~mask[word] & (~0u << (from % 32));
+
+        while (bits == 0) {
+            if (++word * 32 >= to) return to;
+            bits = ~mask[word];
+        }
+
+        auto bin = word * 32 + lowest_set_bit(bits);
+        return (bin < to) ? bin : to;
+    }
+
+
+    std::size_t candidate_bins(const std::uint32_t* candidates,
+                               std::size_t first_bin,
+                               std::size_t size,
+                               std::uint16_t* out,
+                               std::size_t capacity)
+    {
+        std::size_t count = 0;
+        auto bin          = next_set(candidates, first_bin, size);
+
+        while (bin < size && count < capacity) {
+            out[count++] = static_cast<std::uint16_t>(bin);
+            bin          = next_set(candidates, bin + 1, size);
+        }
+        return count;
+    }
+
+
+    std::uint16_t next_peak(const std::uint32_t* falling,
+                            const std::uint32_t* candidates,
+                            std::uint16_t start_bin,
+                            std::uint16_t end_bin,
+                            std::uint8_t bins_to_operate_upon,
+                            bool& awaiting_rise)
+    {
+        if (start_bin > (end_bin - bins_to_operate_upon)) return end_bin;
+
+        std::size_t to  = end_bin - bins_to_operate_upon + 1;
+        std::size_t bin = start_bin;
+
+        // Skip the falling edge of the previous peak, so that it is not
+        // found again
+        //
+        if (awaiting_rise) {
+            bin = next_clear(falling, bin, to);
+            if (bin == to) return end_bin;
+            awaiting_rise = false;
+        }
+
+        bin = next_set(candidates, bin, to);
+        if (bin == to) return end_bin;
+
+        awaiting_rise = true;
+        return static_cast<std::uint16_t>(bin);
+    }
+
+} // namespace Navtech::Peak_kernels
@@ -0,0 +1,59 @@
+#ifndef PEAK_KERNELS_H
+#define PEAK_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// --------------------------------------------------------------------------------------------------
+// Peak detection on rows of 8-bit FFT samples, 32 bins at a time.
+//
+// A bin is falling if it is greater than the bin after it, and is a
+// candidate peak if it is also above the threshold. Both are computed as
+// bit masks, bit n of word n / 32 for bin n, with an AVX2, SSE2 (x86-64)
+// or NEON (AArch64) implementation selected at compile time and a scalar
+// fallback that gives identical results. The peak search then skips
+// between set bits rather than testing bins one at a time.
+//
+namespace Navtech::Peak_kernels {
+
+    constexpr std::size_t mask_words(std::size_t size) { return (size + 31) / 32; }
+
+    // falling and candidates must each hold mask_words(size) words. The
+    // last bin has nothing after it, so is never falling.
+    //
+    void find_candidates(const std::uint8_t* data,
+                         std::size_t size,
+                         double threshold,
+                         std::uint32_t* falling,
+                         std::uint32_t* candidates);
+
+    // The first set, or clear, bit from bit from up to, but not
+    // including, bit to; to if there is none.
+    //
+    std::size_t next_set(const std::uint32_t* mask, std::size_t from, std::size_t to);
+    std::size_t next_clear(const std::uint32_t* mask, std::size_t from, std::size_t to);
+
+    // The indices of the candidate bins from first_bin, in order, up to
+    // capacity of them. Returns the number written.
+    //
+    std::size_t candidate_bins(const std::uint32_t* candidates,
+                               std::size_t first_bin,
+                               std::size_t size,
+                               std::uint16_t* out,
+                               std::size_t capacity);
+
+    // The search made by Peak_finder: the first candidate in
+    // [start_bin, end_bin - bins_to_operate_upon], skipping the falling
+    // edge of the previous peak while awaiting_rise is set. Returns end_bin
+    // if there is none.
+    //
+    std::uint16_t next_peak(const std::uint32_t* falling,
+                            const std::uint32_t* candidates,
+                            std::uint16_t start_bin,
+                            std::uint16_t end_bin,
+                            std::uint8_t bins_to_operate_upon,
+                            bool& awaiting_rise);
+
+} // namespace Navtech::Peak_kernels
+
+#endif // PEAK_KERNELS_H
@@ -0,0 +1,129 @@
+#ifndef PEAK_RESOLVE_H
+#define PEAK_RESOLVE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// --------------------------------------------------------------------------------------------------
+// Sub-bin peak resolution by a least-squares quadratic fit,
+// y = b0 + b1.x + b2.x^2, through a window of samples around a peak bin.
+// The peak is at x = -b1 / 2b2.
+//
+// The window holds Bins samples at x = -(Bins - 1) / 2 onwards, so x = 0
+// is the peak bin. The normal equations depend only on x, so for each
+// window size b1 and b2 are fixed weighted sums of the samples. The
+// weights are computed at compile time and resolving a peak is two dot
+// products and a division.
+//
+namespace Navtech::Peak_resolve {
+
+    constexpr std::uint8_t min_bins { 5 };
+    constexpr std::uint8_t max_bins { 15 };
+
+    // Weights for b1 and b2, both scaled by the determinant of the normal
+    // equations, which cancels in -b1 / 2b2. The scaled weights are whole
+    // numbers, so the sums are exact for 8-bit samples.
+    //
+    template <std::uint8_t Bins>
+    struct Window_weights
+    {
+        std::array<double, Bins> linear {};
+        std::array<double, Bins> quadratic {};
+    };
+
+
+    template <std::uint8_t Bins>
+    constexpr Window_weights<Bins> make_weights()
+    {
+        constexpr int first_x = -((Bins - 1) / 2);
+
+        // Moments of x: S0 = n, S1 = sum(x), ... S4 = sum(x^4)
+        //
+        double S[5] {};
+        for (int i = 0; i < Bins; ++i) {
+            double x     = first_x + i;
+            double power = 1.0;
+            for (auto& moment : S) {
+                moment += power;
+                power *= x;
+            }
+        }
+
+        // Rows 1 and 2 of the adjugate of the (symmetric) normal matrix
+        //
+        //   | S0 S1 S2 |
+        //   | S1 S2 S3 |
+        //   | S2 S3 S4 |
+        //
+        double linear[3]    = { -(S[1] * S[4] - S[3] * S[2]), S[0] * S[4] - S[2] * S[2], -(S[0] * S[3] - S[1] * S[2]) };
+        double quadratic[3] = { S[1] * S[3] - S[2] * S[2], -(S[0] * S[3] - S[1] * S[2]), S[0] * S[2] - S[1] * S[1] };
+
+        Window_weights<Bins> weights {};
+        for (int i = 0; i < Bins; ++i) {
+            double x             = first_x + i;
+            weights.linear[i]    = linear[0] + linear[1] * x + linear[2] * x * x;
+            weights.quadratic[i] = quadratic[0] + quadratic[1] * x + quadratic[2] * x * x;
+        }
+        return weights;
+    }
+
+
+    template <std::uint8_t Bins>
+    inline constexpr Window_weights<Bins> weights = make_weights<Bins>();
+
+
+    // The offset of the peak from the window's centre bin, in bins.
+    // window points to the first of its Bins samples.
+    //
+    template <std::uint8_t Bins>
+    double offset(const double* window)
+    {
+        double b1 = 0.0;
+        double b2 = 0.0;
+        for (std::size_t i = 0; i < Bins; ++i) {
+            b1 += weights<Bins>.linear[i] * window[i];
+            b2 += weights<Bins>.quadratic[i] * window[i];
+        }
+        return -b1 / (2.0 * b2);
+    }
+
+
+    using Resolver = double (*)(const double* window);
+
+    // The resolver for a window of bins samples; nullptr outside
+    // [min_bins, max_bins].
+    //
+    inline Resolver resolver(std::uint8_t bins)
+    {
+        switch (bins) {
+            case 5:
+                return offset<5>;
+            case 6:
+                return offset<6>;
+            case 7:
+                return offset<7>;
+            case 8:
+                return offset<8>;
+            case 9:
+                return offset<9>;
+            case 10:
+                return offset<10>;
+            case 11:
+                return offset<11>;
+            case 12:
+                return offset<12>;
+            case 13:
+                return offset<13>;
+            case 14:
+                return offset<14>;
+            case 15:
+                return offset<15>;
+            default:
+                return nullptr;
+        }
+    }
+
+} // namespace Navtech::Peak_resolve
+
+#endif // PEAK_RESOLVE_H
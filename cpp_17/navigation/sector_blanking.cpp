@@ -39,6 +39,16 @@ namespace Navtech {
     }
 
 
+    bool Blanking_sector_list::contains(const Utility::Angle& angle) const
+    {
+        using std::any_of;
+        using std::begin;
+        using std::end;
+
+        return any_of(begin(sectors), end(sectors), [&angle](const Sector& s) { return s.contains(angle); });
+    }
+
+
     std::vector<std::uint8_t> Blanking_sector_list::to_vector() const
     {
         using namespace std;
@@ -102,6 +112,41 @@ namespace Navtech {
         }
         return os;
     }
+
+
+    Blanking_mask::Blanking_mask(const Blanking_sector_list& sector_list, std::uint16_t encoder_size)
+    {
+        compile(sector_list, encoder_size);
+    }
+
+
+    void Blanking_mask::compile(const Blanking_sector_list& sector_list, std::uint16_t encoder_size)
+    {
+        // Each encoder position is blanked if its angle lies in any of the
+        // sectors; the sectors are not consulted again.
+        //
+        positions     = encoder_size;
+        blanked_count = 0;
+        bits.assign((encoder_size + 63u) / 64u, 0);
+
+        if (sector_list.empty()) return;
+
+        for (std::uint32_t azimuth { 0 }; azimuth < encoder_size; ++azimuth) {
+            Utility::Angle angle { (azimuth * 360.0f) / encoder_size };
+            if (!sector_list.contains(angle)) continue;
+
+            bits[azimuth >> 6] |= (std::uint64_t { 1 } << (azimuth & 63));
+            ++blanked_count;
+        }
+    }
+
+
+    void Blanking_mask::clear()
+    {
+        bits.clear();
+        positions     = 0;
+        blanked_count = 0;
+    }
     
     
 } // namespace Navtech
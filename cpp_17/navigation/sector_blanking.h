@@ -37,6 +37,18 @@ namespace Navtech {
             return Pair::second;
         }
 
+        // Sectors run clockwise from start to finish, inclusive, and
+        // wrap through zero if finish is less than start.
+        //
+        bool contains(const Utility::Angle& angle) const
+        {
+            auto value = angle.to_float();
+            if (start().to_float() <= finish().to_float()) {
+                return value >= start().to_float() && value <= finish().to_float();
+            }
+            return value >= start().to_float() || value <= finish().to_float();
+        }
+
         friend std::ostream& operator<<(std::ostream& os, const Sector& s)
         {
             os << "[" << s.start() << ", " << s.finish() << "]";
@@ -53,6 +65,9 @@ namespace Navtech {
         bool add(const Sector& sector);
         bool add(Sector&& sector);
 
+        bool contains(const Utility::Angle& angle) const;
+        bool empty() const { return sectors.empty(); }
+
         friend std::ostream& operator<<(std::ostream& os, const Blanking_sector_list& bl);
 
         std::vector<std::uint8_t> to_vector() const;
@@ -64,6 +79,38 @@ namespace Navtech {
         std::vector<Sector> sectors { };
     };
 
+
+    // What the client does with azimuths in a blanked sector: drop them
+    // altogether, or pass them on with their FFT data set to zero.
+    //
+    enum class Blanking_action { drop, zero };
+
+
+    // A Blanking_sector_list compiled to one bit per encoder position,
+    // so that an azimuth can be tested with a single bit test.
+    //
+    class Blanking_mask {
+    public:
+        Blanking_mask() = default;
+        Blanking_mask(const Blanking_sector_list& sector_list, std::uint16_t encoder_size);
+
+        void compile(const Blanking_sector_list& sector_list, std::uint16_t encoder_size);
+        void clear();
+
+        bool empty() const { return blanked_count == 0; }
+        std::uint16_t encoder_size() const { return positions; }
+
+        bool is_blanked(std::uint16_t azimuth) const
+        {
+            return azimuth < positions && ((bits[azimuth >> 6] >> (azimuth & 63)) & 1u);
+        }
+
+    private:
+        std::vector<std::uint64_t> bits { };
+        std::uint16_t positions { 0 };
+        std::uint32_t blanked_count { 0 };
+    };
+
 } // namespace Navtech
 
 #endif // SECTOR_BLANKING_H
\ No newline at end of file
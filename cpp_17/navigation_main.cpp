@@ -66,11 +66,12 @@ void configuration_data_handler(const Configuration_data::Pointer& configuration
                                 const Configuration_data::ProtobufPointer& protobuf_configuration)
 {
     double threshold                    = 80.0;             // Threshold in dB
-    std::uint8_t bins_to_operate_on     = 4;                // Radar bins window size to search for peaks in
+    std::uint8_t bins_to_operate_on     = 5;                // Radar bins window size to search for peaks in
     std::uint16_t start_bin             = 50;               // Start Bin
     BufferModes buffer_mode             = BufferModes::off; // Buffer mode should only be used with a staring radar
     std::size_t buffer_length           = 10;               // Buffer Length
     std::uint32_t max_peaks_per_azimuth = 10;               // Maximum number of peaks to find in a single azimuth
+    Integration_window buffer_window    = Integration_window::block; // Blocks of FFTs, or a sliding window
 
     peak_finder.configure(configuration,
                           protobuf_configuration,
@@ -79,7 +80,8 @@ void configuration_data_handler(const Configuration_data::Pointer& configuration
                           start_bin,
                           buffer_mode,
                           buffer_length,
-                          max_peaks_per_azimuth);
+                          max_peaks_per_azimuth,
+                          buffer_window);
 
     radar_client.start_fft_data();
     // radar_client.start_health_data(); //Uncomment to receive health messages
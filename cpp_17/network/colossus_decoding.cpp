@@ -0,0 +1,96 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <WinSock2.h>
+#else
+#include <netinet/in.h>
+#endif
+
+#include "colossus_decoding.h"
+
+namespace Navtech::Colossus_decoding {
+
+    Configuration_data::ProtobufPointer protobuf_configuration(const Network::Colossus_protocol::Configuration& config)
+    {
+        auto protobuf = allocate_shared<Colossus::Protobuf::ConfigurationData>();
+        protobuf->ParseFromString(config.to_string());
+        return protobuf;
+    }
+
+
+    Configuration_data::Pointer configuration_data(const Network::Colossus_protocol::Configuration& config,
+                                                   const Colossus::Protobuf::ConfigurationData& protobuf,
+                                                   const Range_table::Pointer& range_table)
+    {
+        auto configuration_data                    = allocate_shared<Configuration_data>();
+        configuration_data->azimuth_samples        = config.azimuth_samples();
+        configuration_data->bin_size               = protobuf.rangeresolutionmetres();
+        configuration_data->range_in_bins          = config.range_in_bins();
+        configuration_data->encoder_size           = config.encoder_size();
+        configuration_data->expected_rotation_rate = config.rotation_speed() / 1000;
+        configuration_data->range_gain             = config.range_gain();
+        configuration_data->range_offset           = config.range_offset();
+        configuration_data->staring_mode           = protobuf.staringmode() != 0;
+        configuration_data->range_table            = range_table;
+
+        if (configuration_data->range_table == nullptr) {
+            configuration_data->range_table = allocate_shared<const Range_table>(
+                config.range_in_bins(), configuration_data->bin_size, config.range_gain(), config.range_offset());
+        }
+        return configuration_data;
+    }
+
+
+    Fft_data::Pointer fft_data(const Network::Colossus_protocol::Fft_data& fft, std::uint16_t encoder_size)
+    {
+        auto fftData               = allocate_shared<Fft_data>();
+        fftData->azimuth           = fft.azimuth();
+        fftData->angle             = (fft.azimuth() * 360.0f) / encoder_size;
+        fftData->sweep_counter     = fft.sweep_counter();
+        fftData->ntp_seconds       = fft.ntp_seconds();
+        fftData->ntp_split_seconds = fft.ntp_split_seconds();
+        return fftData;
+    }
+
+
+    Navigation_data::Pointer navigation_data(const Network::Colossus_protocol::Navigation_data& navigation,
+                                             std::uint16_t encoder_size,
+                                             bool with_peaks)
+    {
+        auto navigation_data               = allocate_shared<Navigation_data>();
+        navigation_data->azimuth           = navigation.azimuth();
+        navigation_data->ntp_seconds       = navigation.ntp_seconds();
+        navigation_data->ntp_split_seconds = navigation.ntp_split_seconds();
+        navigation_data->angle             = (navigation.azimuth() * 360.0f) / encoder_size;
+        if (!with_peaks) return navigation_data;
+
+        auto targets     = navigation.to_vector();
+        auto peaks_count = targets.size() / nav_data_record_length;
+        navigation_data->peaks.reserve(peaks_count);
+
+        for (auto i = 0u; i < (peaks_count * nav_data_record_length); i += nav_data_record_length) {
+            std::uint32_t peak_resolve = 0;
+            std::memcpy(&peak_resolve, &targets[i], sizeof(peak_resolve));
+            std::uint16_t power = 0;
+            std::memcpy(&power, &targets[i + sizeof(peak_resolve)], sizeof(power));
+            navigation_data->peaks.push_back(
+                std::make_tuple<float, std::uint16_t>(htonl(peak_resolve) / range_multiplier_float, htons(power)));
+        }
+        return navigation_data;
+    }
+
+
+    Shared_owner<Colossus::Protobuf::Health> health(const Network::Colossus_protocol::Health& health)
+    {
+        auto protobuf_health = allocate_shared<Colossus::Protobuf::Health>();
+        protobuf_health->ParseFromString(health.to_string());
+        return protobuf_health;
+    }
+
+} // namespace Navtech::Colossus_decoding
@@ -0,0 +1,44 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef COLOSSUS_DECODING_H
+#define COLOSSUS_DECODING_H
+
+#include <cstdint>
+
+#include "colossus_messages.h"
+#include "radar_client.h"
+
+// --------------------------------------------------------------------------------------------------
+// Decoding of Colossus messages into the structures given to client
+// callbacks. Radar_client and Shared_memory_reader both decode through
+// these, so the two paths give the same results.
+//
+namespace Navtech::Colossus_decoding {
+
+    Configuration_data::ProtobufPointer protobuf_configuration(const Network::Colossus_protocol::Configuration& config);
+
+    // range_table is built from the configuration unless one is given
+    //
+    Configuration_data::Pointer configuration_data(const Network::Colossus_protocol::Configuration& config,
+                                                   const Colossus::Protobuf::ConfigurationData& protobuf,
+                                                   const Range_table::Pointer& range_table = nullptr);
+
+    // The header fields only; the caller copies in the bins it wants
+    //
+    Fft_data::Pointer fft_data(const Network::Colossus_protocol::Fft_data& fft, std::uint16_t encoder_size);
+
+    // Without peaks, for an azimuth that is blanked but still delivered
+    //
+    Navigation_data::Pointer navigation_data(const Network::Colossus_protocol::Navigation_data& navigation,
+                                             std::uint16_t encoder_size,
+                                             bool with_peaks = true);
+
+    Shared_owner<Colossus::Protobuf::Health> health(const Network::Colossus_protocol::Health& health);
+
+} // namespace Navtech::Colossus_decoding
+
+#endif // COLOSSUS_DECODING_H
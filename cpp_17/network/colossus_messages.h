@@ -104,6 +104,11 @@ namespace Navtech::Network::Colossus_protocol {
             return to_vector();
         }
 
+        // Direct access to the FFT data, without copying
+        //
+        const std::uint8_t* fft_begin() const { return protobuf_begin(); }
+        const std::uint8_t* fft_end() const { return protobuf_end(); }
+
         // If your message has a header you MUST provide this function
         //
         std::size_t size() const { return (3 * sizeof(std::uint16_t) + 2 * sizeof(std::uint32_t)); }
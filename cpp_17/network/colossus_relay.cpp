@@ -0,0 +1,597 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <algorithm>
+#include <string>
+
+#include <poll.h>
+#include <sys/socket.h>
+
+#include "../common.h"
+#include "colossus_relay.h"
+
+namespace Navtech {
+
+    using Network::Colossus_protocol::Message;
+
+    constexpr int poll_timeout_ms { 100 };
+    constexpr std::size_t client_read_size { 4096 };
+
+
+    // ---------------------------------------------------------------------------------------------------------
+    // Colossus_relay::Client
+    //
+    Colossus_relay::Client::Client(Owner_of<Tcp_socket>&& client_socket,
+                                   std::uint32_t client_id,
+                                   std::size_t max_queue) :
+        socket          { std::move(client_socket) },
+        identity        { client_id },
+        max_queue_size  { max_queue }
+    {
+    }
+
+
+    Colossus_relay::Client::~Client()
+    {
+        stop();
+    }
+
+
+    void Colossus_relay::Client::enqueue(const Buffer& buffer, bool droppable)
+    {
+        if (!active) return;
+
+        std::lock_guard lock { queue_mutex };
+
+        if (queue.size() >= max_queue_size) {
+            // Drop the oldest stream data to make room. Configuration and
+            // command responses are never dropped.
+            //
+            auto oldest = std::find_if(queue.begin(), queue.end(), [](const Queued_buffer& q) { return q.droppable; });
+            if (oldest != queue.end()) {
+                queue.erase(oldest);
+                dropped_count++;
+            }
+            else if (droppable) {
+                dropped_count++;
+                return;
+            }
+            else {
+                // Nothing can be dropped, so the client has stopped reading.
+                // Shutting the socket down also releases a blocked send.
+                //
+                Log("Colossus_relay - Send queue full for client [" + std::to_string(identity) + "]");
+                active = false;
+                ::shutdown(socket->native_handle(), SHUT_RDWR);
+                return;
+            }
+        }
+
+        queue.push_back(Queued_buffer { buffer, droppable });
+        queue_condition.notify_one();
+    }
+
+
+    bool Colossus_relay::Client::receive(
+        const std::function<void(Client&, std::vector<std::uint8_t>&&)>& on_message)
+    {
+        if (!active) return false;
+
+        if (received.size() - received_used < client_read_size) received.resize(received_used + client_read_size);
+
+        auto bytes_read = socket->receive_some(received.data() + received_used, client_read_size);
+        if (bytes_read < 0) {
+            active = false;
+            return false;
+        }
+
+        received_used += bytes_read;
+        if (!frame_messages(on_message)) {
+            active = false;
+            return false;
+        }
+        return true;
+    }
+
+
+    // Passes on each complete message received, and keeps any partial
+    // message for the next read
+    //
+    bool Colossus_relay::Client::frame_messages(
+        const std::function<void(Client&, std::vector<std::uint8_t>&&)>& on_message)
+    {
+        std::size_t offset = 0;
+
+        while (received_used - offset >= Message::header_size()) {
+            auto begin = received.data() + offset;
+
+            Message header { begin, Message::header_size() };
+            if (!header.is_valid()) {
+                Log("Colossus_relay - Invalid message from client [" + std::to_string(identity) + "]");
+                return false;
+            }
+
+            if (header.payload_size() > max_relay_client_payload) {
+                Log("Colossus_relay - Message of [" + std::to_string(header.payload_size()) +
+                    "] bytes from client [" + std::to_string(identity) + "] exceeds the limit");
+                return false;
+            }
+
+            auto message_size = Message::header_size() + header.payload_size();
+            if (received_used - offset < message_size) break;
+
+            on_message(*this, std::vector<std::uint8_t> { begin, begin + message_size });
+            offset += message_size;
+        }
+
+        std::copy(received.begin() + offset, received.begin() + received_used, received.begin());
+        received_used -= offset;
+        return true;
+    }
+
+
+    void Colossus_relay::Client::do_work()
+    {
+        std::unique_lock lock { queue_mutex };
+        queue_condition.wait(lock, [this] { return !queue.empty() || stop_requested; });
+        if (stop_requested) return;
+
+        auto buffer = std::move(queue.front().buffer);
+        queue.pop_front();
+        lock.unlock();
+
+        // After a failed send the queue is drained until the relay
+        // removes the client
+        //
+        if (!active) return;
+
+        if (socket->send(*buffer) != 0) {
+            Log("Colossus_relay - Send failed to client [" + std::to_string(identity) + "]");
+            active = false;
+        }
+    }
+
+
+    void Colossus_relay::Client::pre_stop(const bool)
+    {
+        std::lock_guard lock { queue_mutex };
+        queue_condition.notify_all();
+    }
+
+
+    // ---------------------------------------------------------------------------------------------------------
+    // Colossus_relay
+    //
+    Colossus_relay::Colossus_relay(const Utility::IP_address& radar_address,
+                                   std::uint16_t radar_port,
+                                   std::uint16_t port,
+                                   std::size_t queue_size) :
+        upstream        { radar_address, radar_port },
+        listener        { Utility::IP_address {}, port },
+        listen_port     { port },
+        max_queue_size  { queue_size }
+    {
+    }
+
+
+    Colossus_relay::~Colossus_relay()
+    {
+        close();
+    }
+
+
+    bool Colossus_relay::open()
+    {
+        if (listener.is_valid()) return true;
+
+        if (!listener.create() || !listener.listen()) {
+            Log("Colossus_relay - Failed to listen on port [" + std::to_string(listen_port) + "]");
+            listener.close();
+            return false;
+        }
+
+        upstream.set_receive_data_callback(std::bind(&Colossus_relay::upstream_handler, this, std::placeholders::_1));
+        upstream.start();
+
+        Log("Colossus_relay - Listening on port [" + std::to_string(listen_port) + "]");
+        return true;
+    }
+
+
+    void Colossus_relay::close()
+    {
+        stop();
+        if (!listener.is_valid()) return;
+
+        listener.close();
+        upstream.stop();
+        upstream.set_receive_data_callback();
+
+        // Clients are stopped outside the lock, as a client's send thread
+        // may be waiting on a full socket
+        //
+        std::list<Owner_of<Client>> stopping {};
+        {
+            std::lock_guard lock { clients_mutex };
+            stopping.swap(clients);
+            controller_id = 0;
+            navigation_config_requests.clear();
+            logging_levels_requests.clear();
+            upstream_pending.clear();
+        }
+        stopping.clear();
+
+        Log("Colossus_relay - Stopped");
+    }
+
+
+    Colossus_relay::Statistics Colossus_relay::statistics()
+    {
+        Statistics stats {};
+        stats.messages_received = messages_received;
+        stats.commands_rejected = commands_rejected;
+
+        std::lock_guard lock { clients_mutex };
+        stats.clients = clients.size();
+        for (auto& client : clients) {
+            stats.messages_dropped += client->dropped();
+        }
+
+        return stats;
+    }
+
+
+    // Waits for a new client or for requests from the connected clients.
+    // Only this thread adds or removes clients, so it reads the list
+    // without the lock.
+    //
+    void Colossus_relay::do_work()
+    {
+        std::vector<pollfd> fds {};
+        fds.reserve(clients.size() + 1);
+        fds.push_back(pollfd { listener.native_handle(), POLLIN, 0 });
+        for (auto& client : clients) {
+            fds.push_back(pollfd { client->native_handle(), POLLIN, 0 });
+        }
+
+        if (::poll(fds.data(), fds.size(), poll_timeout_ms) > 0) {
+            auto on_message = [this](Client& client, std::vector<std::uint8_t>&& data) {
+                downstream_handler(client, std::move(data));
+            };
+
+            auto fd = fds.begin() + 1;
+            for (auto& client : clients) {
+                if ((fd++)->revents != 0) client->receive(on_message);
+            }
+
+            if (fds.front().revents & POLLIN) accept_client();
+        }
+
+        remove_inactive_clients();
+        flush_upstream();
+    }
+
+
+    void Colossus_relay::accept_client()
+    {
+        auto client_socket = listener.accept();
+        if (client_socket == nullptr) return;
+
+        client_socket->set_no_delay();
+        client_socket->set_send_timeout(send_timeout);
+        auto address = client_socket->address().to_string();
+
+        auto client = allocate_owned<Client>(std::move(client_socket), next_client_id++, max_queue_size);
+        client->start();
+
+        std::lock_guard lock { clients_mutex };
+        if (controller_id == 0) controller_id = client->id();
+
+        // The radar sends its configuration to every new connection;
+        // the relay must behave the same way.
+        //
+        if (configuration != nullptr) client->enqueue(configuration, false);
+
+        Log("Colossus_relay - Client [" + std::to_string(client->id()) + "] connected from [" + address + "]");
+        clients.push_back(std::move(client));
+    }
+
+
+    void Colossus_relay::remove_inactive_clients()
+    {
+        std::list<Owner_of<Client>> disconnected {};
+        {
+            std::lock_guard lock { clients_mutex };
+
+            for (auto it = clients.begin(); it != clients.end();) {
+                auto current = it++;
+                if ((*current)->is_active()) continue;
+
+                for (auto stream : { fft, navigation, health }) {
+                    unsubscribe(**current, stream);
+                }
+
+                Log("Colossus_relay - Client [" + std::to_string((*current)->id()) + "] disconnected");
+                disconnected.splice(disconnected.end(), clients, current);
+            }
+
+            auto controller = std::find_if(
+                clients.begin(), clients.end(), [this](const Owner_of<Client>& c) { return c->id() == controller_id; });
+            if (controller == clients.end()) controller_id = clients.empty() ? 0 : clients.front()->id();
+        }
+
+        // Joining a client's send thread must happen outside the lock, as
+        // it may be waiting on a full socket.
+        //
+        disconnected.clear();
+    }
+
+
+    void Colossus_relay::upstream_handler(std::vector<std::uint8_t>&& data)
+    {
+        Message msg { std::move(data) };
+        auto type   = msg.type();
+        auto buffer = Buffer { allocate_shared<const std::vector<std::uint8_t>>(msg.relinquish()) };
+        messages_received++;
+
+        {
+            std::lock_guard lock { clients_mutex };
+
+            if (type == Message_type::configuration) {
+                configuration = buffer;
+
+                // A configuration message means the radar (re)connected;
+                // restart any streams that downstream clients are still
+                // subscribed to. Requests sent before the reconnection will
+                // not be answered.
+                //
+                for (auto stream : { fft, navigation, health }) {
+                    if (is_stream_active(stream)) send_upstream(start_message_for(stream, contoured_fft));
+                }
+                navigation_config_requests.clear();
+                logging_levels_requests.clear();
+            }
+
+            if (auto requests = requests_for(type); requests != nullptr) {
+                reply_to_requester(*requests, buffer);
+            }
+            else {
+                auto stream = stream_for(type);
+                for (auto& client : clients) {
+                    if (stream == stream_count) client->enqueue(buffer, false);
+                    else if (client->subscribed[stream]) client->enqueue(buffer, true);
+                }
+            }
+        }
+
+        flush_upstream();
+    }
+
+
+    void Colossus_relay::downstream_handler(Client& client, std::vector<std::uint8_t>&& data)
+    {
+        Message msg { std::move(data) };
+
+        switch (msg.type()) {
+            case Message_type::keep_alive:
+                break;
+
+            case Message_type::configuration_request: {
+                std::lock_guard lock { clients_mutex };
+                if (configuration != nullptr) client.enqueue(configuration, false);
+                else send_upstream(Message_type::configuration_request);
+                break;
+            }
+
+            case Message_type::start_fft_data:
+            case Message_type::start_non_contour_fft_data:
+                subscribe(client, fft, msg.type());
+                break;
+
+            case Message_type::start_nav_data:
+                subscribe(client, navigation, msg.type());
+                break;
+
+            case Message_type::start_health_msgs:
+                subscribe(client, health, msg.type());
+                break;
+
+            case Message_type::stop_fft_data:
+            case Message_type::stop_nav_data:
+            case Message_type::stop_health_msgs: {
+                std::lock_guard lock { clients_mutex };
+                unsubscribe(client, stream_for(msg.type()));
+                break;
+            }
+
+            // Requests that do not change the radar are accepted from any
+            // client; the reply is sent only to the client that asked
+            //
+            case Message_type::navigation_config_request:
+            case Message_type::logging_levels_request: {
+                std::lock_guard lock { clients_mutex };
+                if (upstream.get_connection_state() != Connection_state::connected) break;
+
+                requests_for(msg.type())->push_back(client.id());
+                upstream_pending.push_back(msg.relinquish());
+                break;
+            }
+
+            // Commands are queued with the other upstream messages, so that
+            // the radar receives them in the order they arrived
+            //
+            default: {
+                std::unique_lock lock { clients_mutex };
+                auto is_controller = (client.id() == controller_id);
+                if (is_controller) upstream_pending.push_back(msg.relinquish());
+                lock.unlock();
+
+                if (!is_controller) {
+                    commands_rejected++;
+                    Log("Colossus_relay - Rejected command [" + std::to_string(static_cast<std::uint32_t>(msg.type())) +
+                        "] from client [" + std::to_string(client.id()) + "]");
+                }
+                break;
+            }
+        }
+    }
+
+
+    void Colossus_relay::subscribe(Client& client, Stream stream, Message_type start_type)
+    {
+        std::lock_guard lock { clients_mutex };
+
+        auto was_active           = is_stream_active(stream);
+        client.subscribed[stream] = true;
+
+        if (!was_active) {
+            if (stream == fft) contoured_fft = (start_type == Message_type::start_fft_data);
+            send_upstream(start_type);
+        }
+        else if (stream == fft && contoured_fft != (start_type == Message_type::start_fft_data)) {
+            Log("Colossus_relay - FFT contour mode already set by another client");
+        }
+    }
+
+
+    void Colossus_relay::unsubscribe(Client& client, Stream stream)
+    {
+        if (stream == stream_count || !client.subscribed[stream]) return;
+
+        client.subscribed[stream] = false;
+        if (!is_stream_active(stream)) send_upstream(stop_message_for(stream));
+    }
+
+
+    bool Colossus_relay::is_stream_active(Stream stream) const
+    {
+        return std::any_of(
+            clients.begin(), clients.end(), [stream](const Owner_of<Client>& c) { return c->subscribed[stream]; });
+    }
+
+
+    // Called under the lock; the message is sent by flush_upstream(), so
+    // that a slow radar link does not hold up the clients
+    //
+    void Colossus_relay::send_upstream(Message_type type)
+    {
+        if (upstream.get_connection_state() != Connection_state::connected) return;
+
+        Message msg {};
+        msg.type(type);
+        upstream_pending.push_back(msg.relinquish());
+    }
+
+
+    // Sends the messages queued by send_upstream() in order. The send lock
+    // keeps the order when both the relay's thread and the radar's data
+    // thread flush.
+    //
+    void Colossus_relay::flush_upstream()
+    {
+        std::lock_guard send_lock { upstream_send_mutex };
+
+        std::vector<std::vector<std::uint8_t>> sending {};
+        {
+            std::lock_guard lock { clients_mutex };
+            sending.swap(upstream_pending);
+        }
+
+        for (auto& message : sending) {
+            upstream.send(std::move(message));
+        }
+    }
+
+
+    // Called under the lock. The radar answers requests in order, so
+    // each reply goes to the oldest client still waiting for one.
+    //
+    void Colossus_relay::reply_to_requester(std::deque<std::uint32_t>& requests, const Buffer& buffer)
+    {
+        if (requests.empty()) return;
+
+        auto requester = requests.front();
+        requests.pop_front();
+
+        auto client = std::find_if(
+            clients.begin(), clients.end(), [requester](const Owner_of<Client>& c) { return c->id() == requester; });
+        if (client != clients.end()) (*client)->enqueue(buffer, false);
+    }
+
+
+    // The clients waiting on a request, given either the request or its
+    // reply; nullptr for other messages
+    //
+    std::deque<std::uint32_t>* Colossus_relay::requests_for(Message_type type)
+    {
+        switch (type) {
+            case Message_type::navigation_config_request:
+            case Message_type::navigation_configuration:
+                return &navigation_config_requests;
+
+            case Message_type::logging_levels_request:
+            case Message_type::logging_levels:
+                return &logging_levels_requests;
+
+            default:
+                return nullptr;
+        }
+    }
+
+
+    Colossus_relay::Stream Colossus_relay::stream_for(Message_type type)
+    {
+        switch (type) {
+            case Message_type::fft_data:
+            case Message_type::high_precision_fft_data:
+            case Message_type::start_fft_data:
+            case Message_type::start_non_contour_fft_data:
+            case Message_type::stop_fft_data:
+                return fft;
+
+            case Message_type::navigation_data:
+            case Message_type::navigation_alarm_data:
+            case Message_type::start_nav_data:
+            case Message_type::stop_nav_data:
+                return navigation;
+
+            case Message_type::health:
+            case Message_type::start_health_msgs:
+            case Message_type::stop_health_msgs:
+                return health;
+
+            default:
+                return stream_count;
+        }
+    }
+
+
+    Colossus_relay::Message_type Colossus_relay::start_message_for(Stream stream, bool contoured)
+    {
+        switch (stream) {
+            case fft:
+                return contoured ? Message_type::start_fft_data : Message_type::start_non_contour_fft_data;
+            case navigation:
+                return Message_type::start_nav_data;
+            default:
+                return Message_type::start_health_msgs;
+        }
+    }
+
+
+    Colossus_relay::Message_type Colossus_relay::stop_message_for(Stream stream)
+    {
+        switch (stream) {
+            case fft:
+                return Message_type::stop_fft_data;
+            case navigation:
+                return Message_type::stop_nav_data;
+            default:
+                return Message_type::stop_health_msgs;
+        }
+    }
+
+} // namespace Navtech
@@ -0,0 +1,181 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef COLOSSUS_RELAY_H
+#define COLOSSUS_RELAY_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <vector>
+
+#include "../utility/ip_address.h"
+#include "../utility/pointer_types.h"
+#include "../utility/threaded_class.h"
+#include "colossus_network_message.h"
+#include "tcp_radar_client.h"
+#include "tcp_socket.h"
+
+namespace Navtech {
+
+    // The largest message accepted from a downstream client. Clients only
+    // send commands, the largest of which are a few kilobytes; a client
+    // that announces a larger payload is disconnected.
+    //
+    constexpr std::uint32_t max_relay_client_payload { 65536 };
+
+
+    // --------------------------------------------------------------------------------------------------
+    // The Colossus_relay holds a single upstream connection to a radar and
+    // re-serves the Colossus protocol, unchanged, to any number of downstream
+    // clients.
+    //
+    // - Upstream message buffers are shared between all downstream clients;
+    //   they are never copied or re-encoded.
+    // - Streams (FFT, navigation, health) are reference-counted; the upstream
+    //   stream is started by the first subscriber and stopped by the last.
+    // - Replies to requests (navigation configuration, logging levels) go
+    //   only to the clients that asked, in the order they asked.
+    // - Commands that change radar state (contours, blanking, navigation settings,
+    //   etc.) are only accepted from the controlling client - the longest
+    //   connected client.
+    // - Each client has its own bounded send queue and send thread. A slow
+    //   client loses its oldest stream data; it cannot stall the radar
+    //   connection or other clients.
+    //
+    // open() listens for clients and connects to the radar; start() runs
+    // the relay's thread, which accepts clients and reads their requests.
+    //
+    class Colossus_relay : public Threaded_class {
+    public:
+        struct Statistics
+        {
+            std::size_t clients { 0 };
+            std::uint64_t messages_received { 0 };
+            std::uint64_t messages_dropped { 0 };
+            std::uint64_t commands_rejected { 0 };
+        };
+
+        explicit Colossus_relay(const Utility::IP_address& radar_address,
+                                std::uint16_t radar_port   = 6317,
+                                std::uint16_t listen_port  = 6317,
+                                std::size_t max_queue_size = 800);
+        ~Colossus_relay();
+
+        bool open();
+        void close();
+
+        Statistics statistics();
+
+    protected:
+        void do_work() override;
+
+    private:
+        using Buffer       = Shared_owner<const std::vector<std::uint8_t>>;
+        using Message_type = Network::Colossus_protocol::Message::Type;
+
+        enum Stream { fft, navigation, health, stream_count };
+
+        // Sends to one downstream client on its own thread. The relay's
+        // thread reads from the client, framing its messages in place.
+        //
+        class Client : public Threaded_class {
+        public:
+            Client(Owner_of<Tcp_socket>&& client_socket, std::uint32_t client_id, std::size_t max_queue_size);
+            ~Client();
+
+            void enqueue(const Buffer& buffer, bool droppable);
+
+            // Reads what the client has sent and passes on each complete
+            // message. Returns false, and the client becomes inactive, if
+            // the connection has failed or the client breaks the protocol.
+            //
+            bool receive(const std::function<void(Client&, std::vector<std::uint8_t>&&)>& on_message);
+
+            bool is_active() const { return active; }
+            std::int32_t native_handle() const { return socket->native_handle(); }
+            std::uint32_t id() const { return identity; }
+            std::uint64_t dropped() const { return dropped_count; }
+            bool subscribed[stream_count] {};
+
+        protected:
+            void do_work() override;
+            void pre_stop(const bool finish_work) override;
+
+        private:
+            struct Queued_buffer
+            {
+                Buffer buffer;
+                bool droppable;
+            };
+
+            Owner_of<Tcp_socket> socket {};
+            std::uint32_t identity { 0 };
+            std::size_t max_queue_size { 0 };
+            std::atomic_bool active { true };
+            std::atomic<std::uint64_t> dropped_count { 0 };
+
+            std::deque<Queued_buffer> queue {};
+            std::mutex queue_mutex {};
+            std::condition_variable queue_condition {};
+
+            std::vector<std::uint8_t> received {};
+            std::size_t received_used { 0 };
+
+            bool frame_messages(const std::function<void(Client&, std::vector<std::uint8_t>&&)>& on_message);
+        };
+
+        Tcp_radar_client upstream;
+        Tcp_socket listener;
+        std::uint16_t listen_port { 6317 };
+        std::size_t max_queue_size { 800 };
+
+        std::mutex clients_mutex {};
+        std::list<Owner_of<Client>> clients {};
+        std::uint32_t next_client_id { 1 };
+        std::uint32_t controller_id { 0 };
+        bool contoured_fft { true };
+        Buffer configuration {};
+
+        // The clients waiting for each kind of reply, oldest first
+        //
+        std::deque<std::uint32_t> navigation_config_requests {};
+        std::deque<std::uint32_t> logging_levels_requests {};
+
+        // Messages for the radar, queued under the clients lock and sent
+        // after it is released
+        //
+        std::vector<std::vector<std::uint8_t>> upstream_pending {};
+        std::mutex upstream_send_mutex {};
+
+        std::atomic<std::uint64_t> messages_received { 0 };
+        std::atomic<std::uint64_t> commands_rejected { 0 };
+
+        void accept_client();
+        void upstream_handler(std::vector<std::uint8_t>&& data);
+        void downstream_handler(Client& client, std::vector<std::uint8_t>&& data);
+
+        void subscribe(Client& client, Stream stream, Message_type start_type);
+        void unsubscribe(Client& client, Stream stream);
+        bool is_stream_active(Stream stream) const;
+        void remove_inactive_clients();
+        void send_upstream(Message_type type);
+        void flush_upstream();
+        void reply_to_requester(std::deque<std::uint32_t>& requests, const Buffer& buffer);
+        std::deque<std::uint32_t>* requests_for(Message_type type);
+
+        static Stream stream_for(Message_type type);
+        static Message_type start_message_for(Stream stream, bool contoured);
+        static Message_type stop_message_for(Stream stream);
+    };
+
+} // namespace Navtech
+
+#endif // COLOSSUS_RELAY_H
@@ -0,0 +1,129 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <algorithm>
+#include <array>
+#include <map>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "../common.h"
+#include "discovery_client.h"
+
+namespace Navtech {
+
+    using Network::Colossus_protocol::Message;
+
+    constexpr std::size_t max_discovery_reply { 65536 };
+
+
+    Discovery_client::Discovery_client(const Utility::IP_address& dest, std::uint16_t dest_port, Message_type probe) :
+        destination { dest },
+        port        { dest_port },
+        probe_type  { probe }
+    {
+    }
+
+
+    std::vector<Discovered_radar> Discovery_client::discover(std::chrono::milliseconds timeout)
+    {
+        using namespace std::chrono;
+
+        std::vector<Discovered_radar> radars {};
+
+        auto sock = ::socket(AF_INET, SOCK_DGRAM, 0);
+        if (sock == -1) {
+            Log("Discovery_client - Failed to create socket");
+            return radars;
+        }
+
+        auto on = 1;
+        setsockopt(sock, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+
+        sockaddr_in addr {};
+        addr.sin_family      = AF_INET;
+        addr.sin_port        = htons(port);
+        addr.sin_addr.s_addr = destination.to_network_endian();
+
+        Message probe {};
+        probe.type(probe_type);
+        auto probe_data = probe.relinquish();
+
+        if (::sendto(sock, probe_data.data(), probe_data.size(), 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) ==
+            -1) {
+            Log("Discovery_client - Failed to send probe to [" + destination.to_string() + "]");
+            ::close(sock);
+            return radars;
+        }
+
+        // Replies are keyed on source address; a radar that replies more
+        // than once (e.g. on several interfaces) is only reported once.
+        //
+        std::map<std::uint32_t, Discovered_radar> replies {};
+        std::vector<std::uint8_t> buffer(max_discovery_reply);
+        auto deadline = steady_clock::now() + timeout;
+
+        while (true) {
+            auto remaining = duration_cast<milliseconds>(deadline - steady_clock::now()).count();
+            if (remaining <= 0) break;
+
+            pollfd pfd { sock, POLLIN, 0 };
+            if (::poll(&pfd, 1, static_cast<int>(remaining)) <= 0) continue;
+
+            sockaddr_in from {};
+            socklen_t from_size = sizeof(from);
+            auto received       = ::recvfrom(
+                sock, buffer.data(), buffer.size(), 0, reinterpret_cast<sockaddr*>(&from), &from_size);
+            if (received <= 0) continue;
+
+            Discovered_radar radar {};
+            if (!parse_reply(buffer.data(), received, radar)) continue;
+
+            radar.address = Utility::IP_address { from.sin_addr.s_addr, Utility::Endian::network };
+            replies[radar.address.to_host_endian()] = std::move(radar);
+        }
+
+        ::close(sock);
+
+        for (auto& [address, radar] : replies) {
+            radars.push_back(std::move(radar));
+        }
+
+        Log("Discovery_client - Found [" + std::to_string(radars.size()) + "] radars");
+        return radars;
+    }
+
+
+    bool Discovery_client::parse_reply(const std::uint8_t* data, std::size_t size, Discovered_radar& radar)
+    {
+        if (size < Message::header_size()) return false;
+
+        Message msg { data, size };
+        if (!msg.is_valid() || msg.payload_size() != size - Message::header_size()) return false;
+
+        auto discovery = allocate_shared<Colossus::Protobuf::Discovery>();
+        if (!discovery->ParseFromArray(data + Message::header_size(), static_cast<int>(msg.payload_size()))) {
+            return false;
+        }
+
+        radar.model               = discovery->model().name();
+        radar.maximum_range       = discovery->model().rangeinmetres();
+        radar.range_resolution    = discovery->rangeresolutionmetres();
+        radar.max_clients         = discovery->maxclientsallowed();
+        radar.connected_clients   = discovery->ipclients_size();
+        radar.free_client_slots   = std::max(0, radar.max_clients - radar.connected_clients);
+        radar.staring_mode        = discovery->staringmode() != 0;
+        radar.transmitter_enabled = discovery->transmitterenabled() != 0;
+        radar.protobuf_discovery  = discovery;
+
+        return true;
+    }
+
+} // namespace Navtech
@@ -0,0 +1,76 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef DISCOVERY_CLIENT_H
+#define DISCOVERY_CLIENT_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <discovery.pb.h>
+
+#include "../utility/ip_address.h"
+#include "../utility/pointer_types.h"
+#include "colossus_network_message.h"
+
+namespace Navtech {
+
+    constexpr std::uint16_t discovery_port { 6317 };
+    constexpr std::chrono::milliseconds discovery_timeout { std::chrono::milliseconds(1000) };
+
+    struct Discovered_radar
+    {
+        using ProtobufPointer = Shared_owner<Colossus::Protobuf::Discovery>;
+
+        Utility::IP_address address {};
+        std::string model {};
+        float range_resolution { 0.0f };
+        float maximum_range { 0.0f };
+        std::int32_t max_clients { 0 };
+        std::int32_t connected_clients { 0 };
+        std::int32_t free_client_slots { 0 };
+        bool staring_mode { false };
+        bool transmitter_enabled { false };
+        ProtobufPointer protobuf_discovery {};
+    };
+
+
+    // --------------------------------------------------------------------------------------------------
+    // The Discovery_client sends a single UDP probe (broadcast, multicast or
+    // unicast, depending on the destination address) and collects Discovery
+    // replies from every radar that answers before the deadline.  Replies
+    // are gathered concurrently on one socket, so the time taken does not
+    // grow with the number of radars.
+    //
+    class Discovery_client {
+    public:
+        using Message_type = Network::Colossus_protocol::Message::Type;
+
+        explicit Discovery_client(const Utility::IP_address& destination = Utility::IP_address { "255.255.255.255" },
+                                  std::uint16_t port                     = discovery_port,
+                                  Message_type probe                     = Message_type::configuration_request);
+
+        Discovery_client(const Discovery_client&) = delete;
+        Discovery_client& operator=(const Discovery_client&) = delete;
+
+        std::vector<Discovered_radar> discover(std::chrono::milliseconds timeout = discovery_timeout);
+
+        // Decode one reply datagram; returns false unless data is exactly
+        // one framed Discovery message. The address is left to the caller.
+        //
+        static bool parse_reply(const std::uint8_t* data, std::size_t size, Discovered_radar& radar);
+
+    private:
+        Utility::IP_address destination {};
+        std::uint16_t port { discovery_port };
+        Message_type probe_type { Message_type::configuration_request };
+    };
+
+} // namespace Navtech
+
+#endif // DISCOVERY_CLIENT_H
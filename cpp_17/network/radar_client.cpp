@@ -4,6 +4,7 @@
 // for full license details.
 //
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
 #include <iomanip>
@@ -16,6 +17,7 @@
 #endif
 
 #include "../common.h"
+#include "colossus_decoding.h"
 #include "colossus_messages.h"
 #include "colossus_network_message.h"
 #include "radar_client.h"
@@ -23,10 +25,32 @@
 
 
 namespace Navtech {
-    Radar_client::Radar_client(const Utility::IP_address& radarAddress, const std::uint16_t& port) :
-        radar_client    { radarAddress, port }, 
+    using Message_type = Network::Colossus_protocol::Message::Type;
+
+    constexpr std::chrono::milliseconds failover_check_period { 20 };
+    constexpr std::chrono::milliseconds default_failover_silence { 250 };
+
+
+    Radar_client::Radar_client(const Utility::IP_address& radarAddress,
+                               const std::uint16_t& port,
+                               Threading_mode mode) :
+        radar_client    { radarAddress, port, mode }, 
+        active_client   { &radar_client },
         running         { false }, 
-        send_radar_data { false }
+        send_radar_data { false },
+        failover_timer  { failover_check_period }
+    { }
+
+
+    Radar_client::Radar_client(const Utility::IP_address& primaryAddress,
+                               const Utility::IP_address& standbyAddress,
+                               const std::uint16_t& port) :
+        radar_client    { primaryAddress, port },
+        standby_client  { allocate_owned<Tcp_radar_client>(standbyAddress, port) },
+        active_client   { &radar_client },
+        running         { false },
+        send_radar_data { false },
+        failover_timer  { failover_check_period }
     { }
 
     void Radar_client::set_fft_data_callback(std::function<void(const Fft_data::Pointer&)> fn)
@@ -74,13 +98,169 @@ namespace Navtech {
     }
 
 
+    void Radar_client::set_failover_callback(std::function<void(const Failover_report::Pointer&)> fn)
+    {
+        std::lock_guard lock { callback_mutex };
+        failover_callback = std::move(fn);
+    }
+
+
+    void Radar_client::set_rotation_callback(std::function<void(const Rotation_frame_handle&)> fn)
+    {
+        rotation_assembler.set_rotation_callback(std::move(fn));
+    }
+
+
+    void Radar_client::set_rotation_history_depth(std::size_t rotations)
+    {
+        rotation_assembler.set_history_depth(rotations);
+    }
+
+
+    const Rotation_history& Radar_client::rotation_history() const
+    {
+        return rotation_assembler.history();
+    }
+
+
+    void Radar_client::set_rotation_pool_size(std::size_t frame_count, Page_size page_size)
+    {
+        rotation_assembler.set_pool_size(frame_count, page_size);
+    }
+
+
+    Rotation_subscriber_id Radar_client::add_rotation_subscriber(const Reduction_profile& profile,
+                                                                 std::function<void(const Rotation_frame_handle&)> fn)
+    {
+        return rotation_assembler.add_subscriber(profile, std::move(fn));
+    }
+
+
+    void Radar_client::remove_rotation_subscriber(Rotation_subscriber_id id)
+    {
+        rotation_assembler.remove_subscriber(id);
+    }
+
+
+    void Radar_client::set_rotation_resampling(bool enable, std::uint16_t max_gap)
+    {
+        rotation_assembler.set_resampling(enable, max_gap);
+    }
+
+
+    void Radar_client::set_sector_callback(std::function<void(const Rotation_sector&)> fn,
+                                           std::uint16_t azimuths_per_sector)
+    {
+        rotation_assembler.set_sector_callback(std::move(fn), azimuths_per_sector);
+    }
+
+
+    void Radar_client::set_sector_callback_degrees(std::function<void(const Rotation_sector&)> fn,
+                                                   float degrees_per_sector)
+    {
+        rotation_assembler.set_sector_callback_degrees(std::move(fn), degrees_per_sector);
+    }
+
+
+    void Radar_client::set_staring_callback(std::function<void(const Rotation_frame_handle&)> fn)
+    {
+        staring_integrator.set_callback(std::move(fn));
+    }
+
+
+    void Radar_client::set_staring_profile(const Staring_profile& profile)
+    {
+        staring_integrator.set_profile(profile);
+    }
+
+
+    void Radar_client::set_region_of_interest(const Region_of_interest& roi)
+    {
+        requested_region = roi;
+    }
+
+
+    Region_of_interest Radar_client::region_of_interest() const
+    {
+        return requested_region;
+    }
+
+
+    Continuity_counters Radar_client::fft_continuity() const
+    {
+        return fft_tracker.counters();
+    }
+
+
+    Continuity_counters Radar_client::navigation_continuity() const
+    {
+        return navigation_tracker.counters();
+    }
+
+
+    bool Radar_client::rotation_timestamps(const Rotation_frame& frame, std::vector<Radar_time>& out) const
+    {
+        return fft_timestamps.normalise(frame, out, first_rotation_row);
+    }
+
+
+    void Radar_client::set_timestamp_step_tolerance(std::chrono::nanoseconds tolerance)
+    {
+        fft_timestamps.step_tolerance(tolerance);
+        navigation_timestamps.step_tolerance(tolerance);
+    }
+
+
+    Timestamp_counters Radar_client::fft_timestamp_counters() const
+    {
+        return fft_timestamps.counters();
+    }
+
+
+    Timestamp_counters Radar_client::navigation_timestamp_counters() const
+    {
+        return navigation_timestamps.counters();
+    }
+
+
+    Clock_offset_estimate Radar_client::clock_offset() const
+    {
+        return clock_offset_estimator.estimate();
+    }
+
+
+    void Radar_client::set_clock_offset_callback(std::function<void(const Clock_offset_estimate&)> fn)
+    {
+        std::lock_guard lock { callback_mutex };
+        clock_offset_callback = std::move(fn);
+    }
+
+
+    Range_table::Pointer Radar_client::range_table() const
+    {
+        return std::atomic_load(&ranges);
+    }
+
+
     void Radar_client::start()
     {
         if (running) return;
         Log("Radar_client - Starting");
 
-        radar_client.set_receive_data_callback(std::bind(&Radar_client::handle_data, this, std::placeholders::_1));
-        radar_client.start();
+        using std::placeholders::_1;
+
+        for (auto link : { &radar_client, standby_client.get() }) {
+            if (link == nullptr) continue;
+            link->set_receive_data_callback(std::bind(&Radar_client::handle_link_data, this, link, _1));
+            link->set_connection_state_callback(std::bind(&Radar_client::handle_link_state, this, link, _1));
+            link->start();
+        }
+
+        if (standby_client != nullptr) {
+            failover_timer.set_callback(std::bind(&Radar_client::failover_check_handler, this));
+            failover_timer.enable(true);
+        }
+
         running = true;
 
         Log("Radar_client - Started");
@@ -91,14 +271,47 @@ namespace Navtech {
         if (!running) return;
 
         running = false;
-        radar_client.stop();
+        failover_timer.enable(false);
+        failover_timer.set_callback();
+
+        for (auto link : { &radar_client, standby_client.get() }) {
+            if (link == nullptr) continue;
+            link->set_connection_state_callback();
+            link->stop();
+        }
         Log("Radar_client - Stopped");
     }
 
+    std::size_t Radar_client::poll(std::size_t budget)
+    {
+        auto handled = active_client.load()->poll(budget);
+
+        // A staring product is otherwise only delivered when an FFT arrives
+        //
+        if (staring_mode) staring_integrator.poll();
+        return handled;
+    }
+
+
+    std::int32_t Radar_client::native_handle() const
+    {
+        return active_client.load()->native_handle();
+    }
+
+
+    std::chrono::steady_clock::time_point Radar_client::next_deadline() const
+    {
+        auto deadline = active_client.load()->next_deadline();
+        if (staring_mode) deadline = std::min(deadline, staring_integrator.next_flush());
+        return deadline;
+    }
+
+
     void Radar_client::start_fft_data()
     {
         Log("Radar_client - Start FFT Data");
         send_simple_network_message(Network::Colossus_protocol::Message::Type::start_fft_data);
+        fft_start_type  = Message_type::start_fft_data;
         send_radar_data = true;
     }
 
@@ -106,6 +319,7 @@ namespace Navtech {
     {
         Log("Radar_client - Start Non Contoured FFT Data");
         send_simple_network_message(Network::Colossus_protocol::Message::Type::start_non_contour_fft_data);
+        fft_start_type  = Message_type::start_non_contour_fft_data;
         send_radar_data = true;
     }
 
@@ -120,29 +334,33 @@ namespace Navtech {
     {
         Log("Radar_client - Start Health Data");
         send_simple_network_message(Network::Colossus_protocol::Message::Type::start_health_msgs);
+        send_health_data = true;
     }
 
     void Radar_client::stop_health_data()
     {
         Log("Radar_client - Stop Health Data");
         send_simple_network_message(Network::Colossus_protocol::Message::Type::stop_health_msgs);
+        send_health_data = false;
     }
 
     void Radar_client::start_navigation_data()
     {
         Log("Radar_client - Start Navigation Data");
         send_simple_network_message(Network::Colossus_protocol::Message::Type::start_nav_data);
+        send_navigation_data = true;
     }
 
     void Radar_client::stop_navigation_data()
     {
         Log("Radar_client - Stop Navigation Data");
         send_simple_network_message(Network::Colossus_protocol::Message::Type::stop_nav_data);
+        send_navigation_data = false;
     }
 
     void Radar_client::set_navigation_threshold(std::uint16_t threshold)
     {
-        if (radar_client.get_connection_state() != Connection_state::connected) return;
+        if (active_client.load()->get_connection_state() != Connection_state::connected) return;
 
         std::vector<std::uint8_t> buffer(sizeof(threshold));
         auto network_threshold = ntohs(threshold);
@@ -151,12 +369,12 @@ namespace Navtech {
         Network::Colossus_protocol::Message msg {};
         msg.type(Network::Colossus_protocol::Message::Type::set_nav_threshold);
         msg.append(buffer);
-        radar_client.send(msg.relinquish());
+        active_client.load()->send(msg.relinquish());
     }
 
     void Radar_client::set_navigation_gain_and_offset(float gain, float offset)
     {
-        if (radar_client.get_connection_state() != Connection_state::connected) return;
+        if (active_client.load()->get_connection_state() != Connection_state::connected) return;
 
         std::vector<std::uint8_t> buffer(sizeof(std::uint32_t) * 2);
         std::uint32_t net_gain   = htonl(static_cast<std::uint32_t>(gain * range_multiplier));
@@ -167,7 +385,7 @@ namespace Navtech {
         Network::Colossus_protocol::Message msg {};
         msg.type(Network::Colossus_protocol::Message::Type::set_nav_range_offset_and_gain);
         msg.append(buffer);
-        radar_client.send(msg.relinquish());
+        active_client.load()->send(msg.relinquish());
     }
 
 
@@ -196,7 +414,7 @@ namespace Navtech {
         msg.type(Network::Colossus_protocol::Message::Type::set_navigation_configuration);
         msg.append(nav_config);
 
-        radar_client.send(msg.relinquish());
+        active_client.load()->send(msg.relinquish());
     }
 
 
@@ -208,22 +426,85 @@ namespace Navtech {
         msg.type(Network::Colossus_protocol::Message::Type::sector_blanking_update);
         msg.append(sector_list.to_vector());
 
-        radar_client.send(msg.relinquish());
+        active_client.load()->send(msg.relinquish());
+    }
+
+
+    void Radar_client::set_client_blanking(const Blanking_sector_list& sector_list, Blanking_action action)
+    {
+        std::lock_guard lock { blanking_mutex };
+        requested_blanking = sector_list;
+        blanking_action    = action;
+        blanking_changed   = true;
+    }
+
+
+    void Radar_client::clear_client_blanking()
+    {
+        set_client_blanking(Blanking_sector_list {});
+    }
+
+
+    void Radar_client::update_blanking_mask()
+    {
+        if (!blanking_changed && blanking_mask.encoder_size() == encoder_size) return;
+
+        std::lock_guard lock { blanking_mutex };
+        blanking_mask.compile(requested_blanking, encoder_size);
+        blanking_changed = false;
+    }
+
+
+    void Radar_client::set_client_contour(const std::vector<std::uint8_t>& contour_data)
+    {
+        std::lock_guard lock { contour_mutex };
+        requested_contour = contour_data;
+        contour_changed   = true;
+    }
+
+
+    void Radar_client::clear_client_contour()
+    {
+        set_client_contour(std::vector<std::uint8_t> {});
+    }
+
+
+    void Radar_client::update_contour_table()
+    {
+        if (!contour_changed && contour_table.azimuth_samples() == azimuth_samples && contour_bin_size == bin_size) {
+            return;
+        }
+
+        std::lock_guard lock { contour_mutex };
+        contour_changed  = false;
+        contour_bin_size = bin_size;
+        if (requested_contour.empty()) {
+            contour_table.clear();
+            return;
+        }
+        if (!contour_table.compile(requested_contour, bin_size, azimuth_samples)) {
+            Log("Radar_client - Client contour must be [" + std::to_string(Contour_table::contour_size) + "] bytes");
+        }
     }
 
 
     void Radar_client::send_simple_network_message(const Network::Colossus_protocol::Message::Type& type)
     {
-        if (radar_client.get_connection_state() != Connection_state::connected) return;
+        if (active_client.load()->get_connection_state() != Connection_state::connected) return;
+
+        // Give the radar time to respond before the standby link
+        // watchdog considers the active link silent.
+        //
+        if (standby_client != nullptr) last_data_time = std::chrono::steady_clock::now().time_since_epoch().count();
 
         Network::Colossus_protocol::Message msg {};
         msg.type(type);
-        radar_client.send(msg.relinquish());
+        active_client.load()->send(msg.relinquish());
     }
 
     void Radar_client::update_contour_map(const std::vector<std::uint8_t>& contour_data)
     {
-        if (radar_client.get_connection_state() != Connection_state::connected) return;
+        if (active_client.load()->get_connection_state() != Connection_state::connected) return;
 
         auto contour = std::vector<std::uint8_t>();
         if (contour_data.size() == 720) {
@@ -239,9 +520,181 @@ namespace Navtech {
         Network::Colossus_protocol::Message msg {};
         msg.type(Network::Colossus_protocol::Message::Type::contour_update);
         msg.append(contour);
-        radar_client.send(msg.relinquish());
+        active_client.load()->send(msg.relinquish());
+    }
+
+    void Radar_client::handle_link_data(Tcp_radar_client* link, std::vector<std::uint8_t>&& data)
+    {
+        if (standby_client == nullptr) {
+            handle_data(std::move(data));
+            return;
+        }
+
+        Network::Colossus_protocol::Message msg { std::move(data) };
+        auto type = msg.type();
+
+        std::lock_guard dispatch_lock { dispatch_mutex };
+
+        if (link != active_client) {
+            // Keep the standby link's configuration, so that a switch
+            // does not need to wait for it.
+            //
+            if (type == Message_type::configuration) {
+                std::lock_guard lock { failover_mutex };
+                standby_configuration = msg.relinquish();
+            }
+            return;
+        }
+
+        last_data_time = std::chrono::steady_clock::now().time_since_epoch().count();
+
+        // The configuration kept from the new link is applied here, before
+        // any of the link's data. It is only taken by the link it belongs
+        // to; the link switched from may still be finishing a message.
+        //
+        if (configuration_pending) {
+            std::vector<std::uint8_t> configuration {};
+            {
+                std::lock_guard lock { failover_mutex };
+                if (link == active_client && configuration_pending) {
+                    configuration         = std::move(pending_configuration);
+                    configuration_pending = false;
+                    pending_configuration.clear();
+                }
+            }
+            if (!configuration.empty()) handle_data(std::move(configuration));
+        }
+
+        if (type == Message_type::fft_data || type == Message_type::navigation_data) {
+            auto azimuth = (type == Message_type::fft_data)
+                               ? msg.view_as<Network::Colossus_protocol::Fft_data>()->azimuth()
+                               : msg.view_as<Network::Colossus_protocol::Navigation_data>()->azimuth();
+            complete_failover(link, azimuth);
+            last_azimuth = azimuth;
+        }
+
+        handle_data(msg.relinquish());
+    }
+
+
+    void Radar_client::handle_link_state(Tcp_radar_client* link, const Connection_state& state)
+    {
+        if (standby_client == nullptr || !running) return;
+        if (state == Connection_state::connected || link != active_client) return;
+
+        switch_link("Active link lost");
     }
 
+
+    void Radar_client::failover_check_handler()
+    {
+        if (!send_radar_data && !send_navigation_data) return;
+        if (last_data_time == 0) return;
+
+        using namespace std::chrono;
+
+        // Switch if the active link has been silent for a quarter of a
+        // rotation; that leaves time to resume within the same rotation.
+        //
+        auto silence_limit = (rotation_rate > 0) ? milliseconds(1000 / (4 * rotation_rate)) : default_failover_silence;
+        auto last_data     = steady_clock::time_point { steady_clock::duration { last_data_time.load() } };
+
+        if (steady_clock::now() - last_data < silence_limit) return;
+
+        switch_link("No data on active link");
+    }
+
+
+    void Radar_client::switch_link(const std::string& reason)
+    {
+        // The stream requests are sent after the lock is released; a failed
+        // send reports the link lost, which can call back into switch_link()
+        //
+        std::unique_lock lock { failover_mutex };
+
+        auto previous = active_client.load();
+        auto next     = (previous == &radar_client) ? standby_client.get() : &radar_client;
+        if (next->get_connection_state() != Connection_state::connected) return;
+
+        // Use the configuration already received on the standby link, rather
+        // than waiting for the radar to send it again. It is applied on the
+        // data thread; see handle_link_data().
+        //
+        if (!standby_configuration.empty()) {
+            pending_configuration = std::move(standby_configuration);
+            standby_configuration.clear();
+            configuration_pending = true;
+        }
+
+        if (!failover_pending) {
+            failover_started = std::chrono::steady_clock::time_point { std::chrono::steady_clock::duration {
+                last_data_time.load() } };
+            failover_from    = previous->address();
+            failover_pending = true;
+        }
+
+        active_client  = next;
+        last_data_time = std::chrono::steady_clock::now().time_since_epoch().count();
+        lock.unlock();
+
+        Log("Radar_client - " + reason + " - switched from [" + previous->address().to_string() + "] to [" +
+            next->address().to_string() + "]");
+
+        send_stream_requests(*previous, false);
+        send_stream_requests(*next, true);
+    }
+
+
+    void Radar_client::send_stream_requests(Tcp_radar_client& link, bool start)
+    {
+        if (link.get_connection_state() != Connection_state::connected) return;
+
+        std::vector<Message_type> requests {};
+        if (send_radar_data) requests.push_back(start ? fft_start_type.load() : Message_type::stop_fft_data);
+        if (send_navigation_data) {
+            requests.push_back(start ? Message_type::start_nav_data : Message_type::stop_nav_data);
+        }
+        if (send_health_data) {
+            requests.push_back(start ? Message_type::start_health_msgs : Message_type::stop_health_msgs);
+        }
+
+        for (auto type : requests) {
+            Network::Colossus_protocol::Message msg {};
+            msg.type(type);
+            link.send(msg.relinquish());
+        }
+    }
+
+
+    void Radar_client::complete_failover(Tcp_radar_client* link, std::uint16_t azimuth)
+    {
+        std::unique_lock lock { failover_mutex };
+        if (!failover_pending || link != active_client) return;
+        failover_pending = false;
+
+        auto report                = allocate_shared<Failover_report>();
+        report->from_address       = failover_from;
+        report->to_address         = active_client.load()->address();
+        report->switchover_latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - failover_started);
+
+        if (encoder_size > 0 && azimuth_samples > 0) {
+            auto encoder_step     = std::max(1, encoder_size / azimuth_samples);
+            auto encoder_gap      = (azimuth + encoder_size - last_azimuth) % encoder_size;
+            report->azimuths_lost = (encoder_gap > encoder_step) ? (encoder_gap / encoder_step) - 1 : 0;
+        }
+        lock.unlock();
+
+        Log("Radar_client - Failover complete in [" + std::to_string(report->switchover_latency.count()) +
+            "us] azimuths lost [" + std::to_string(report->azimuths_lost) + "]");
+
+        callback_mutex.lock();
+        auto failover_fn = failover_callback;
+        callback_mutex.unlock();
+        if (failover_fn != nullptr) failover_fn(report);
+    }
+
+
     void Radar_client::handle_data(std::vector<std::uint8_t>&& data)
     {
         Network::Colossus_protocol::Message msg { std::move(data) };
@@ -280,28 +733,34 @@ namespace Navtech {
     {
         Log("Radar_client - Handle Configuration Message");
 
+        auto config                 = msg.view_as<Network::Colossus_protocol::Configuration>();
+        auto protobuf_configuration = Colossus_decoding::protobuf_configuration(*config);
+
+        if (send_radar_data) send_simple_network_message(fft_start_type);
+
+        encoder_size    = config->encoder_size();
+        azimuth_samples = config->azimuth_samples();
+        rotation_rate   = config->rotation_speed() / 1000;
+        bin_size        = protobuf_configuration->rangeresolutionmetres();
+        range_in_bins   = config->range_in_bins();
+        staring_mode    = protobuf_configuration->staringmode() != 0;
+
+        configure_rotations();
+        fft_tracker.configure(encoder_size, azimuth_samples, staring_mode);
+        navigation_tracker.configure(encoder_size, azimuth_samples, staring_mode);
+        fft_timestamps.configure(encoder_size, config->rotation_speed());
+        navigation_timestamps.configure(encoder_size, config->rotation_speed());
+
+        auto new_ranges =
+            allocate_shared<const Range_table>(range_in_bins, bin_size, config->range_gain(), config->range_offset());
+        std::atomic_store(&ranges, new_ranges);
+
         callback_mutex.lock();
         auto configuration_fn = configuration_data_callback;
         callback_mutex.unlock();
         if (configuration_fn != nullptr) {
-            auto config                 = msg.view_as<Network::Colossus_protocol::Configuration>();
-            auto protobuf_configuration = allocate_shared<Colossus::Protobuf::ConfigurationData>();
-            protobuf_configuration->ParseFromString(config->to_string());
-
-            if (send_radar_data) send_simple_network_message(Network::Colossus_protocol::Message::Type::start_fft_data);
-
-            encoder_size                               = config->encoder_size();
-            bin_size                                   = protobuf_configuration->rangeresolutionmetres();
-            auto configuration_data                    = allocate_shared<Configuration_data>();
-            configuration_data->azimuth_samples        = config->azimuth_samples();
-            configuration_data->bin_size               = bin_size;
-            configuration_data->range_in_bins          = config->range_in_bins();
-            configuration_data->encoder_size           = encoder_size;
-            configuration_data->expected_rotation_rate = config->rotation_speed() / 1000;
-            configuration_data->range_gain             = config->range_gain();
-            configuration_data->range_offset           = config->range_offset();
-
-            configuration_fn(configuration_data, protobuf_configuration);
+            configuration_fn(Colossus_decoding::configuration_data(*config, *protobuf_configuration, new_ranges),
+                             protobuf_configuration);
         }
 
         if (raw_configuration_data_callback == nullptr) return;
@@ -315,61 +774,159 @@ namespace Navtech {
         callback_mutex.unlock();
         if (health_data_fn == nullptr) return;
 
-        auto health          = msg.view_as<Network::Colossus_protocol::Health>();
-        auto protobuf_health = allocate_shared<Colossus::Protobuf::Health>();
-        protobuf_health->ParseFromString(health->to_string());
+        health_data_fn(Colossus_decoding::health(*msg.view_as<Network::Colossus_protocol::Health>()));
+    }
 
-        health_data_fn(protobuf_health);
+    void Radar_client::configure_rotations()
+    {
+        applied_region = requested_region;
+
+        // Frames restricted to a region start at the end of its sector
+        //
+        first_rotation_row = applied_region.is_whole_rotation() ? 0 : applied_region.end_azimuth;
+
+        if (staring_mode) {
+            staring_integrator.configure(range_in_bins, encoder_size, applied_region);
+            return;
+        }
+        rotation_assembler.configure(azimuth_samples, range_in_bins, encoder_size, applied_region);
+    }
+
+
+    // Feeds the clock offset estimator, and returns the latency of this
+    // message.
+    //
+    std::chrono::nanoseconds Radar_client::estimate_latency(Radar_time timestamp)
+    {
+        if (timestamp == Radar_time {}) return std::chrono::nanoseconds { 0 };
+
+        auto received = std::chrono::time_point_cast<std::chrono::nanoseconds>(Radar_clock::now());
+
+        if (clock_offset_estimator.add(timestamp, received)) {
+            callback_mutex.lock();
+            auto clock_offset_fn = clock_offset_callback;
+            callback_mutex.unlock();
+            if (clock_offset_fn != nullptr) clock_offset_fn(clock_offset_estimator.estimate());
+        }
+
+        return clock_offset_estimator.latency(timestamp, received);
     }
 
+
     void Radar_client::handle_fft_data_message(Network::Colossus_protocol::Message& msg)
     {
-        callback_mutex.lock();
-        auto fft_data_fn = fft_data_callback;
-        callback_mutex.unlock();
-        if (fft_data_fn != nullptr) {
-            auto fft_data = msg.view_as<Network::Colossus_protocol::Fft_data>();
-
-            auto fftData               = allocate_shared<Fft_data>();
-            fftData->azimuth           = fft_data->azimuth();
-            fftData->angle             = (fft_data->azimuth() * 360.0f) / encoder_size;
-            fftData->sweep_counter     = fft_data->sweep_counter();
-            fftData->ntp_seconds       = fft_data->ntp_seconds();
-            fftData->ntp_split_seconds = fft_data->ntp_split_seconds();
-            fftData->data              = fft_data->to_vector();
-
-            fft_data_fn(fftData);
+        auto fft_data   = msg.view_as<Network::Colossus_protocol::Fft_data>();
+        auto continuity = fft_tracker.check(fft_data->azimuth(), fft_data->sweep_counter());
+        auto timestamp =
+            fft_timestamps.normalise(fft_data->azimuth(), fft_data->ntp_seconds(), fft_data->ntp_split_seconds());
+        auto latency = estimate_latency(timestamp);
+
+        if (requested_region.load() != applied_region && encoder_size > 0) configure_rotations();
+        update_blanking_mask();
+        update_contour_table();
+
+        auto azimuth_index = std::uint16_t { 0 };
+        if (encoder_size > 0) {
+            azimuth_index = static_cast<std::uint16_t>(
+                (fft_data->azimuth() % encoder_size) * static_cast<std::uint32_t>(azimuth_samples) / encoder_size);
+        }
+
+        // Azimuths outside the region, or blanked and dropped, are rejected
+        // on their header alone. A staring radar has no sector.
+        //
+        auto blanked   = blanking_mask.is_blanked(fft_data->azimuth());
+        auto zeroed    = blanked && blanking_action == Blanking_action::zero;
+        auto in_region = !blanked || zeroed;
+        if (in_region && !applied_region.is_whole_rotation() && encoder_size > 0 && !staring_mode) {
+            in_region = applied_region.contains_azimuth(azimuth_index);
+        }
+
+        if (in_region) {
+            auto bins      = static_cast<std::uint16_t>(fft_data->fft_end() - fft_data->fft_begin());
+            auto first_bin = applied_region.first_bin(bins);
+            auto begin     = fft_data->fft_begin() + first_bin;
+            auto end       = fft_data->fft_begin() + applied_region.last_bin(bins);
+
+            // Bins beyond the contour are never copied
+            //
+            if (!contour_table.empty() && !staring_mode) {
+                auto keep = contour_table.bins_to_keep_at(azimuth_index, first_bin);
+                end       = begin + std::min<std::size_t>(end - begin, keep);
+            }
+            auto size = static_cast<std::size_t>(end - begin);
+
+            callback_mutex.lock();
+            auto fft_data_fn = fft_data_callback;
+            callback_mutex.unlock();
+            if (fft_data_fn != nullptr) {
+                auto fftData       = Colossus_decoding::fft_data(*fft_data, encoder_size);
+                fftData->timestamp = timestamp;
+                fftData->latency   = latency;
+                fftData->first_bin = first_bin;
+                if (zeroed) {
+                    fftData->data.assign(size, 0);
+                }
+                else {
+                    fftData->data.assign(begin, end);
+                }
+
+                fft_data_fn(fftData);
+            }
+
+            auto assembling =
+                staring_mode ? staring_integrator.has_callback() : rotation_assembler.has_rotation_callback();
+            if (assembling) {
+                Azimuth_record record {};
+                record.azimuth           = fft_data->azimuth();
+                record.sweep_counter     = fft_data->sweep_counter();
+                record.ntp_seconds       = fft_data->ntp_seconds();
+                record.ntp_split_seconds = fft_data->ntp_split_seconds();
+                record.continuity        = continuity;
+
+                // Rows are zero-filled past the data given, so a zeroed
+                // azimuth is added with no data at all
+                //
+                if (zeroed) size = 0;
+
+                if (staring_mode) {
+                    staring_integrator.add(record, begin, size);
+                }
+                else {
+                    rotation_assembler.add(record, begin, size);
+                }
+            }
+        }
+        else if (rotation_assembler.has_rotation_callback()) {
+            rotation_assembler.skip(fft_data->azimuth());
         }
 
         if (raw_fft_data_callback == nullptr) return;
         raw_fft_data_callback(msg.relinquish());
     }
 
+
     void Radar_client::handle_navigation_data_message(Network::Colossus_protocol::Message& msg)
     {
+        auto nav_data  = msg.view_as<Network::Colossus_protocol::Navigation_data>();
+        auto timestamp = navigation_timestamps.normalise(
+            nav_data->azimuth(), nav_data->ntp_seconds(), nav_data->ntp_split_seconds());
+        auto latency = estimate_latency(timestamp);
+        navigation_tracker.check(nav_data->azimuth());
+
+        update_blanking_mask();
+        auto blanked = blanking_mask.is_blanked(nav_data->azimuth());
+        if (blanked && blanking_action == Blanking_action::drop) return;
+
         callback_mutex.lock();
         auto navigation_data_fn = navigation_data_callback;
         callback_mutex.unlock();
         if (navigation_data_fn == nullptr) return;
 
-        auto nav_data = msg.view_as<Network::Colossus_protocol::Navigation_data>();
-        auto targets  = nav_data->to_vector();
-
-        auto navigation_data               = allocate_shared<Navigation_data>();
-        navigation_data->azimuth           = nav_data->azimuth();
-        navigation_data->ntp_seconds       = nav_data->ntp_seconds();
-        navigation_data->ntp_split_seconds = nav_data->ntp_split_seconds();
-        navigation_data->angle             = (nav_data->azimuth() * 360.0f) / encoder_size;
-
-        auto peaks_count = targets.size() / nav_data_record_length;
-        for (auto i = 0u; i < (peaks_count * nav_data_record_length); i += nav_data_record_length) {
-            std::uint32_t peak_resolve = 0;
-            std::memcpy(&peak_resolve, &targets[i], sizeof(peak_resolve));
-            std::uint16_t power = 0;
-            std::memcpy(&power, &targets[i + sizeof(peak_resolve)], sizeof(power));
-            navigation_data->peaks.push_back(
-                std::make_tuple<float, std::uint16_t>(htonl(peak_resolve) / range_multiplier_float, htons(power)));
-        }
+        // A zeroed azimuth has no peaks
+        //
+        auto navigation_data       = Colossus_decoding::navigation_data(*nav_data, encoder_size, !blanked);
+        navigation_data->timestamp = timestamp;
+        navigation_data->latency   = latency;
 
         navigation_data_fn(navigation_data);
     }
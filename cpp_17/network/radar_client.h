@@ -8,6 +8,7 @@
 #define RADAR_CLIENT_H
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <mutex>
 #include <string>
@@ -17,6 +18,16 @@
 #include <health.pb.h>
 
 #include "../utility/pointer_types.h"
+#include "../utility/timer.h"
+#include "../navigation/sector_blanking.h"
+#include "../rotation/clock_offset_estimator.h"
+#include "../rotation/continuity_tracker.h"
+#include "../rotation/contour_table.h"
+#include "../rotation/range_table.h"
+#include "../rotation/region_of_interest.h"
+#include "../rotation/rotation_assembler.h"
+#include "../rotation/staring_integrator.h"
+#include "../rotation/timestamp_normaliser.h"
 #include "colossus_network_message.h"
 #include "tcp_radar_client.h"
 
@@ -26,8 +37,6 @@ namespace Navtech {
     constexpr float range_multiplier_float         = 1000000.0f;
     constexpr std::uint32_t nav_data_record_length = (sizeof(std::uint32_t) + sizeof(std::uint16_t));
 
-    class Blanking_sector_list;
-
     struct Fft_data
     {
         using Pointer = Shared_owner<Fft_data>;
@@ -36,6 +45,9 @@ namespace Navtech {
         std::uint16_t sweep_counter { 0 };
         std::uint32_t ntp_seconds { 0 };
         std::uint32_t ntp_split_seconds { 0 };
+        Radar_time timestamp {};
+        std::chrono::nanoseconds latency { 0 };
+        std::uint16_t first_bin { 0 };
         std::vector<std::uint8_t> data;
     };
 
@@ -46,6 +58,8 @@ namespace Navtech {
         std::uint16_t azimuth { 0 };
         std::uint32_t ntp_seconds { 0 };
         std::uint32_t ntp_split_seconds { 0 };
+        Radar_time timestamp {};
+        std::chrono::nanoseconds latency { 0 };
         std::vector<std::tuple<float, std::uint16_t>> peaks;
     };
 
@@ -61,6 +75,12 @@ namespace Navtech {
         std::uint16_t expected_rotation_rate { 0 };
         float range_gain { 0.0f };
         float range_offset { 0.0f };
+        bool staring_mode { false };
+
+        // Convert bins to metres with this, rather than from bin_size, so
+        // that range_gain and range_offset are applied
+        //
+        Range_table::Pointer range_table {};
     };
 
    
@@ -75,9 +95,38 @@ namespace Navtech {
     };
 
 
+    // Reported by a Radar_client with a standby link, each time it switches
+    // from a failed link to the other one.
+    // - switchover_latency is measured from the last data received on the
+    //   failed link to the first data received on the new link.
+    // - azimuths_lost is the number of azimuths missing between those two
+    //   messages.
+    //
+    struct Failover_report
+    {
+        using Pointer = Shared_owner<Failover_report>;
+
+        Utility::IP_address from_address {};
+        Utility::IP_address to_address {};
+        std::chrono::microseconds switchover_latency { 0 };
+        std::uint32_t azimuths_lost { 0 };
+    };
+
+
     class Radar_client {
     public:
-        explicit Radar_client(const Utility::IP_address& radarAddress, const std::uint16_t& port = 6317);
+        explicit Radar_client(const Utility::IP_address& radarAddress,
+                              const std::uint16_t& port = 6317,
+                              Threading_mode mode       = Threading_mode::threaded);
+
+        // Hot-standby operation. Both links are connected at start(); the
+        // standby link takes over if the primary disconnects or stops
+        // delivering data, and any running FFT, navigation and health
+        // streams are restarted on it automatically.
+        //
+        Radar_client(const Utility::IP_address& primaryAddress,
+                     const Utility::IP_address& standbyAddress,
+                     const std::uint16_t& port = 6317);
         Radar_client(const Radar_client&) = delete;
         Radar_client(Radar_client&&)      = delete;
         Radar_client& operator=(const Radar_client&) = delete;
@@ -86,6 +135,16 @@ namespace Navtech {
         void start();
         void stop();
 
+        // Threading_mode::polled only. No SDK threads are created; all
+        // callbacks are made from poll(), on the caller's thread.
+        // Wait for native_handle() to become readable (or writable, while
+        // connecting) or for next_deadline() to pass, then call poll().
+        // The handle changes each time the client reconnects.
+        //
+        std::size_t poll(std::size_t budget);
+        std::int32_t native_handle() const;
+        std::chrono::steady_clock::time_point next_deadline() const;
+
         void update_contour_map(const std::vector<std::uint8_t>& contourData);
         void start_fft_data();
         void start_non_contour_fft_data();
@@ -110,10 +169,112 @@ namespace Navtech {
         void set_navigation_config_callback(std::function<void(const Navigation_config::Pointer&)> fn = nullptr);
         void set_blanking_sectors(const Blanking_sector_list& sector_list);
 
+        // Blank sectors in this client only, for radars that ignore
+        // set_blanking_sectors() or for consumers that need their own
+        // blanking. Blanked azimuths are dropped, or have their data
+        // zeroed, as each FFT or navigation message is decoded. Raw data
+        // callbacks are not affected.
+        //
+        void set_client_blanking(const Blanking_sector_list& sector_list,
+                                 Blanking_action action = Blanking_action::drop);
+        void clear_client_blanking();
+
+        // Apply a contour, in the update_contour_map() format, in this
+        // client only. Each FFT azimuth is truncated at the contour as it
+        // is decoded, so bins beyond it are never copied; rotation frames
+        // hold zeros there. See Contour_table for applying other contours
+        // to individual frames.
+        //
+        void set_client_contour(const std::vector<std::uint8_t>& contour_data);
+        void clear_client_contour();
+        void set_failover_callback(std::function<void(const Failover_report::Pointer&)> fn = nullptr);
+
+        // Complete rotations of FFT data, assembled from the FFT stream.
+        // Copy the handle to keep the frame; see Rotation_assembler.
+        // Subscribers receive rotations reduced to their own profile.
+        // The pool size takes effect when the next configuration is received.
+        //
+        void set_rotation_callback(std::function<void(const Rotation_frame_handle&)> fn = nullptr);
+        void set_rotation_pool_size(std::size_t frame_count, Page_size page_size = Page_size::huge);
+        Rotation_subscriber_id add_rotation_subscriber(const Reduction_profile& profile,
+                                                       std::function<void(const Rotation_frame_handle&)> fn);
+        void remove_rotation_subscriber(Rotation_subscriber_id id);
+        void set_rotation_resampling(bool enable, std::uint16_t max_gap = std::numeric_limits<std::uint16_t>::max());
+
+        // The last rotations, for lookup by rotation number, age or time;
+        // see Rotation_history. The pool is enlarged to hold them. The
+        // depth takes effect when the next configuration is received.
+        //
+        void set_rotation_history_depth(std::size_t rotations);
+        const Rotation_history& rotation_history() const;
+
+        // Sectors of the rotation being assembled, delivered as soon as
+        // each one is complete rather than once per rotation.
+        //
+        void set_sector_callback(std::function<void(const Rotation_sector&)> fn = nullptr,
+                                 std::uint16_t azimuths_per_sector       = 0);
+        void set_sector_callback_degrees(std::function<void(const Rotation_sector&)> fn, float degrees_per_sector);
+
+        // A staring radar's FFTs are integrated over a sliding window and
+        // delivered on a timer instead of as rotations; see
+        // Staring_integrator. The profile takes effect when the next
+        // configuration is received. In polled mode, poll() also delivers
+        // the FFTs received since the last product once the flush interval
+        // has passed, if no more arrive; next_deadline() allows for this.
+        //
+        void set_staring_callback(std::function<void(const Rotation_frame_handle&)> fn = nullptr);
+        void set_staring_profile(const Staring_profile& profile);
+
+        // Decode only this azimuth sector and range window. FFT azimuths
+        // outside the sector are discarded after reading their header, and
+        // only the window's bins are copied into Fft_data (see first_bin)
+        // and rotation frames. Raw FFT data callbacks are not affected.
+        //
+        void set_region_of_interest(const Region_of_interest& roi = Region_of_interest {});
+        Region_of_interest region_of_interest() const;
+
+        // Missing, duplicated and out-of-sequence azimuths on each stream,
+        // since the last configuration message.
+        //
+        Continuity_counters fft_continuity() const;
+        Continuity_counters navigation_continuity() const;
+
+        // Fft_data and Navigation_data timestamps are normalised, with
+        // missing and duplicated timestamps interpolated from the rotation
+        // rate; see Timestamp_normaliser. rotation_timestamps() does the
+        // same for every row of a rotation frame.
+        //
+        bool rotation_timestamps(const Rotation_frame& frame, std::vector<Radar_time>& out) const;
+        void set_timestamp_step_tolerance(std::chrono::nanoseconds tolerance);
+        Timestamp_counters fft_timestamp_counters() const;
+        Timestamp_counters navigation_timestamp_counters() const;
+
+        // Offset and drift of the host clock against the radar's, and
+        // latency beyond the fastest message, estimated from the receive
+        // time of every FFT and navigation azimuth (see
+        // Clock_offset_estimator). Each message's own latency is given in
+        // Fft_data and Navigation_data. The callback is called once per
+        // estimation window.
+        //
+        Clock_offset_estimate clock_offset() const;
+        void set_clock_offset_callback(std::function<void(const Clock_offset_estimate&)> fn = nullptr);
+
+        // Bin to range conversion for the current configuration, as given
+        // in Configuration_data. Empty until a configuration is received.
+        //
+        Range_table::Pointer range_table() const;
+
     private:
         Tcp_radar_client radar_client;
+        Owner_of<Tcp_radar_client> standby_client { nullptr };
+        std::atomic<Tcp_radar_client*> active_client { nullptr };
         std::atomic_bool running;
         std::atomic_bool send_radar_data;
+        std::atomic_bool send_navigation_data { false };
+        std::atomic_bool send_health_data { false };
+        std::atomic<Network::Colossus_protocol::Message::Type> fft_start_type {
+            Network::Colossus_protocol::Message::Type::start_fft_data
+        };
         std::mutex callback_mutex;
         std::function<void(const std::vector<uint8_t>&)> raw_fft_data_callback        = nullptr;
         std::function<void(const Fft_data::Pointer&)> fft_data_callback               = nullptr;
@@ -123,9 +284,80 @@ namespace Navtech {
         std::function<void(const std::vector<uint8_t>&)> raw_configuration_data_callback          = nullptr;
         std::function<void(const Shared_owner<Colossus::Protobuf::Health>&)> health_data_callback = nullptr;
         std::function<void(const Navigation_config::Pointer&)> navigation_config_callback         = nullptr;
+        std::function<void(const Failover_report::Pointer&)> failover_callback                    = nullptr;
+        std::function<void(const Clock_offset_estimate&)> clock_offset_callback                   = nullptr;
+
+        std::uint16_t encoder_size    = 0;
+        std::uint16_t azimuth_samples = 0;
+        double bin_size               = 0;
+        std::uint16_t range_in_bins   = 0;
+        bool staring_mode             = false;
+
+        // Read by the failover timer
+        //
+        std::atomic<std::uint16_t> rotation_rate { 0 };
+
+        // Replaced, never modified, on each configuration message; use
+        // std::atomic_load and std::atomic_store
+        //
+        Range_table::Pointer ranges { allocate_shared<const Range_table>() };
 
-        std::uint16_t encoder_size = 0;
-        double bin_size            = 0;
+        std::atomic<Region_of_interest> requested_region {};
+        Region_of_interest applied_region {};
+
+        // The row each rotation frame starts at, for the region applied to
+        // the assembler; read by rotation_timestamps() from any thread
+        //
+        std::atomic<std::uint16_t> first_rotation_row { 0 };
+
+        // The mask is compiled on the data thread whenever the requested
+        // sectors or the encoder size change
+        //
+        std::mutex blanking_mutex;
+        Blanking_sector_list requested_blanking {};
+        std::atomic_bool blanking_changed { false };
+        std::atomic<Blanking_action> blanking_action { Blanking_action::drop };
+        Blanking_mask blanking_mask {};
+
+        // Compiled on the data thread whenever the contour, the azimuth
+        // samples or the bin size change
+        //
+        std::mutex contour_mutex;
+        std::vector<std::uint8_t> requested_contour {};
+        std::atomic_bool contour_changed { false };
+        Contour_table contour_table {};
+        double contour_bin_size { 0 };
+
+        Rotation_assembler rotation_assembler;
+        Staring_integrator staring_integrator;
+        Continuity_tracker fft_tracker;
+        Continuity_tracker navigation_tracker;
+        Timestamp_normaliser fft_timestamps;
+        Timestamp_normaliser navigation_timestamps;
+        Clock_offset_estimator clock_offset_estimator;
+
+        // Standby link state. Each link has its own dispatch thread; only
+        // one at a time may deliver data, so that a link that was active
+        // until a switch cannot overlap with the one that replaced it.
+        //
+        std::mutex dispatch_mutex;
+        std::mutex failover_mutex;
+        Timer failover_timer;
+        std::atomic<std::chrono::steady_clock::rep> last_data_time { 0 };
+        std::atomic<std::uint16_t> last_azimuth { 0 };
+        bool failover_pending { false };
+        std::chrono::steady_clock::time_point failover_started {};
+        Utility::IP_address failover_from {};
+        std::vector<std::uint8_t> standby_configuration {};
+        std::vector<std::uint8_t> pending_configuration {};
+        std::atomic_bool configuration_pending { false };
+
+        void handle_link_data(Tcp_radar_client* link, std::vector<std::uint8_t>&& data);
+        void handle_link_state(Tcp_radar_client* link, const Connection_state& state);
+        void failover_check_handler();
+        void switch_link(const std::string& reason);
+        void complete_failover(Tcp_radar_client* link, std::uint16_t azimuth);
+        void send_stream_requests(Tcp_radar_client& link, bool start);
 
         void handle_data(std::vector<std::uint8_t>&& data);
         void handle_configuration_message(Network::Colossus_protocol::Message& msg);
@@ -134,6 +366,11 @@ namespace Navtech {
         void handle_navigation_data_message(Network::Colossus_protocol::Message& data);
         void handle_navigation_config_message(Network::Colossus_protocol::Message& data);
 
+        void configure_rotations();
+        void update_blanking_mask();
+        void update_contour_table();
+        std::chrono::nanoseconds estimate_latency(Radar_time timestamp);
+
         void send_simple_network_message(const Network::Colossus_protocol::Message::Type& type);
     };
 
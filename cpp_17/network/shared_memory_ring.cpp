@@ -0,0 +1,461 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <cstring>
+#include <new>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../common.h"
+#include "colossus_decoding.h"
+#include "colossus_messages.h"
+#include "shared_memory_ring.h"
+
+namespace Navtech {
+
+    using namespace Shared_memory;
+    using Network::Colossus_protocol::Message;
+
+    constexpr std::chrono::microseconds reader_poll_interval { 250 };
+    constexpr int max_read_attempts { 4 };
+
+
+    namespace {
+
+        std::string posix_name(const std::string& name)
+        {
+            return (!name.empty() && name[0] == '/') ? name : "/" + name;
+        }
+
+
+        std::uint32_t aligned_slot_size(std::uint32_t requested)
+        {
+            return ((requested + alignof(Slot_header) - 1) / alignof(Slot_header)) * alignof(Slot_header);
+        }
+
+
+        std::size_t slot_stride(std::uint32_t slot_size)
+        {
+            return sizeof(Slot_header) + slot_size;
+        }
+
+
+        // Slot 0 holds the latest configuration message; the ring
+        // occupies slots 1 to slot_count.
+        //
+        std::size_t ring_size(std::uint32_t slot_count, std::uint32_t slot_size)
+        {
+            return sizeof(Ring_header) + (slot_count + 1) * slot_stride(slot_size);
+        }
+
+    } // namespace
+
+
+    // ---------------------------------------------------------------------------------------------------------
+    // Shared_memory_publisher
+    //
+    Shared_memory_publisher::Shared_memory_publisher(const std::string& ring_name,
+                                                     std::uint32_t count,
+                                                     std::uint32_t size,
+                                                     mode_t permissions) :
+        name        { posix_name(ring_name) },
+        slot_count  { count },
+        slot_size   { aligned_slot_size(size) },
+        mode        { permissions }
+    {
+    }
+
+
+    Shared_memory_publisher::~Shared_memory_publisher()
+    {
+        close();
+    }
+
+
+    bool Shared_memory_publisher::open()
+    {
+        if (mapped != nullptr) return true;
+
+        auto fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR, mode);
+        if (fd == -1) {
+            Log("Shared_memory_publisher - Failed to create [" + name + "]");
+            return false;
+        }
+
+        mapped_size = ring_size(slot_count, slot_size);
+        if (::ftruncate(fd, mapped_size) == -1) {
+            Log("Shared_memory_publisher - Failed to size [" + name + "]");
+            ::close(fd);
+            return false;
+        }
+
+        auto memory = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) {
+            Log("Shared_memory_publisher - Failed to map [" + name + "]");
+            return false;
+        }
+
+        mapped = static_cast<std::uint8_t*>(memory);
+        std::memset(mapped, 0, mapped_size);
+
+        auto header = new (mapped) Ring_header {};
+        for (std::uint32_t i = 0; i <= slot_count; ++i) {
+            new (mapped + sizeof(Ring_header) + i * slot_stride(slot_size)) Slot_header {};
+        }
+
+        header->slot_count = slot_count;
+        header->slot_size  = slot_size;
+        header->version    = ring_version;
+        header->write_index.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        header->magic = ring_magic;
+
+        Log("Shared_memory_publisher - Publishing on [" + name + "]");
+        return true;
+    }
+
+
+    void Shared_memory_publisher::close()
+    {
+        if (mapped == nullptr) return;
+
+        ::munmap(mapped, mapped_size);
+        ::shm_unlink(name.c_str());
+        mapped = nullptr;
+    }
+
+
+    void Shared_memory_publisher::publish(const std::vector<std::uint8_t>& message)
+    {
+        if (mapped == nullptr || message.size() < Message::header_size()) return;
+
+        if (message.size() > slot_size) {
+            oversized++;
+            return;
+        }
+
+        std::lock_guard lock { publish_mutex };
+
+        auto header = reinterpret_cast<Ring_header*>(mapped);
+        auto slots  = mapped + sizeof(Ring_header);
+
+        Message msg { message.data(), Message::header_size() };
+        if (msg.type() == Message::Type::configuration) {
+            write_slot(reinterpret_cast<Slot_header*>(slots), 0, message);
+            return;
+        }
+
+        auto index = header->write_index.load(std::memory_order_relaxed);
+        auto slot  = reinterpret_cast<Slot_header*>(slots + (1 + index % slot_count) * slot_stride(slot_size));
+
+        write_slot(slot, index, message);
+        header->write_index.store(index + 1, std::memory_order_release);
+        published++;
+    }
+
+
+    void Shared_memory_publisher::write_slot(Slot_header* slot,
+                                             std::uint64_t index,
+                                             const std::vector<std::uint8_t>& message)
+    {
+        // An odd sequence marks the slot as being written
+        //
+        auto sequence = slot->sequence.load(std::memory_order_relaxed);
+        slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot->index = index;
+        slot->size  = static_cast<std::uint32_t>(message.size());
+        std::memcpy(reinterpret_cast<std::uint8_t*>(slot) + sizeof(Slot_header), message.data(), message.size());
+
+        slot->sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+
+    // ---------------------------------------------------------------------------------------------------------
+    // Shared_memory_reader
+    //
+    Shared_memory_reader::Shared_memory_reader(const std::string& ring_name) :
+        name { posix_name(ring_name) }
+    {
+    }
+
+
+    Shared_memory_reader::~Shared_memory_reader()
+    {
+        close();
+    }
+
+
+    bool Shared_memory_reader::open()
+    {
+        if (mapped != nullptr) return true;
+
+        auto fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd == -1) {
+            Log("Shared_memory_reader - Failed to open [" + name + "]");
+            return false;
+        }
+
+        struct stat info {};
+        ::fstat(fd, &info);
+        mapped_size = info.st_size;
+
+        auto memory = ::mmap(nullptr, mapped_size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) {
+            Log("Shared_memory_reader - Failed to map [" + name + "]");
+            return false;
+        }
+
+        mapped = static_cast<const std::uint8_t*>(memory);
+        header = reinterpret_cast<const Ring_header*>(mapped);
+
+        if (mapped_size < sizeof(Ring_header) || header->magic != ring_magic || header->version != ring_version ||
+            mapped_size < ring_size(header->slot_count, header->slot_size)) {
+            Log("Shared_memory_reader - Invalid ring [" + name + "]");
+            close();
+            return false;
+        }
+
+        buffer.reserve(header->slot_size);
+        next_index             = header->write_index.load(std::memory_order_acquire);
+        configuration_sequence = 0;
+        return true;
+    }
+
+
+    void Shared_memory_reader::close()
+    {
+        stop();
+        if (mapped == nullptr) return;
+
+        ::munmap(const_cast<std::uint8_t*>(mapped), mapped_size);
+        mapped = nullptr;
+        header = nullptr;
+    }
+
+
+    void Shared_memory_reader::set_fft_data_callback(std::function<void(const Fft_data::Pointer&)> fn)
+    {
+        std::lock_guard lock { callback_mutex };
+        fft_data_callback = std::move(fn);
+    }
+
+
+    void Shared_memory_reader::set_raw_fft_data_callback(std::function<void(const std::vector<uint8_t>&)> fn)
+    {
+        std::lock_guard lock { callback_mutex };
+        raw_fft_data_callback = std::move(fn);
+    }
+
+
+    void Shared_memory_reader::set_navigation_data_callback(std::function<void(const Navigation_data::Pointer&)> fn)
+    {
+        std::lock_guard lock { callback_mutex };
+        navigation_data_callback = std::move(fn);
+    }
+
+
+    void Shared_memory_reader::set_configuration_data_callback(
+        std::function<void(const Configuration_data::Pointer&, const Configuration_data::ProtobufPointer&)> fn)
+    {
+        std::lock_guard lock { callback_mutex };
+        configuration_data_callback = std::move(fn);
+    }
+
+
+    void Shared_memory_reader::set_raw_configuration_data_callback(std::function<void(const std::vector<uint8_t>&)> fn)
+    {
+        std::lock_guard lock { callback_mutex };
+        raw_configuration_data_callback = std::move(fn);
+    }
+
+
+    void Shared_memory_reader::set_health_data_callback(
+        std::function<void(const Shared_owner<Colossus::Protobuf::Health>&)> fn)
+    {
+        std::lock_guard lock { callback_mutex };
+        health_data_callback = std::move(fn);
+    }
+
+
+    const Slot_header* Shared_memory_reader::slot(std::uint32_t slot_index) const
+    {
+        auto stride = slot_stride(header->slot_size);
+        return reinterpret_cast<const Slot_header*>(mapped + sizeof(Ring_header) + slot_index * stride);
+    }
+
+
+    bool Shared_memory_reader::read_slot(const Slot_header* slot, std::uint64_t& index)
+    {
+        auto payload = reinterpret_cast<const std::uint8_t*>(slot) + sizeof(Slot_header);
+
+        for (int attempt = 0; attempt < max_read_attempts; ++attempt) {
+            auto before = slot->sequence.load(std::memory_order_acquire);
+            if (before & 1) continue;
+
+            index     = slot->index;
+            auto size = std::min(slot->size, header->slot_size);
+            buffer.assign(payload, payload + size);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot->sequence.load(std::memory_order_relaxed) == before) return true;
+        }
+
+        return false;
+    }
+
+
+    void Shared_memory_reader::check_configuration()
+    {
+        auto config_slot = slot(0);
+        auto sequence    = config_slot->sequence.load(std::memory_order_acquire);
+        if (sequence == 0 || sequence == configuration_sequence) return;
+
+        std::uint64_t unused {};
+        if (!read_slot(config_slot, unused)) return;
+
+        configuration_sequence = sequence;
+        dispatch();
+    }
+
+
+    void Shared_memory_reader::do_work()
+    {
+        if (header == nullptr) {
+            std::this_thread::sleep_for(reader_poll_interval);
+            return;
+        }
+
+        check_configuration();
+
+        auto available = header->write_index.load(std::memory_order_acquire);
+        if (available == next_index) {
+            std::this_thread::sleep_for(reader_poll_interval);
+            return;
+        }
+
+        // The publisher never waits; if this reader has fallen more than
+        // a ring behind, skip to the oldest message still available.
+        //
+        if (available - next_index > header->slot_count) {
+            lost += available - header->slot_count - next_index;
+            next_index = available - header->slot_count;
+        }
+
+        while (next_index < available && !stop_requested) {
+            std::uint64_t index {};
+            auto ok = read_slot(slot(1 + next_index % header->slot_count), index);
+            if (!ok || index != next_index) lost++;
+            else dispatch();
+            ++next_index;
+        }
+    }
+
+
+    void Shared_memory_reader::dispatch()
+    {
+        if (buffer.size() < Message::header_size()) return;
+
+        Message msg { std::move(buffer) };
+        auto type = msg.type();
+
+        switch (type) {
+            case Message::Type::configuration:
+                handle_configuration_message(msg);
+                break;
+
+            case Message::Type::fft_data:
+                handle_fft_data_message(msg);
+                break;
+
+            case Message::Type::navigation_data:
+                handle_navigation_data_message(msg);
+                break;
+
+            case Message::Type::health:
+                handle_health_message(msg);
+                break;
+
+            default:
+                break;
+        }
+
+        // Recover the buffer storage for the next message; raw callbacks
+        // are given the framed message in place.
+        //
+        buffer = msg.relinquish();
+
+        std::function<void(const std::vector<uint8_t>&)> raw_fn {};
+        callback_mutex.lock();
+        if (type == Message::Type::fft_data) raw_fn = raw_fft_data_callback;
+        if (type == Message::Type::configuration) raw_fn = raw_configuration_data_callback;
+        callback_mutex.unlock();
+
+        if (raw_fn != nullptr) raw_fn(buffer);
+    }
+
+
+    void Shared_memory_reader::handle_configuration_message(Message& msg)
+    {
+        callback_mutex.lock();
+        auto configuration_fn = configuration_data_callback;
+        callback_mutex.unlock();
+
+        auto config  = msg.view_as<Network::Colossus_protocol::Configuration>();
+        encoder_size = config->encoder_size();
+        if (configuration_fn == nullptr) return;
+
+        auto protobuf_configuration = Colossus_decoding::protobuf_configuration(*config);
+        auto configuration_data     = Colossus_decoding::configuration_data(*config, *protobuf_configuration);
+        configuration_fn(configuration_data, protobuf_configuration);
+    }
+
+
+    void Shared_memory_reader::handle_fft_data_message(Message& msg)
+    {
+        callback_mutex.lock();
+        auto fft_data_fn = fft_data_callback;
+        callback_mutex.unlock();
+        if (fft_data_fn == nullptr || encoder_size == 0) return;
+
+        auto fft_data = msg.view_as<Network::Colossus_protocol::Fft_data>();
+        auto fftData  = Colossus_decoding::fft_data(*fft_data, encoder_size);
+        fftData->data = fft_data->to_vector();
+
+        fft_data_fn(fftData);
+    }
+
+
+    void Shared_memory_reader::handle_navigation_data_message(Message& msg)
+    {
+        callback_mutex.lock();
+        auto navigation_data_fn = navigation_data_callback;
+        callback_mutex.unlock();
+        if (navigation_data_fn == nullptr || encoder_size == 0) return;
+
+        auto nav_data = msg.view_as<Network::Colossus_protocol::Navigation_data>();
+        navigation_data_fn(Colossus_decoding::navigation_data(*nav_data, encoder_size));
+    }
+
+
+    void Shared_memory_reader::handle_health_message(Message& msg)
+    {
+        callback_mutex.lock();
+        auto health_data_fn = health_data_callback;
+        callback_mutex.unlock();
+        if (health_data_fn == nullptr) return;
+
+        health_data_fn(Colossus_decoding::health(*msg.view_as<Network::Colossus_protocol::Health>()));
+    }
+
+} // namespace Navtech
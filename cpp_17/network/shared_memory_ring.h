@@ -0,0 +1,166 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef SHARED_MEMORY_RING_H
+#define SHARED_MEMORY_RING_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#include "../utility/threaded_class.h"
+#include "radar_client.h"
+
+namespace Navtech {
+
+    // --------------------------------------------------------------------------------------------------
+    // A POSIX shared-memory ring of framed Colossus messages, allowing several
+    // local processes to share a single radar connection.
+    //
+    // The publisher owns the shared memory and writes each message into the
+    // next slot. Each slot is protected by a sequence lock (seqlock), so the
+    // publisher never waits for readers; a reader that falls more than a ring's
+    // length behind skips forward and counts the lost messages.
+    //
+    // The most recent configuration message is kept in a dedicated slot, so
+    // readers that attach late still receive it.
+    //
+    namespace Shared_memory {
+
+        constexpr std::uint32_t ring_magic { 0x4e415652 }; // 'NAVR'
+        constexpr std::uint32_t ring_version { 1 };
+        constexpr std::uint32_t default_slot_count { 1024 };
+        constexpr std::uint32_t default_slot_size { 16384 };
+        constexpr mode_t default_permissions { 0600 };
+
+        struct alignas(64) Ring_header
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint32_t slot_count;
+            std::uint32_t slot_size;
+            std::atomic<std::uint64_t> write_index;
+        };
+
+        struct alignas(64) Slot_header
+        {
+            std::atomic<std::uint64_t> sequence;
+            std::uint64_t index;
+            std::uint32_t size;
+        };
+
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                      "Shared memory ring requires lock-free 64-bit atomics");
+
+    } // namespace Shared_memory
+
+
+    // The ring is created with the given permissions; by default only
+    // processes of the same user may read it.
+    //
+    class Shared_memory_publisher {
+    public:
+        explicit Shared_memory_publisher(const std::string& name,
+                                         std::uint32_t slot_count = Shared_memory::default_slot_count,
+                                         std::uint32_t slot_size  = Shared_memory::default_slot_size,
+                                         mode_t permissions       = Shared_memory::default_permissions);
+        ~Shared_memory_publisher();
+
+        Shared_memory_publisher(const Shared_memory_publisher&) = delete;
+        Shared_memory_publisher& operator=(const Shared_memory_publisher&) = delete;
+
+        bool open();
+        void close();
+
+        // Publish a complete, framed Colossus message - as delivered by
+        // Radar_client's raw data callbacks.
+        //
+        void publish(const std::vector<std::uint8_t>& message);
+
+        std::uint64_t messages_published() const { return published; }
+        std::uint64_t messages_oversized() const { return oversized; }
+
+    private:
+        std::string name {};
+        std::uint32_t slot_count { 0 };
+        std::uint32_t slot_size { 0 };
+        mode_t mode { Shared_memory::default_permissions };
+        std::size_t mapped_size { 0 };
+        std::uint8_t* mapped { nullptr };
+        std::mutex publish_mutex {};
+        std::atomic<std::uint64_t> published { 0 };
+        std::atomic<std::uint64_t> oversized { 0 };
+
+        void write_slot(Shared_memory::Slot_header* slot,
+                        std::uint64_t index,
+                        const std::vector<std::uint8_t>& message);
+    };
+
+
+    class Shared_memory_reader : public Threaded_class {
+    public:
+        explicit Shared_memory_reader(const std::string& name);
+        ~Shared_memory_reader();
+
+        bool open();
+        void close();
+
+        void set_fft_data_callback(std::function<void(const Fft_data::Pointer&)> fn = nullptr);
+        void set_raw_fft_data_callback(std::function<void(const std::vector<uint8_t>&)> fn = nullptr);
+        void set_navigation_data_callback(std::function<void(const Navigation_data::Pointer&)> fn = nullptr);
+        void set_configuration_data_callback(
+            std::function<void(const Configuration_data::Pointer&, const Configuration_data::ProtobufPointer&)> fn =
+                nullptr);
+        void set_raw_configuration_data_callback(std::function<void(const std::vector<uint8_t>&)> fn = nullptr);
+        void set_health_data_callback(
+            std::function<void(const Shared_owner<Colossus::Protobuf::Health>&)> fn = nullptr);
+
+        std::uint64_t messages_lost() const { return lost; }
+
+    protected:
+        void do_work() override;
+
+    private:
+        std::string name {};
+        std::size_t mapped_size { 0 };
+        const std::uint8_t* mapped { nullptr };
+        const Shared_memory::Ring_header* header { nullptr };
+
+        std::uint64_t next_index { 0 };
+        std::uint64_t configuration_sequence { 0 };
+        std::vector<std::uint8_t> buffer {};
+        std::atomic<std::uint64_t> lost { 0 };
+
+        std::uint16_t encoder_size { 0 };
+
+        std::mutex callback_mutex;
+        std::function<void(const std::vector<uint8_t>&)> raw_fft_data_callback        = nullptr;
+        std::function<void(const Fft_data::Pointer&)> fft_data_callback               = nullptr;
+        std::function<void(const Navigation_data::Pointer&)> navigation_data_callback = nullptr;
+        std::function<void(const Configuration_data::Pointer&, const Configuration_data::ProtobufPointer&)>
+            configuration_data_callback                                                           = nullptr;
+        std::function<void(const std::vector<uint8_t>&)> raw_configuration_data_callback          = nullptr;
+        std::function<void(const Shared_owner<Colossus::Protobuf::Health>&)> health_data_callback = nullptr;
+
+        const Shared_memory::Slot_header* slot(std::uint32_t slot_index) const;
+        bool read_slot(const Shared_memory::Slot_header* slot, std::uint64_t& index);
+        void check_configuration();
+        void dispatch();
+
+        void handle_configuration_message(Network::Colossus_protocol::Message& msg);
+        void handle_fft_data_message(Network::Colossus_protocol::Message& msg);
+        void handle_navigation_data_message(Network::Colossus_protocol::Message& msg);
+        void handle_health_message(Network::Colossus_protocol::Message& msg);
+    };
+
+} // namespace Navtech
+
+#endif // SHARED_MEMORY_RING_H
@@ -13,7 +13,12 @@
 #include "tcp_radar_client.h"
 
 namespace Navtech {
-    Tcp_radar_client::Tcp_radar_client(const Utility::IP_address& ip_addr, const std::uint16_t& port) :
+    constexpr std::size_t poll_read_size { 65536 };
+
+
+    Tcp_radar_client::Tcp_radar_client(const Utility::IP_address& ip_addr,
+                                       const std::uint16_t& port,
+                                       Threading_mode mode) :
         receive_data_queue      { Threaded_queue<std::vector<std::uint8_t>>() }, 
         ip_address              { ip_addr }, 
         port                    { port },
@@ -22,14 +27,23 @@ namespace Navtech {
         connection_check_timer  { connection_check_timeout },
         connection_state        { Connection_state::disconnected }, 
         reading                 { false }, 
-        running                 { false }
+        running                 { false },
+        threading_mode          { mode }
     {
     }
 
 
     void Tcp_radar_client::set_receive_data_callback(std::function<void(std::vector<std::uint8_t>&&)> callback)
     {
-        receive_data_queue.set_dequeue_callback(std::move(callback));
+        if (threading_mode == Threading_mode::polled) receive_callback = std::move(callback);
+        else receive_data_queue.set_dequeue_callback(std::move(callback));
+    }
+
+
+    void Tcp_radar_client::set_connection_state_callback(std::function<void(const Connection_state&)> callback)
+    {
+        std::lock_guard lock { connection_state_mutex };
+        connection_state_callback = std::move(callback);
     }
 
 
@@ -48,6 +62,12 @@ namespace Navtech {
     {
         if (running) return;
 
+        if (threading_mode == Threading_mode::polled) {
+            running       = true;
+            poll_deadline = std::chrono::steady_clock::now();
+            return;
+        }
+
         receive_data_queue.start();
         running        = true;
         connect_thread = allocate_owned<std::thread>(std::bind(&Tcp_radar_client::connect_thread_handler, this));
@@ -62,6 +82,12 @@ namespace Navtech {
     {
         if (!running) return;
 
+        if (threading_mode == Threading_mode::polled) {
+            poll_disconnect();
+            running = false;
+            return;
+        }
+
         receive_data_queue.stop();
 
         connection_check_timer.enable(false);
@@ -87,9 +113,11 @@ namespace Navtech {
     {
         if (!running) return;
 
-        std::lock_guard lock { connection_state_mutex };
+        std::unique_lock lock { connection_state_mutex };
         if (connection_state == state) { return; }
         connection_state = state;
+        auto state_fn    = connection_state_callback;
+        lock.unlock();
 
         std::string state_string;
         switch (state) {
@@ -106,6 +134,8 @@ namespace Navtech {
 
         Log("Tcp_radar_client - Connection State Changed [" + state_string + "] for [" + ip_address.to_string() + ":" +
             std::to_string(port) + "]");
+
+        if (state_fn != nullptr) state_fn(state);
     }
 
 
@@ -219,8 +249,16 @@ namespace Navtech {
         if (get_connection_state() != Connection_state::connected) return;
 
         if (socket.send(data) != 0) {
-            set_connection_state(Connection_state::disconnected);
             Log("Tcp_radar_client - Send Failed");
+
+            // In polled mode nothing else will close the socket and
+            // schedule the reconnection
+            //
+            if (threading_mode == Threading_mode::polled) {
+                poll_disconnect();
+                return;
+            }
+            set_connection_state(Connection_state::disconnected);
         }
     }
 
@@ -258,4 +296,169 @@ namespace Navtech {
         return true;
     }
 
+
+    std::size_t Tcp_radar_client::poll(std::size_t budget)
+    {
+        if (!running || threading_mode != Threading_mode::polled) return 0;
+
+        if (get_connection_state() != Connection_state::connected) {
+            poll_connect();
+            if (get_connection_state() != Connection_state::connected) return 0;
+        }
+
+        std::size_t dispatched = 0;
+        while (dispatched < budget && running) {
+            if (poll_frame_message()) {
+                ++dispatched;
+                continue;
+            }
+            if (!poll_read()) break;
+        }
+
+        if (dispatched == 0 && running && std::chrono::steady_clock::now() > poll_deadline) {
+            Log("Tcp_radar_client - Read timeout");
+            poll_disconnect();
+        }
+
+        return dispatched;
+    }
+
+
+    std::int32_t Tcp_radar_client::native_handle() const
+    {
+        return socket.native_handle();
+    }
+
+
+    std::chrono::steady_clock::time_point Tcp_radar_client::next_deadline() const
+    {
+        // Disconnected - time of the next connection attempt
+        // Connecting   - time the connection attempt is abandoned
+        // Connected    - time the connection is considered lost, if no data arrives
+        //
+        return poll_deadline;
+    }
+
+
+    void Tcp_radar_client::poll_connect()
+    {
+        using Connect_status = Tcp_socket::Connect_status;
+
+        auto now    = std::chrono::steady_clock::now();
+        auto status = Connect_status::in_progress;
+
+        if (get_connection_state() == Connection_state::disconnected) {
+            if (now < poll_deadline) return;
+
+            set_connection_state(Connection_state::connecting);
+            socket.close();
+            socket.create();
+            socket.set_send_timeout(send_timeout);
+            status        = socket.connect_non_blocking();
+            poll_deadline = now + connection_check_timeout;
+        }
+        else {
+            status = socket.connect_status();
+        }
+
+        switch (status) {
+            case Connect_status::connected:
+                poll_offset   = 0;
+                poll_used     = 0;
+                poll_deadline = now + std::chrono::seconds(read_timeout);
+                set_connection_state(Connection_state::connected);
+                break;
+
+            case Connect_status::in_progress:
+                if (now > poll_deadline) poll_disconnect();
+                break;
+
+            case Connect_status::failed:
+                poll_disconnect();
+                break;
+        }
+    }
+
+
+    void Tcp_radar_client::poll_disconnect()
+    {
+        socket.close(Tcp_socket::Close_option::shutdown);
+        set_connection_state(Connection_state::disconnected);
+        poll_offset   = 0;
+        poll_used     = 0;
+        poll_deadline = std::chrono::steady_clock::now() + connection_check_timeout;
+    }
+
+
+    bool Tcp_radar_client::poll_read()
+    {
+        if (poll_offset == poll_used) poll_offset = poll_used = 0;
+
+        if (poll_buffer.size() - poll_used < poll_read_size) {
+            std::copy(poll_buffer.begin() + poll_offset, poll_buffer.begin() + poll_used, poll_buffer.begin());
+            poll_used -= poll_offset;
+            poll_offset = 0;
+            if (poll_buffer.size() - poll_used < poll_read_size) poll_buffer.resize(poll_used + poll_read_size);
+        }
+
+        auto bytes_read = socket.receive_some(poll_buffer.data() + poll_used, poll_read_size);
+        if (bytes_read == 0) return false;
+        if (bytes_read < 0) {
+            Log("Tcp_radar_client - Read failed");
+            poll_disconnect();
+            return false;
+        }
+
+        poll_used += bytes_read;
+        poll_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(read_timeout);
+        return true;
+    }
+
+
+    bool Tcp_radar_client::poll_frame_message()
+    {
+        auto message_size = frame_message(poll_buffer.data(), poll_offset, poll_used);
+        if (message_size == 0) return false;
+
+        auto begin = poll_buffer.data() + poll_offset;
+        std::vector<std::uint8_t> message { begin, begin + message_size };
+        poll_offset += message_size;
+
+        if (receive_callback != nullptr) receive_callback(std::move(message));
+        return true;
+    }
+
+
+    std::size_t frame_message(const std::uint8_t* buffer, std::size_t& offset, std::size_t used)
+    {
+        using Network::Colossus_protocol::Message;
+
+        const auto& signature = Message::valid_signature();
+
+        while (used - offset >= Message::header_size()) {
+            auto begin = buffer + offset;
+            auto end   = buffer + used;
+
+            if (!std::equal(signature.begin(), signature.end(), begin)) {
+                // Resynchronise on the next signature; keep a possible
+                // partial signature at the end of the buffer.
+                //
+                auto next = std::search(begin + 1, end, signature.begin(), signature.end());
+                offset    = (next != end) ? (next - buffer) : std::max(offset + 1, used - (signature.size() - 1));
+                continue;
+            }
+
+            Message header { begin, Message::header_size() };
+            if (!header.is_valid()) {
+                ++offset;
+                continue;
+            }
+
+            auto message_size = Message::header_size() + header.payload_size();
+            return (used - offset >= message_size) ? message_size : 0;
+        }
+
+        return 0;
+    }
+
 } // namespace Navtech
@@ -26,6 +26,12 @@ namespace Navtech {
 
     enum class Connection_state { disconnected, connecting, connected };
 
+    // threaded - the client owns connect, read and dispatch threads.
+    // polled   - no threads are created; the owner calls poll() from its
+    //            own event loop, waiting on native_handle() and next_deadline().
+    //
+    enum class Threading_mode { threaded, polled };
+
     struct Connection_info
     {
         std::uint32_t unique_id { 0 };
@@ -38,16 +44,36 @@ namespace Navtech {
     constexpr std::uint16_t read_timeout { 60 };
     constexpr std::uint16_t send_timeout { 10 };
 
+    // Find the next Colossus message in buffer[offset, used), skipping any
+    // bytes before a valid header. Returns the size of the message, which
+    // then starts at offset; or 0 if no whole message is held, with offset
+    // at the first byte that may start one.
+    //
+    std::size_t frame_message(const std::uint8_t* buffer, std::size_t& offset, std::size_t used);
+
     class Tcp_radar_client {
     public:
-        explicit Tcp_radar_client(const Utility::IP_address& ip_address, const std::uint16_t& port = 6317);
+        explicit Tcp_radar_client(const Utility::IP_address& ip_address,
+                                  const std::uint16_t& port = 6317,
+                                  Threading_mode mode       = Threading_mode::threaded);
         explicit Tcp_radar_client(const Tcp_radar_client&) = delete;
         Tcp_radar_client& operator=(const Tcp_radar_client&) = delete;
         void start();
         void stop();
         void send(const std::vector<std::uint8_t> data);
         void set_receive_data_callback(std::function<void(std::vector<std::uint8_t>&&)> callback = nullptr);
+        void set_connection_state_callback(std::function<void(const Connection_state&)> callback = nullptr);
         Navtech::Connection_state get_connection_state();
+        const Utility::IP_address& address() const { return ip_address; }
+
+        // Polled mode interface.
+        // poll() connects or reconnects when due, then reads, frames and
+        // dispatches up to budget messages on the caller's thread.
+        // The handle changes on reconnection; it is -1 while disconnected.
+        //
+        std::size_t poll(std::size_t budget);
+        std::int32_t native_handle() const;
+        std::chrono::steady_clock::time_point next_deadline() const;
 
     private:
         Threaded_queue<std::vector<std::uint8_t>> receive_data_queue;
@@ -59,17 +85,30 @@ namespace Navtech {
         Timer connection_check_timer;
         Connection_state connection_state { Connection_state::disconnected };
         std::mutex connection_state_mutex {};
+        std::function<void(const Connection_state&)> connection_state_callback = nullptr;
         std::condition_variable connect_condition {};
         std::mutex connect_mutex {};
         std::atomic_bool reading {};
         std::atomic_bool running {};
 
+        Threading_mode threading_mode { Threading_mode::threaded };
+        std::function<void(std::vector<std::uint8_t>&&)> receive_callback = nullptr;
+        std::vector<std::uint8_t> poll_buffer {};
+        std::size_t poll_offset { 0 };
+        std::size_t poll_used { 0 };
+        std::chrono::steady_clock::time_point poll_deadline {};
+
         void set_connection_state(const Connection_state& state);
         void connection_check_handler();
         void connect_thread_handler();
         void connect();
         void read_thread_handler();
         bool handle_data();
+
+        void poll_connect();
+        bool poll_read();
+        bool poll_frame_message();
+        void poll_disconnect();
     };
 
 } // namespace Navtech
@@ -4,6 +4,7 @@
 // for full license details.
 //
 
+#include <cerrno>
 #include <cstring>
 
 #ifdef _WIN32
@@ -11,6 +12,9 @@
 #include <ws2tcpip.h>
 #else
 #include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/tcp.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -28,6 +32,14 @@ namespace Navtech {
     }
 
 
+    Tcp_socket::Tcp_socket(std::int32_t accepted, const Utility::IP_address& peer, std::uint16_t peer_port) :
+        sock { accepted },
+        destination { peer },
+        port { peer_port }
+    {
+    }
+
+
     Tcp_socket::~Tcp_socket()
     {
         if (is_valid()) {
@@ -109,41 +121,141 @@ namespace Navtech {
     }
 
 
-    std::uint32_t Tcp_socket::send(const std::vector<std::uint8_t>& data)
+    std::int32_t Tcp_socket::native_handle() const
     {
-#ifdef _WIN32
-        auto status = ::send(_sock, (char*)&data[0], data.size(), 0);
-#else
-        auto status = ::send(sock, (char*)&data[0], data.size(), MSG_NOSIGNAL);
-#endif
+        return sock;
+    }
 
-        if (status == -1) {
-            auto errorNumber = errno;
-            Log("Send error");
-            return errorNumber;
+
+    Tcp_socket::Connect_status Tcp_socket::connect_non_blocking()
+    {
+        if (!is_valid()) return Connect_status::failed;
+        if (!set_non_blocking(true)) return Connect_status::failed;
+
+        addr.sin_family = AF_INET;
+        addr.sin_port   = htons(port);
+        inet_pton(AF_INET, destination.to_string().c_str(), &addr.sin_addr);
+
+        if (::connect(sock, (sockaddr*)&addr, sizeof(addr)) == 0) {
+            return set_non_blocking(false) ? Connect_status::connected : Connect_status::failed;
         }
-        else {
-            return 0;
+        if (errno == EINPROGRESS) return Connect_status::in_progress;
+
+        Log("Failed to connect socket [" + std::to_string(sock) + "]");
+        return Connect_status::failed;
+    }
+
+
+    Tcp_socket::Connect_status Tcp_socket::connect_status()
+    {
+        if (!is_valid()) return Connect_status::failed;
+
+        pollfd pfd { sock, POLLOUT, 0 };
+        if (::poll(&pfd, 1, 0) == 0) return Connect_status::in_progress;
+
+        auto error        = 0;
+        socklen_t err_len = sizeof(error);
+        if (getsockopt(sock, SOL_SOCKET, SO_ERROR, &error, &err_len) == -1 || error != 0) {
+            return Connect_status::failed;
         }
+
+        return set_non_blocking(false) ? Connect_status::connected : Connect_status::failed;
     }
 
 
-    std::uint32_t Tcp_socket::send(std::vector<std::uint8_t>&& data)
+    bool Tcp_socket::set_non_blocking(bool non_blocking)
+    {
+        auto flags = fcntl(sock, F_GETFL, 0);
+        if (flags != -1) flags = non_blocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+
+        if (flags == -1 || fcntl(sock, F_SETFL, flags) == -1) {
+            Log("Failed to change O_NONBLOCK on socket [" + std::to_string(sock) + "]");
+            return false;
+        }
+        return true;
+    }
+
+
+    std::int32_t Tcp_socket::receive_some(std::uint8_t* buffer, std::size_t max_bytes)
+    {
+        auto status = ::recv(sock, (char*)buffer, max_bytes, MSG_DONTWAIT);
+
+        if (status > 0) return status;
+        if (status < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) return 0;
+        return -1;
+    }
+
+
+    bool Tcp_socket::listen(std::int32_t backlog)
+    {
+        if (!is_valid()) return false;
+
+        addr.sin_family      = AF_INET;
+        addr.sin_port        = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+        if (::bind(sock, (sockaddr*)&addr, sizeof(addr)) == -1 || ::listen(sock, backlog) == -1) {
+            Log("Failed to listen on port [" + std::to_string(port) + "] with socket [" + std::to_string(sock) + "]");
+            return false;
+        }
+        return true;
+    }
+
+
+    Owner_of<Tcp_socket> Tcp_socket::accept(std::int32_t timeout_ms)
+    {
+        if (!is_valid()) return nullptr;
+
+        pollfd pfd { sock, POLLIN, 0 };
+        if (::poll(&pfd, 1, timeout_ms) <= 0 || !(pfd.revents & POLLIN)) return nullptr;
+
+        sockaddr_in peer {};
+        socklen_t peer_len = sizeof(peer);
+        auto accepted      = ::accept(sock, (sockaddr*)&peer, &peer_len);
+        if (accepted == -1) return nullptr;
+
+        Utility::IP_address peer_address { ntohl(peer.sin_addr.s_addr) };
+        return Owner_of<Tcp_socket> { new Tcp_socket { accepted, peer_address, ntohs(peer.sin_port) } };
+    }
+
+
+    void Tcp_socket::set_no_delay()
     {
+        auto on = 1;
+        setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (const char*)&on, sizeof(on));
+    }
+
+
+    // A blocking send may still be partial, if interrupted or if the send
+    // timeout expires part way; the rest is sent until it fails.
+    //
+    std::uint32_t Tcp_socket::send(const std::vector<std::uint8_t>& data)
+    {
+        std::size_t sent = 0;
+
+        while (sent < data.size()) {
 #ifdef _WIN32
-        auto status = ::send(_sock, (char*)&data[0], data.size(), 0);
+            auto status = ::send(_sock, (char*)&data[sent], data.size() - sent, 0);
 #else
-        auto status = ::send(sock, (char*)&data[0], data.size(), MSG_NOSIGNAL);
+            auto status = ::send(sock, (char*)&data[sent], data.size() - sent, MSG_NOSIGNAL);
 #endif
 
-        if (status == -1) {
-            auto errorNumber = errno;
-            Log("Send error");
-            return errorNumber;
-        }
-        else {
-            return 0;
+            if (status == -1 && errno == EINTR) continue;
+            if (status <= 0) {
+                auto errorNumber = errno;
+                Log("Send error");
+                return (errorNumber != 0) ? errorNumber : EPIPE;
+            }
+            sent += status;
         }
+
+        return 0;
+    }
+
+
+    std::uint32_t Tcp_socket::send(std::vector<std::uint8_t>&& data)
+    {
+        return send(static_cast<const std::vector<std::uint8_t>&>(data));
     }
 
 
@@ -20,12 +20,14 @@
 #endif
 
 #include "../utility/ip_address.h"
+#include "../utility/pointer_types.h"
 
 namespace Navtech {
     class Tcp_socket {
     public:
         enum Close_option { do_not_shutdown, shutdown };
         enum Receive_option { consume, peek };
+        enum class Connect_status { connected, in_progress, failed };
 
         explicit Tcp_socket(const Utility::IP_address& destination, const std::uint16_t& port = 6317);
         ~Tcp_socket();
@@ -44,11 +46,35 @@ namespace Navtech {
                               Receive_option peek = consume);
         void set_send_timeout(std::uint32_t send_timeout);
 
+        // Non-blocking operation, for use from a caller's event loop.
+        // The socket is non-blocking only while the connect is in progress;
+        // once connected it is blocking again, so send() is unchanged.
+        // receive_some() returns the number of bytes read, 0 if no data is
+        // available, or -1 if the connection has failed.
+        //
+        std::int32_t native_handle() const;
+        Connect_status connect_non_blocking();
+        Connect_status connect_status();
+        std::int32_t receive_some(std::uint8_t* buffer, std::size_t max_bytes);
+
+        // Server operation. listen() binds to the port given to the
+        // constructor, on all interfaces. accept() waits up to timeout_ms
+        // for a connection and returns nullptr if there is none.
+        //
+        bool listen(std::int32_t backlog = 16);
+        Owner_of<Tcp_socket> accept(std::int32_t timeout_ms = 0);
+        const Utility::IP_address& address() const { return destination; }
+        void set_no_delay();
+
     private:
+        Tcp_socket(std::int32_t accepted, const Utility::IP_address& peer, std::uint16_t peer_port);
+
         std::atomic<std::int32_t> sock { -1 };
         Utility::IP_address destination { "192.168.0.1" };
         std::uint16_t port { 6317 };
         sockaddr_in addr {};
+
+        bool set_non_blocking(bool non_blocking);
     };
 
 } // namespace Navtech
@@ -0,0 +1,71 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "common.h"
+#include "network/colossus_relay.h"
+#include "utility/signal_handler.h"
+
+using namespace Navtech;
+using namespace Navtech::Utility;
+
+bool running { true };
+Signal_handler _signalHandler;
+
+void HandleSigInt(std::int32_t signal, std::int32_t info)
+{
+    switch (signal) {
+        case SIGINT:
+        case SIGTERM:
+            running = false;
+            break;
+        default:
+            break;
+    }
+}
+
+
+// Usage: colossusrelay [radar address] [listen port]
+//
+int main(int argc, char** argv)
+{
+    _signalHandler.RegisterHandler(SIGINT, &HandleSigInt);
+    _signalHandler.RegisterHandler(SIGTERM, &HandleSigInt);
+
+    IP_address radar_address { (argc > 1) ? argv[1] : "192.168.0.1" };
+    std::uint16_t listen_port = (argc > 2) ? static_cast<std::uint16_t>(std::stoi(argv[2])) : 6317;
+
+    Log("Colossus Relay Starting");
+
+    Colossus_relay relay { radar_address, 6317, listen_port };
+    if (!relay.open()) return EXIT_FAILURE;
+    relay.start();
+
+    auto last_report = std::chrono::steady_clock::now();
+
+    while (running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        if (std::chrono::steady_clock::now() - last_report < std::chrono::seconds(10)) continue;
+        last_report = std::chrono::steady_clock::now();
+
+        auto stats = relay.statistics();
+        Log("Colossus Relay - Clients [" + std::to_string(stats.clients) + "] Received [" +
+            std::to_string(stats.messages_received) + "] Dropped [" + std::to_string(stats.messages_dropped) +
+            "] Rejected [" + std::to_string(stats.commands_rejected) + "]");
+    }
+
+    Log("Colossus Relay Stopping");
+    relay.close();
+
+    _signalHandler.UnRegisterHandler(SIGINT);
+    _signalHandler.UnRegisterHandler(SIGTERM);
+
+    Log("Colossus Relay Stopped");
+}
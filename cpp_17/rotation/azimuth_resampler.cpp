@@ -0,0 +1,94 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include "azimuth_resampler.h"
+#include "row_kernels.h"
+
+namespace Navtech {
+
+    bool Azimuth_resampler::resample(const Rotation_frame& in, Rotation_frame& out)
+    {
+        if (in.azimuth_samples() != out.azimuth_samples() || in.range_in_bins() != out.range_in_bins()) return false;
+        if (in.encoder_size() == 0 || in.valid_azimuths() < 2) return false;
+
+        make_plan(in);
+        out.clear();
+
+        auto samples = in.azimuth_samples();
+        auto bins    = in.range_in_bins();
+
+        for (std::uint16_t i = 0; i < samples; ++i) {
+            auto& blend = plan[i];
+            if (!blend.valid) {
+                std::memset(out.row(i), 0, bins);
+                continue;
+            }
+
+            Row_kernels::blend(in.row(blend.first), in.row(blend.second), out.row(i), bins, blend.weight);
+
+            // Timestamps are taken from the nearer of the two azimuths
+            //
+            auto record       = in.record((blend.weight < 128) ? blend.first : blend.second);
+            record.azimuth    = static_cast<std::uint16_t>(static_cast<std::uint32_t>(i) * in.encoder_size() / samples);
+            record.continuity = Continuity {};
+            out.mark(i, record);
+        }
+
+        out.continuity(in.continuity());
+        out.rotation(in.rotation());
+        return true;
+    }
+
+
+    void Azimuth_resampler::make_plan(const Rotation_frame& in)
+    {
+        const std::int64_t samples = in.azimuth_samples();
+        const std::int64_t encoder = in.encoder_size();
+
+        sources.clear();
+        for (std::uint16_t i = 0; i < samples; ++i) {
+            if (in.is_valid(i)) sources.push_back(i);
+        }
+        plan.resize(samples);
+
+        // Positions are compared in units of (encoder / samples), so that
+        // grid points fall on integers even when the encoder size is not a
+        // multiple of the number of azimuth samples.
+        //
+        const std::int64_t count = sources.size();
+        auto position            = [&](std::int64_t k) -> std::int64_t {
+            return (in.record(sources[k]).azimuth % encoder) * samples;
+        };
+
+        std::int64_t k = -1;
+        for (std::int64_t i = 0; i < samples; ++i) {
+            auto grid = i * encoder;
+            while (k + 1 < count && position(k + 1) <= grid) ++k;
+
+            // The nearest source at or before the grid point, and the
+            // nearest source after it; either may be across the wrap.
+            //
+            auto before      = (k >= 0) ? k : count - 1;
+            auto after       = (k + 1 < count) ? k + 1 : 0;
+            auto before_pos  = position(before) - ((k >= 0) ? 0 : encoder * samples);
+            auto after_pos   = position(after) + ((k + 1 < count) ? 0 : encoder * samples);
+            auto span        = std::max<std::int64_t>(after_pos - before_pos, 1);
+            auto offset      = grid - before_pos;
+            auto weight      = std::min<std::int64_t>((offset * 256 + span / 2) / span, 256);
+            auto rows_missed = (sources[after] - sources[before] + samples - 1) % samples;
+
+            auto& blend  = plan[i];
+            blend.first  = sources[before];
+            blend.second = sources[after];
+            blend.weight = static_cast<std::uint16_t>(weight);
+            blend.valid  = (weight == 0) || (rows_missed <= gap_limit);
+        }
+    }
+
+} // namespace Navtech
@@ -0,0 +1,62 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef AZIMUTH_RESAMPLER_H
+#define AZIMUTH_RESAMPLER_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "rotation_frame.h"
+
+namespace Navtech {
+
+    // --------------------------------------------------------------------------------------------------
+    // Resamples a Rotation_frame onto a uniform angular grid. Output row n
+    // is the FFT data at exactly encoder position (n * encoder_size /
+    // azimuth_samples), interpolated linearly between the nearest received
+    // azimuths either side of it, using their actual encoder positions.
+    // Rows left empty by dropped packets, or by two packets landing on the
+    // same row, are filled from their neighbours.
+    //
+    // The interpolation weights are computed once per rotation, from the
+    // azimuth records, and then applied as vectorised row blends.
+    //
+    // Gaps wider than max_gap azimuths are not interpolated; those rows are
+    // left invalid and zeroed.
+    //
+    class Azimuth_resampler {
+    public:
+        Azimuth_resampler() = default;
+
+        void max_gap(std::uint16_t azimuths) { gap_limit = azimuths; }
+        std::uint16_t max_gap() const { return gap_limit; }
+
+        // in and out must have the same dimensions. Returns false, leaving
+        // out unchanged, if in has fewer than two valid rows.
+        //
+        bool resample(const Rotation_frame& in, Rotation_frame& out);
+
+    private:
+        struct Blend
+        {
+            std::uint16_t first;
+            std::uint16_t second;
+            std::uint16_t weight;
+            bool valid;
+        };
+
+        std::uint16_t gap_limit { std::numeric_limits<std::uint16_t>::max() };
+        std::vector<std::uint16_t> sources {};
+        std::vector<Blend> plan {};
+
+        void make_plan(const Rotation_frame& in);
+    };
+
+} // namespace Navtech
+
+#endif // AZIMUTH_RESAMPLER_H
@@ -0,0 +1,160 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <algorithm>
+#include <cmath>
+
+#include "clock_offset_estimator.h"
+
+namespace Navtech {
+
+    Clock_offset_estimator::Clock_offset_estimator(std::chrono::nanoseconds window,
+                                                   std::size_t history,
+                                                   std::chrono::nanoseconds step_threshold) :
+        window_length { window },
+        step          { step_threshold.count() },
+        minima        (std::max<std::size_t>(history, 2))
+    {
+    }
+
+
+    void Clock_offset_estimator::reset()
+    {
+        window_open   = false;
+        message_count = 0;
+        minima_count  = 0;
+        oldest        = 0;
+
+        std::lock_guard lock { estimate_mutex };
+        current = Clock_offset_estimate {};
+    }
+
+
+    bool Clock_offset_estimator::add(Radar_time radar_time, Radar_time receive_time)
+    {
+        ++message_count;
+        auto delay = (receive_time - radar_time).count();
+
+        if (!window_open) {
+            window_open    = true;
+            window_start   = receive_time;
+            window_minimum = { receive_time, delay };
+            delay_base     = delay;
+            delay_sum      = 0;
+            delay_max      = delay;
+            delay_count    = 0;
+        }
+
+        if (delay < window_minimum.delay) window_minimum = { receive_time, delay };
+        delay_max = std::max(delay_max, delay);
+        delay_sum += delay - delay_base;
+        ++delay_count;
+
+        if (receive_time - window_start < window_length) return false;
+
+        close_window();
+        window_open = false;
+        return true;
+    }
+
+
+    Clock_offset_estimate Clock_offset_estimator::estimate() const
+    {
+        std::lock_guard lock { estimate_mutex };
+        return current;
+    }
+
+
+    std::chrono::nanoseconds Clock_offset_estimator::latency(Radar_time radar_time, Radar_time receive_time) const
+    {
+        std::lock_guard lock { estimate_mutex };
+        if (!current.valid) return std::chrono::nanoseconds { 0 };
+
+        return std::chrono::nanoseconds { (receive_time - radar_time).count() - offset_at(receive_time) };
+    }
+
+
+    void Clock_offset_estimator::close_window()
+    {
+        // A minimum well away from the line means one of the clocks has
+        // been stepped; the old minima no longer apply.
+        //
+        if (minima_count > 0 && std::abs(window_minimum.delay - offset_at(window_minimum.receive_time)) > step) {
+            minima_count = 0;
+            oldest       = 0;
+        }
+
+        if (minima_count < minima.size()) {
+            minima[(oldest + minima_count) % minima.size()] = window_minimum;
+            ++minima_count;
+        }
+        else {
+            minima[oldest] = window_minimum;
+            oldest         = (oldest + 1) % minima.size();
+        }
+
+        fit();
+    }
+
+
+    // Least-squares line through the window minima, relative to the
+    // newest so that the sums stay small enough for doubles.
+    //
+    void Clock_offset_estimator::fit()
+    {
+        auto& newest = minima[(oldest + minima_count - 1) % minima.size()];
+
+        double slope     = 0.0;
+        double intercept = 0.0;
+
+        if (minima_count > 1) {
+            double sum_x  = 0.0;
+            double sum_y  = 0.0;
+            double sum_xx = 0.0;
+            double sum_xy = 0.0;
+
+            for (std::size_t i = 0; i < minima_count; ++i) {
+                auto& minimum = minima[(oldest + i) % minima.size()];
+                auto x        = std::chrono::duration<double>(minimum.receive_time - newest.receive_time).count();
+                auto y        = static_cast<double>(minimum.delay - newest.delay);
+
+                sum_x += x;
+                sum_y += y;
+                sum_xx += x * x;
+                sum_xy += x * y;
+            }
+
+            auto n           = static_cast<double>(minima_count);
+            auto denominator = n * sum_xx - sum_x * sum_x;
+            if (denominator > 0.0) slope = (n * sum_xy - sum_x * sum_y) / denominator;
+            intercept = (sum_y - slope * sum_x) / n;
+        }
+
+        auto offset = newest.delay + static_cast<std::int64_t>(std::llround(intercept));
+        auto mean   = (delay_count > 0) ? delay_base + delay_sum / delay_count : offset;
+
+        std::lock_guard lock { estimate_mutex };
+        reference_time       = newest.receive_time;
+        current.valid        = true;
+        current.offset       = std::chrono::nanoseconds { offset };
+        current.drift        = slope / 1000.0;
+        current.mean_latency = std::chrono::nanoseconds { mean - offset };
+        current.max_latency  = std::chrono::nanoseconds { delay_max - offset };
+        current.messages     = message_count;
+        current.windows      = static_cast<std::uint16_t>(minima_count);
+    }
+
+
+    // Offset on the fitted line at receive_time. drift is in parts per
+    // million, so drift * 1000 is nanoseconds per second.
+    //
+    std::int64_t Clock_offset_estimator::offset_at(Radar_time receive_time) const
+    {
+        auto elapsed = std::chrono::duration<double>(receive_time - reference_time).count();
+        return current.offset.count() + static_cast<std::int64_t>(std::llround(current.drift * 1000.0 * elapsed));
+    }
+
+} // namespace Navtech
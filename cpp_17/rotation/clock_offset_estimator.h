@@ -0,0 +1,121 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef CLOCK_OFFSET_ESTIMATOR_H
+#define CLOCK_OFFSET_ESTIMATOR_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "timestamp_normaliser.h"
+
+namespace Navtech {
+
+    // - offset is host time minus radar time, including the smallest
+    //   one-way latency seen; the two cannot be separated from one-way
+    //   traffic alone.
+    // - drift is the rate at which offset is changing, in parts per
+    //   million (positive if the host clock runs fast).
+    // - Latencies are relative to offset: each message's delay beyond the
+    //   fastest message, over the last window.
+    //
+    struct Clock_offset_estimate
+    {
+        bool valid { false };
+        std::chrono::nanoseconds offset { 0 };
+        double drift { 0.0 };
+        std::chrono::nanoseconds mean_latency { 0 };
+        std::chrono::nanoseconds max_latency { 0 };
+        std::uint64_t messages { 0 };
+        std::uint16_t windows { 0 };
+    };
+
+
+    // --------------------------------------------------------------------------------------------------
+    // Estimates the offset and drift between the radar's clock and the
+    // host's from the radar timestamp and host receive time of each
+    // message.
+    //
+    // Each message's delay (receive time - radar time) is the clock offset
+    // plus its latency. add() keeps only the minimum delay over each
+    // window, which is the message least held up by the network. When a
+    // window closes, a straight line fitted through the recent minima gives
+    // the offset and drift. A minimum further than step_threshold from
+    // that line, such as after either clock is stepped, restarts the fit.
+    //
+    // add() is a few integer operations except when a window closes, and
+    // must be called from a single thread. estimate() and latency() may be
+    // called from any thread.
+    //
+    class Clock_offset_estimator {
+    public:
+        explicit Clock_offset_estimator(std::chrono::nanoseconds window         = std::chrono::seconds { 1 },
+                                        std::size_t history                     = 32,
+                                        std::chrono::nanoseconds step_threshold = std::chrono::milliseconds { 20 });
+
+        Clock_offset_estimator(const Clock_offset_estimator&) = delete;
+        Clock_offset_estimator& operator=(const Clock_offset_estimator&) = delete;
+
+        void reset();
+
+        // Returns true if this message closed a window, and so updated
+        // the estimate.
+        //
+        bool add(Radar_time radar_time, Radar_time receive_time);
+
+        Clock_offset_estimate estimate() const;
+
+        // The latency of a single message, relative to the fastest
+        //
+        std::chrono::nanoseconds latency(Radar_time radar_time, Radar_time receive_time) const;
+
+    private:
+        struct Window_minimum
+        {
+            Radar_time receive_time {};
+            std::int64_t delay { 0 };
+        };
+
+        std::chrono::nanoseconds window_length;
+        std::int64_t step;
+
+        // Window being accumulated
+        //
+        bool window_open { false };
+        Radar_time window_start {};
+        Window_minimum window_minimum {};
+
+        // Delays are summed relative to the window's first, as an unset
+        // radar clock can put them decades from zero.
+        //
+        std::int64_t delay_base { 0 };
+        std::int64_t delay_sum { 0 };
+        std::int64_t delay_max { 0 };
+        std::uint32_t delay_count { 0 };
+        std::uint64_t message_count { 0 };
+
+        // Ring of the most recent window minima
+        //
+        std::vector<Window_minimum> minima;
+        std::size_t oldest { 0 };
+        std::size_t minima_count { 0 };
+
+        // The fitted line passes through current.offset at reference_time
+        //
+        mutable std::mutex estimate_mutex;
+        Clock_offset_estimate current {};
+        Radar_time reference_time {};
+
+        void close_window();
+        void fit();
+        std::int64_t offset_at(Radar_time receive_time) const;
+    };
+
+} // namespace Navtech
+
+#endif // CLOCK_OFFSET_ESTIMATOR_H
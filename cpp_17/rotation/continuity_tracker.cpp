@@ -0,0 +1,134 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include "continuity_tracker.h"
+
+namespace Navtech {
+
+    void Continuity_tracker::configure(std::uint16_t encoder_size, std::uint16_t azimuth_samples, bool staring_mode)
+    {
+        encoder = encoder_size;
+        samples = azimuth_samples;
+        staring = staring_mode;
+        reset();
+    }
+
+
+    void Continuity_tracker::reset()
+    {
+        first = true;
+        received.store(0, std::memory_order_relaxed);
+        missing.store(0, std::memory_order_relaxed);
+        duplicated.store(0, std::memory_order_relaxed);
+        gap_count.store(0, std::memory_order_relaxed);
+        sweep_jumps.store(0, std::memory_order_relaxed);
+    }
+
+
+    Continuity Continuity_tracker::check(std::uint16_t azimuth, std::uint16_t sweep_counter)
+    {
+        if (staring) return check_sweep(sweep_counter);
+
+        auto was_first = first;
+        auto result    = check_azimuth(azimuth);
+
+        auto sweep_step = static_cast<std::uint16_t>(sweep_counter - last_sweep);
+        last_sweep      = sweep_counter;
+        if (was_first || result.duplicate || sweep_step == 1) return result;
+
+        result.sweep_discontinuity = true;
+        increment(sweep_jumps);
+        return result;
+    }
+
+
+    Continuity Continuity_tracker::check(std::uint16_t azimuth)
+    {
+        if (staring) {
+            increment(received);
+            return Continuity {};
+        }
+        return check_azimuth(azimuth);
+    }
+
+
+    Continuity Continuity_tracker::check_sweep(std::uint16_t sweep_counter)
+    {
+        Continuity result {};
+        increment(received);
+
+        if (first) {
+            first      = false;
+            last_sweep = sweep_counter;
+            return result;
+        }
+
+        auto step  = static_cast<std::uint16_t>(sweep_counter - last_sweep);
+        last_sweep = sweep_counter;
+
+        if (step == 0) {
+            result.duplicate = true;
+            increment(duplicated);
+            return result;
+        }
+        if (step == 1) return result;
+
+        result.missing_before = static_cast<std::uint16_t>(step - 1);
+        increment(missing, step - 1u);
+        increment(gap_count);
+        return result;
+    }
+
+
+    Continuity Continuity_tracker::check_azimuth(std::uint16_t azimuth)
+    {
+        Continuity result {};
+        increment(received);
+        if (encoder == 0 || samples == 0) return result;
+
+        auto index = (static_cast<std::uint32_t>(azimuth) % encoder) * samples / encoder;
+
+        if (first) {
+            first      = false;
+            last_index = index;
+            return result;
+        }
+
+        if (index == last_index) {
+            result.duplicate = true;
+            increment(duplicated);
+            return result;
+        }
+
+        auto step  = (index + samples - last_index) % samples;
+        last_index = index;
+        if (step == 1) return result;
+
+        result.missing_before = static_cast<std::uint16_t>(step - 1);
+        increment(missing, step - 1);
+        increment(gap_count);
+        return result;
+    }
+
+
+    Continuity_counters Continuity_tracker::counters() const
+    {
+        Continuity_counters result {};
+        result.azimuths_received     = received.load(std::memory_order_relaxed);
+        result.azimuths_missing      = missing.load(std::memory_order_relaxed);
+        result.azimuths_duplicated   = duplicated.load(std::memory_order_relaxed);
+        result.gaps                  = gap_count.load(std::memory_order_relaxed);
+        result.sweep_discontinuities = sweep_jumps.load(std::memory_order_relaxed);
+        return result;
+    }
+
+
+    void Continuity_tracker::increment(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+} // namespace Navtech
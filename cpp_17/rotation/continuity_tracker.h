@@ -0,0 +1,98 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef CONTINUITY_TRACKER_H
+#define CONTINUITY_TRACKER_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace Navtech {
+
+    // The continuity of a single azimuth, relative to the one before it.
+    // - missing_before is the number of azimuth samples skipped between
+    //   the previous azimuth and this one.
+    // - duplicate is set if the azimuth repeats the previous one.
+    // - sweep_discontinuity is set if the sweep counter did not advance
+    //   by exactly one.
+    //
+    struct Continuity
+    {
+        std::uint16_t missing_before { 0 };
+        bool duplicate { false };
+        bool sweep_discontinuity { false };
+
+        bool is_continuous() const { return missing_before == 0 && !duplicate && !sweep_discontinuity; }
+    };
+
+
+    struct Continuity_counters
+    {
+        std::uint64_t azimuths_received { 0 };
+        std::uint64_t azimuths_missing { 0 };
+        std::uint64_t azimuths_duplicated { 0 };
+        std::uint64_t gaps { 0 };
+        std::uint64_t sweep_discontinuities { 0 };
+    };
+
+
+    // --------------------------------------------------------------------------------------------------
+    // Checks each azimuth of a stream against the previous one. check() is
+    // a handful of integer operations and never blocks; it must be called
+    // from a single thread. counters() may be called from any thread.
+    //
+    // configure() and reset() start a new stream: the next azimuth is not
+    // checked against the last one and the counters return to zero. Like
+    // check(), they must be called from the checking thread.
+    //
+    // Streams without a sweep counter (for example, navigation data) use
+    // the single-argument check().
+    //
+    // A staring radar repeats the same azimuth, so in staring mode only the
+    // sweep counter is checked: a repeated counter is a duplicate and a
+    // jump in the counter is a gap.
+    //
+    class Continuity_tracker {
+    public:
+        Continuity_tracker() = default;
+
+        Continuity_tracker(const Continuity_tracker&) = delete;
+        Continuity_tracker& operator=(const Continuity_tracker&) = delete;
+
+        void configure(std::uint16_t encoder_size, std::uint16_t azimuth_samples, bool staring_mode = false);
+        void reset();
+
+        Continuity check(std::uint16_t azimuth, std::uint16_t sweep_counter);
+        Continuity check(std::uint16_t azimuth);
+
+        Continuity_counters counters() const;
+
+    private:
+        std::uint32_t encoder { 0 };
+        std::uint32_t samples { 0 };
+        bool staring { false };
+
+        bool first { true };
+        std::uint32_t last_index { 0 };
+        std::uint16_t last_sweep { 0 };
+
+        // Only ever written by the checking thread, so updated with a
+        // plain load and store rather than a locked read-modify-write.
+        //
+        std::atomic<std::uint64_t> received { 0 };
+        std::atomic<std::uint64_t> missing { 0 };
+        std::atomic<std::uint64_t> duplicated { 0 };
+        std::atomic<std::uint64_t> gap_count { 0 };
+        std::atomic<std::uint64_t> sweep_jumps { 0 };
+
+        Continuity check_azimuth(std::uint16_t azimuth);
+        Continuity check_sweep(std::uint16_t sweep_counter);
+        static void increment(std::atomic<std::uint64_t>& counter, std::uint64_t value = 1);
+    };
+
+} // namespace Navtech
+
+#endif // CONTINUITY_TRACKER_H
@@ -0,0 +1,83 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <algorithm>
+#include <cmath>
+
+#include "contour_table.h"
+#include "row_kernels.h"
+
+namespace Navtech {
+
+    Contour_table::Contour_table(const std::vector<std::uint8_t>& contour_data,
+                                 double bin_size,
+                                 std::uint16_t azimuth_samples)
+    {
+        compile(contour_data, bin_size, azimuth_samples);
+    }
+
+
+    bool Contour_table::compile(const std::vector<std::uint8_t>& contour_data,
+                                double bin_size,
+                                std::uint16_t azimuth_samples)
+    {
+        clear();
+        if (contour_data.size() != contour_size || bin_size <= 0.0 || azimuth_samples == 0) return false;
+
+        bins_to_keep.resize(azimuth_samples);
+
+        // Azimuth index n is at (n * 360 / azimuth_samples) degrees, and
+        // takes the range for the whole degree it falls in
+        //
+        for (std::uint32_t azimuth = 0; azimuth < azimuth_samples; ++azimuth) {
+            auto degree = (azimuth * 360u) / azimuth_samples;
+            auto metres = (contour_data[degree * 2] << 8) | contour_data[degree * 2 + 1];
+            auto bins   = std::ceil(metres / bin_size);
+
+            bins_to_keep[azimuth] = static_cast<std::uint16_t>(std::min(bins, 65535.0));
+        }
+        return true;
+    }
+
+
+    void Contour_table::clear()
+    {
+        bins_to_keep.clear();
+    }
+
+
+    void Contour_table::apply(Rotation_frame& frame) const
+    {
+        if (empty() || frame.azimuth_samples() != azimuth_samples()) return;
+
+        for (std::uint16_t azimuth = 0; azimuth < frame.azimuth_samples(); ++azimuth) {
+            Row_kernels::clip(frame.row(azimuth), frame.range_in_bins(), bins_to_keep_at(azimuth, frame.first_bin()));
+        }
+    }
+
+
+    void Contour_table::apply(const Rotation_frame& in, Rotation_frame& out) const
+    {
+        // Rows are zero-padded past the data written, so only the bins
+        // inside the contour are copied
+        //
+        for (std::uint16_t azimuth = 0; azimuth < in.azimuth_samples(); ++azimuth) {
+            if (!in.is_valid(azimuth)) continue;
+
+            std::size_t keep = in.range_in_bins();
+            if (!empty() && in.azimuth_samples() == azimuth_samples()) {
+                keep = std::min<std::size_t>(keep, bins_to_keep_at(azimuth, in.first_bin()));
+            }
+            out.write(azimuth, in.record(azimuth), in.row(azimuth), keep);
+        }
+
+        out.blank_missing();
+        out.first_bin(in.first_bin());
+        out.rotation(in.rotation());
+        out.continuity(in.continuity());
+    }
+
+} // namespace Navtech
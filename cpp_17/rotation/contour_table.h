@@ -0,0 +1,73 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef CONTOUR_TABLE_H
+#define CONTOUR_TABLE_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "rotation_frame.h"
+
+namespace Navtech {
+
+    // --------------------------------------------------------------------------------------------------
+    // A range contour compiled to the number of bins to keep at each
+    // azimuth index.
+    //
+    // The contour is in the format sent to the radar by
+    // Radar_client::update_contour_map(): 360 big-endian 16-bit ranges, in
+    // metres, one per degree. Each azimuth keeps the bins below
+    // ceil(range / bin_size), as the radar does.
+    //
+    // An empty table clips nothing.
+    //
+    class Contour_table {
+    public:
+        Contour_table() = default;
+        Contour_table(const std::vector<std::uint8_t>& contour_data, double bin_size, std::uint16_t azimuth_samples);
+
+        static constexpr std::size_t contour_size { 720 };
+
+        // Returns false, and leaves the table empty, if contour_data is not
+        // contour_size bytes or bin_size is not positive.
+        //
+        bool compile(const std::vector<std::uint8_t>& contour_data, double bin_size, std::uint16_t azimuth_samples);
+        void clear();
+
+        bool empty() const { return bins_to_keep.empty(); }
+        std::uint16_t azimuth_samples() const { return static_cast<std::uint16_t>(bins_to_keep.size()); }
+
+        // The number of bins to keep at azimuth_index, counting from
+        // first_bin for rows that start part way out
+        //
+        std::uint16_t bins_to_keep_at(std::uint16_t azimuth_index, std::uint16_t first_bin = 0) const
+        {
+            if (azimuth_index >= bins_to_keep.size()) return std::numeric_limits<std::uint16_t>::max();
+
+            auto limit = bins_to_keep[azimuth_index];
+            return (limit > first_bin) ? static_cast<std::uint16_t>(limit - first_bin) : 0;
+        }
+
+        // Zero every bin beyond the contour, in place. The frame must not be
+        // shared with other consumers; see Rotation_frame_handle::unique().
+        // Frames with a different number of azimuths are left unchanged.
+        //
+        void apply(Rotation_frame& frame) const;
+
+        // Copy in to out, which must have the same dimensions, zeroing every
+        // bin beyond the contour
+        //
+        void apply(const Rotation_frame& in, Rotation_frame& out) const;
+
+    private:
+        std::vector<std::uint16_t> bins_to_keep {};
+    };
+
+} // namespace Navtech
+
+#endif // CONTOUR_TABLE_H
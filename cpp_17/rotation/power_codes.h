@@ -0,0 +1,76 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef POWER_CODES_H
+#define POWER_CODES_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// --------------------------------------------------------------------------------------------------
+// Conversions between the radar's half-dB sample codes and linear power,
+// 10^(code / 20), for integrating samples in power.
+//
+namespace Navtech::Power_codes {
+
+    // The linear power of each of the 256 half-dB codes
+    //
+    inline const std::array<double, 256> linear_powers = [] {
+        std::array<double, 256> powers {};
+        for (std::size_t code = 0; code < powers.size(); ++code) {
+            powers[code] = std::pow(10.0, code / 20.0);
+        }
+        return powers;
+    }();
+
+
+    inline double linear_power(std::uint8_t sample)
+    {
+        return linear_powers[sample];
+    }
+
+
+    // 20 log10(power), from the binary exponent and an odd series for
+    // the log of the mantissa, accurate to 2e-10 half-dB. power must be
+    // a positive, normal double; the mean power of any samples is at
+    // least 1.
+    //
+    inline double half_db(double power)
+    {
+        constexpr double sqrt_2       = 1.4142135623730951;
+        constexpr double ln_2         = 0.6931471805599453;
+        constexpr double half_db_ln   = 8.685889638065037; // 20 / ln(10)
+        constexpr std::uint64_t ones  = 0x3ff0000000000000;
+        constexpr std::uint64_t field = 0x000fffffffffffff;
+
+        std::uint64_t bits {};
+        std::memcpy(&bits, &power, sizeof bits);
+        auto exponent = static_cast<int>((bits >> 52) & 0x7ff) - 1023;
+
+        // Mantissa in [1, 2), then [sqrt(1/2), sqrt(2)), where the
+        // series converges fastest
+        //
+        bits = (bits & field) | ones;
+        double mantissa {};
+        std::memcpy(&mantissa, &bits, sizeof mantissa);
+        auto high = (mantissa > sqrt_2);
+        mantissa  = high ? mantissa * 0.5 : mantissa;
+        exponent += high;
+
+        // ln(m) = 2 atanh(s), s = (m - 1) / (m + 1); |s| < 0.172
+        //
+        auto s  = (mantissa - 1.0) / (mantissa + 1.0);
+        auto s2 = s * s;
+        auto ln = 2.0 * s * (1.0 + s2 * (1.0 / 3 + s2 * (1.0 / 5 + s2 * (1.0 / 7 + s2 * (1.0 / 9 + s2 / 11)))));
+
+        return half_db_ln * (ln + exponent * ln_2);
+    }
+
+} // namespace Navtech::Power_codes
+
+#endif // POWER_CODES_H
@@ -0,0 +1,34 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include "range_table.h"
+
+namespace Navtech {
+
+    Range_table::Range_table(std::uint16_t range_in_bins, double bin_size, float gain, float offset) :
+        ranges       (range_in_bins),
+        size_of_bin  { bin_size },
+        range_gain   { gain },
+        range_offset { offset }
+    {
+        // Calculated in double precision, as Peak_finder does, so that
+        // whole-bin peaks get exactly the table's range
+        //
+        for (std::uint16_t bin = 0; bin < range_in_bins; ++bin) {
+            ranges[bin] = static_cast<float>(fractional_range(bin));
+        }
+    }
+
+
+    double Range_table::bin_at(double range) const
+    {
+        auto metres_per_bin = range_gain * size_of_bin;
+        if (metres_per_bin == 0.0) return 0.0;
+
+        return (range - range_offset) / metres_per_bin;
+    }
+
+} // namespace Navtech
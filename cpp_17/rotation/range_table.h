@@ -0,0 +1,73 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef RANGE_TABLE_H
+#define RANGE_TABLE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../utility/pointer_types.h"
+
+namespace Navtech {
+
+    // --------------------------------------------------------------------------------------------------
+    // The range, in metres, of every bin of an FFT, with the radar's range
+    // gain and offset applied:
+    //
+    //     range = (bin * gain * bin_size) + offset
+    //
+    // The table is built once per configuration and never changed, so a
+    // Pointer to it can be handed to any thread. A new configuration
+    // produces a new table; consumers holding the old one are unaffected.
+    //
+    class Range_table {
+    public:
+        using Pointer = Shared_owner<const Range_table>;
+
+        Range_table() = default;
+        Range_table(std::uint16_t range_in_bins, double bin_size, float gain = 1.0f, float offset = 0.0f);
+
+        bool empty() const { return ranges.empty(); }
+        std::uint16_t range_in_bins() const { return static_cast<std::uint16_t>(ranges.size()); }
+        double bin_size() const { return size_of_bin; }
+        float gain() const { return range_gain; }
+        float offset() const { return range_offset; }
+
+        // Bins beyond the end of the table are calculated rather than
+        // looked up
+        //
+        float range(std::uint16_t bin) const
+        {
+            if (bin < ranges.size()) return ranges[bin];
+            return static_cast<float>(fractional_range(bin));
+        }
+
+        // For peaks resolved to a fraction of a bin
+        //
+        double fractional_range(double bin) const { return (bin * range_gain * size_of_bin) + range_offset; }
+
+        // The (fractional) bin at range; the inverse of fractional_range().
+        // Returns 0 if the gain or bin size is zero, as it is for an empty
+        // table.
+        //
+        double bin_at(double range) const;
+
+        // The ranges of consecutive bins, from first_bin, for converting a
+        // whole row at once. There are range_in_bins() - first_bin of them.
+        //
+        const float* row(std::uint16_t first_bin = 0) const { return ranges.data() + first_bin; }
+
+    private:
+        std::vector<float> ranges {};
+        double size_of_bin { 0.0 };
+        float range_gain { 1.0f };
+        float range_offset { 0.0f };
+    };
+
+} // namespace Navtech
+
+#endif // RANGE_TABLE_H
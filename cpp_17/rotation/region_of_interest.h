@@ -0,0 +1,64 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef REGION_OF_INTEREST_H
+#define REGION_OF_INTEREST_H
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Navtech {
+
+    // An azimuth sector and range window, in azimuth indices (0 to
+    // azimuth_samples - 1) and bins.
+    // - The sector runs from start_azimuth up to, but not including,
+    //   end_azimuth, and may wrap through zero. If start_azimuth equals
+    //   end_azimuth the sector is the whole rotation.
+    // - The window runs from start_bin up to, but not including, end_bin.
+    //   An end_bin of zero means the last bin.
+    // The default region is everything.
+    //
+    struct Region_of_interest
+    {
+        std::uint16_t start_azimuth { 0 };
+        std::uint16_t end_azimuth { 0 };
+        std::uint16_t start_bin { 0 };
+        std::uint16_t end_bin { 0 };
+
+        bool is_whole_rotation() const { return start_azimuth == end_azimuth; }
+
+        bool contains_azimuth(std::uint16_t azimuth_index) const
+        {
+            if (is_whole_rotation()) return true;
+            if (start_azimuth < end_azimuth) return azimuth_index >= start_azimuth && azimuth_index < end_azimuth;
+            return azimuth_index >= start_azimuth || azimuth_index < end_azimuth;
+        }
+
+        std::uint16_t first_bin(std::uint16_t range_in_bins) const { return std::min(start_bin, range_in_bins); }
+
+        std::uint16_t last_bin(std::uint16_t range_in_bins) const
+        {
+            if (end_bin == 0 || end_bin > range_in_bins) return range_in_bins;
+            return std::max(end_bin, first_bin(range_in_bins));
+        }
+
+        std::uint16_t bins(std::uint16_t range_in_bins) const
+        {
+            return last_bin(range_in_bins) - first_bin(range_in_bins);
+        }
+
+        bool operator==(const Region_of_interest& other) const
+        {
+            return start_azimuth == other.start_azimuth && end_azimuth == other.end_azimuth &&
+                   start_bin == other.start_bin && end_bin == other.end_bin;
+        }
+
+        bool operator!=(const Region_of_interest& other) const { return !(*this == other); }
+    };
+
+} // namespace Navtech
+
+#endif // REGION_OF_INTEREST_H
@@ -0,0 +1,321 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <algorithm>
+#include <cmath>
+
+#include "../common.h"
+#include "rotation_assembler.h"
+
+namespace Navtech {
+
+    void Rotation_assembler::set_pool_size(std::size_t frame_count, Page_size page_size)
+    {
+        pool_size      = std::max<std::size_t>(frame_count, 2);
+        pool_page_size = page_size;
+    }
+
+
+    void Rotation_assembler::set_resampling(bool enable, std::uint16_t max_gap)
+    {
+        resampling_max_gap = max_gap;
+        resampling         = enable;
+    }
+
+
+    void Rotation_assembler::set_history_depth(std::size_t rotations)
+    {
+        std::lock_guard lock { callback_mutex };
+        history_depth = rotations;
+        update_callback_set();
+    }
+
+
+    void Rotation_assembler::configure(std::uint16_t azimuth_samples,
+                                       std::uint16_t range_in_bins,
+                                       std::uint16_t encoder_size,
+                                       const Region_of_interest& roi)
+    {
+        auto bins      = roi.bins(range_in_bins);
+        auto retention = history_depth.load();
+
+        if (filling && filling->azimuth_samples() == azimuth_samples && filling->range_in_bins() == bins &&
+            filling->encoder_size() == encoder_size && region == roi && rotation_history.depth() == retention) {
+            return;
+        }
+
+        region    = roi;
+        first_bin = roi.first_bin(range_in_bins);
+
+        // Rotations start at the end of the sector, so that each frame
+        // holds one contiguous sector and completes as soon as the sector
+        // has passed.
+        //
+        origin = roi.is_whole_rotation() ? 0 : (roi.end_azimuth % std::max<std::uint16_t>(azimuth_samples, 1));
+
+        filling.reset();
+        rotation_history.set_depth(retention);
+        pool    = allocate_owned<Rotation_frame_pool>(
+            pool_size + retention, azimuth_samples, bins, encoder_size, pool_page_size);
+        filling = acquire_frame();
+
+        Log("Rotation_assembler - Frame pool [" + std::to_string(pool->capacity()) + "] frames" +
+            (pool->uses_huge_pages() ? " (huge pages)" : ""));
+
+        reset();
+    }
+
+
+    void Rotation_assembler::reset()
+    {
+        if (filling) filling.writable().clear();
+        last_position = -1;
+        synchronised  = false;
+    }
+
+
+    void Rotation_assembler::set_rotation_callback(std::function<void(const Rotation_frame_handle&)> fn)
+    {
+        std::lock_guard lock { callback_mutex };
+        rotation_callback = std::move(fn);
+        update_callback_set();
+    }
+
+
+    void Rotation_assembler::set_sector_callback(std::function<void(const Rotation_sector&)> fn,
+                                                 std::uint16_t azimuths_per_sector)
+    {
+        std::lock_guard lock { callback_mutex };
+        sector_callback = std::move(fn);
+        sector_azimuths = azimuths_per_sector;
+        sector_degrees  = 0.0f;
+        update_callback_set();
+    }
+
+
+    void Rotation_assembler::set_sector_callback_degrees(std::function<void(const Rotation_sector&)> fn,
+                                                         float degrees_per_sector)
+    {
+        std::lock_guard lock { callback_mutex };
+        sector_callback = std::move(fn);
+        sector_azimuths = 0;
+        sector_degrees  = degrees_per_sector;
+        update_callback_set();
+    }
+
+
+    Rotation_subscriber_id Rotation_assembler::add_subscriber(const Reduction_profile& profile,
+                                                              std::function<void(const Rotation_frame_handle&)> fn)
+    {
+        std::lock_guard lock { callback_mutex };
+
+        auto id = next_subscriber_id++;
+        subscribers.push_back(Subscriber { id, profile, std::move(fn) });
+
+        auto shared = std::any_of(reducers.begin(), reducers.end(), [&profile](auto& reducer) {
+            return reducer->profile() == profile;
+        });
+        if (!profile.is_full_resolution() && !shared) reducers.push_back(allocate_owned<Rotation_reducer>(profile));
+
+        update_callback_set();
+        return id;
+    }
+
+
+    void Rotation_assembler::remove_subscriber(Rotation_subscriber_id id)
+    {
+        std::lock_guard lock { callback_mutex };
+
+        subscribers.erase(std::remove_if(subscribers.begin(),
+                                         subscribers.end(),
+                                         [id](auto& subscriber) { return subscriber.id == id; }),
+                          subscribers.end());
+
+        reducers.erase(std::remove_if(reducers.begin(),
+                                      reducers.end(),
+                                      [this](auto& reducer) {
+                                          return std::none_of(
+                                              subscribers.begin(), subscribers.end(), [&reducer](auto& subscriber) {
+                                                  return subscriber.profile == reducer->profile();
+                                              });
+                                      }),
+                       reducers.end());
+
+        update_callback_set();
+    }
+
+
+    void Rotation_assembler::update_callback_set()
+    {
+        callback_set = (rotation_callback != nullptr) || (sector_callback != nullptr) || !subscribers.empty() ||
+                       history_depth > 0;
+    }
+
+
+    void Rotation_assembler::add(const Azimuth_record& record, const std::uint8_t* data, std::size_t size)
+    {
+        auto index = advance(record.azimuth);
+        if (index < 0) return;
+
+        filling.writable().write(static_cast<std::uint16_t>(index), record, data, size);
+    }
+
+
+    void Rotation_assembler::skip(std::uint16_t azimuth)
+    {
+        advance(azimuth);
+    }
+
+
+    std::int32_t Rotation_assembler::advance(std::uint16_t azimuth)
+    {
+        if (!filling || filling->encoder_size() == 0 || filling->azimuth_samples() == 0) return -1;
+
+        auto samples  = filling->azimuth_samples();
+        auto encoder  = filling->encoder_size();
+        auto index    = static_cast<std::int32_t>((azimuth % encoder) * samples / encoder);
+        auto position = (index + samples - origin) % samples;
+
+        std::int32_t sector_azimuths = sector_size();
+
+        if (position < last_position) {
+            if (synchronised) {
+                if (sector_azimuths > 0) complete_sectors((samples + sector_azimuths - 1) / sector_azimuths, true);
+                complete_rotation();
+            }
+            else {
+                filling.writable().clear();
+                synchronised = true;
+            }
+            current_sector = 0;
+        }
+        last_position = position;
+
+        if (synchronised && sector_azimuths > 0 && position / sector_azimuths > current_sector) {
+            complete_sectors(position / sector_azimuths, false);
+        }
+
+        return index;
+    }
+
+
+    Rotation_frame_handle Rotation_assembler::acquire_frame()
+    {
+        auto frame = pool->acquire();
+        if (!frame) return frame;
+
+        frame.writable().first_bin(first_bin);
+        frame.writable().rotation(completed + 1);
+        return frame;
+    }
+
+
+    std::uint16_t Rotation_assembler::sector_size() const
+    {
+        auto azimuths = sector_azimuths.load(std::memory_order_relaxed);
+        if (azimuths > 0) return azimuths;
+
+        auto degrees = sector_degrees.load(std::memory_order_relaxed);
+        if (degrees <= 0.0f) return 0;
+
+        return static_cast<std::uint16_t>(std::max(1.0f, std::round(degrees * filling->azimuth_samples() / 360.0f)));
+    }
+
+
+    // Deliver each sector from current_sector up to, but not including,
+    // up_to.
+    //
+    void Rotation_assembler::complete_sectors(std::int32_t up_to, bool last_in_rotation)
+    {
+        std::int32_t samples         = filling->azimuth_samples();
+        std::int32_t sector_azimuths = sector_size();
+
+        std::lock_guard lock { callback_mutex };
+
+        for (; current_sector < up_to; ++current_sector) {
+            auto first_position = current_sector * sector_azimuths;
+            if (first_position >= samples) break;
+
+            Rotation_sector sector {};
+            sector.first_azimuth    = static_cast<std::uint16_t>((first_position + origin) % samples);
+            sector.azimuth_count    = static_cast<std::uint16_t>(std::min(sector_azimuths, samples - first_position));
+            sector.sector           = static_cast<std::uint16_t>(current_sector);
+            sector.last_in_rotation = last_in_rotation && (current_sector + 1 == up_to);
+
+            filling.writable().blank_missing(sector.first_azimuth, sector.azimuth_count);
+            if (sector_callback == nullptr) continue;
+
+            sector.frame = filling;
+            sector_callback(sector);
+        }
+    }
+
+
+    void Rotation_assembler::complete_rotation()
+    {
+        auto next = acquire_frame();
+        if (!next) {
+            ++dropped;
+            filling.writable().clear();
+            return;
+        }
+
+        auto done = std::move(filling);
+        filling   = std::move(next);
+
+        done.writable().blank_missing();
+        done.writable().rotation(++completed);
+        filling.writable().rotation(completed + 1);
+
+        if (resampling) {
+            // Without a free frame to resample into, the rotation is
+            // delivered as received rather than lost
+            //
+            auto resampled = acquire_frame();
+            if (!resampled) ++not_resampled;
+
+            resampler.max_gap(resampling_max_gap);
+            if (resampled && resampler.resample(*done, resampled.writable())) {
+                done = std::move(resampled);
+
+                if (!region.is_whole_rotation()) {
+                    auto& frame = done.writable();
+                    for (std::uint16_t i = 0; i < frame.azimuth_samples(); ++i) {
+                        if (!region.contains_azimuth(i)) frame.invalidate(i);
+                    }
+                }
+            }
+        }
+
+        deliver(done);
+    }
+
+
+    void Rotation_assembler::deliver(const Rotation_frame_handle& frame)
+    {
+        rotation_history.add(frame);
+
+        // Called under the lock, rather than from a copy, as copying the
+        // std::function may allocate.
+        //
+        std::lock_guard lock { callback_mutex };
+        if (rotation_callback != nullptr) rotation_callback(frame);
+
+        for (auto& subscriber : subscribers) {
+            if (subscriber.profile.is_full_resolution()) subscriber.callback(frame);
+        }
+
+        for (auto& reducer : reducers) {
+            auto reduced = reducer->reduce(*frame);
+            if (!reduced) continue;
+
+            for (auto& subscriber : subscribers) {
+                if (subscriber.profile == reducer->profile()) subscriber.callback(reduced);
+            }
+        }
+    }
+
+} // namespace Navtech
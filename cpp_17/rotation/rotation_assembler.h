@@ -0,0 +1,175 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef ROTATION_ASSEMBLER_H
+#define ROTATION_ASSEMBLER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <vector>
+
+#include "../utility/pointer_types.h"
+#include "azimuth_resampler.h"
+#include "region_of_interest.h"
+#include "rotation_frame.h"
+#include "rotation_frame_pool.h"
+#include "rotation_history.h"
+#include "rotation_reducer.h"
+#include "rotation_sector.h"
+
+namespace Navtech {
+
+    using Rotation_subscriber_id = std::uint32_t;
+
+    // --------------------------------------------------------------------------------------------------
+    // The Rotation_assembler builds complete rotations from a stream of FFT
+    // azimuths, writing each azimuth directly into its row of a pooled
+    // Rotation_frame.
+    //
+    // While one frame is being filled, completed frames are held by their
+    // consumers. A rotation is complete when the azimuth index wraps; the
+    // completed frame is passed to the rotation callback and a new frame is
+    // taken from the pool. Consumers may keep the frame by copying its
+    // handle; it returns to the pool when the last copy is released.
+    // If every frame in the pool is still held, the completed rotation is
+    // discarded and counted in rotations_dropped().
+    //
+    // The partial rotation received before the first wrap is discarded.
+    // Once configured, no memory is allocated.
+    //
+    // Sectors of the rotation can also be delivered as soon as they are
+    // complete, for consumers that cannot wait for the whole rotation.
+    //
+    // add() and configure() must be called from the same thread. All
+    // callbacks are called on that thread, and must not set or remove
+    // callbacks or subscribers.
+    //
+    class Rotation_assembler {
+    public:
+        Rotation_assembler() = default;
+
+        Rotation_assembler(const Rotation_assembler&) = delete;
+        Rotation_assembler& operator=(const Rotation_assembler&) = delete;
+
+        // Takes effect at the next configure() that changes the frame
+        // dimensions. The pool must hold at least two frames.
+        //
+        void set_pool_size(std::size_t frame_count, Page_size page_size = Page_size::huge);
+
+        // Resample each completed rotation onto a uniform azimuth grid
+        // before it is delivered; see Azimuth_resampler. This uses one
+        // further frame from the pool. If no frame is free, the rotation
+        // is delivered as received and counted in rotations_not_resampled().
+        //
+        void set_resampling(bool enable, std::uint16_t max_gap = std::numeric_limits<std::uint16_t>::max());
+
+        // Keep the last rotations delivered in history(). The pool is
+        // enlarged by the same number of frames, so that the history does
+        // not starve the assembler. Takes effect at the next configure().
+        //
+        void set_history_depth(std::size_t rotations);
+        const Rotation_history& history() const { return rotation_history; }
+
+        // Frames hold only the bins in the region's range window. Each
+        // rotation starts at the end of the region's azimuth sector, so a
+        // frame completes as soon as the sector has passed.
+        //
+        void configure(std::uint16_t azimuth_samples,
+                       std::uint16_t range_in_bins,
+                       std::uint16_t encoder_size,
+                       const Region_of_interest& roi = Region_of_interest {});
+        void reset();
+
+        // data is the region's range window of the azimuth. Call skip(),
+        // with the encoder azimuth, for azimuths outside the sector so the
+        // rotation can complete without waiting for the next sector.
+        //
+        void add(const Azimuth_record& record, const std::uint8_t* data, std::size_t size);
+        void skip(std::uint16_t azimuth);
+
+        void set_rotation_callback(std::function<void(const Rotation_frame_handle&)> fn = nullptr);
+
+        // Deliver each sector of azimuths_per_sector azimuths (or of the
+        // given angle) as soon as the azimuth after it arrives. The last
+        // sector of a rotation may be smaller.
+        //
+        void set_sector_callback(std::function<void(const Rotation_sector&)> fn = nullptr,
+                                 std::uint16_t azimuths_per_sector       = 0);
+        void set_sector_callback_degrees(std::function<void(const Rotation_sector&)> fn, float degrees_per_sector);
+
+        // Subscribers receive each completed rotation reduced to their own
+        // profile. Each distinct profile is computed once per rotation,
+        // however many subscribers share it, and is called on the same
+        // thread as the rotation callback.
+        //
+
+        Rotation_subscriber_id add_subscriber(const Reduction_profile& profile,
+                                              std::function<void(const Rotation_frame_handle&)> fn);
+        void remove_subscriber(Rotation_subscriber_id id);
+        bool has_rotation_callback() const { return callback_set; }
+
+        std::uint64_t rotations_completed() const { return completed; }
+        std::uint64_t rotations_dropped() const { return dropped; }
+        std::uint64_t rotations_not_resampled() const { return not_resampled; }
+
+    private:
+        std::size_t pool_size { default_rotation_pool_size };
+        Page_size pool_page_size { Page_size::huge };
+        Owner_of<Rotation_frame_pool> pool {};
+        Rotation_frame_handle filling {};
+
+        std::atomic<std::size_t> history_depth { 0 };
+        Rotation_history rotation_history {};
+
+        Region_of_interest region {};
+        std::uint16_t first_bin { 0 };
+        std::uint16_t origin { 0 };
+
+        Azimuth_resampler resampler {};
+        std::atomic_bool resampling { false };
+        std::atomic<std::uint16_t> resampling_max_gap { std::numeric_limits<std::uint16_t>::max() };
+
+        std::int32_t last_position { -1 };
+        bool synchronised { false };
+        std::atomic<std::uint64_t> completed { 0 };
+        std::atomic<std::uint64_t> dropped { 0 };
+        std::atomic<std::uint64_t> not_resampled { 0 };
+
+        std::mutex callback_mutex;
+        std::function<void(const Rotation_frame_handle&)> rotation_callback = nullptr;
+        std::atomic_bool callback_set { false };
+
+        struct Subscriber
+        {
+            Rotation_subscriber_id id;
+            Reduction_profile profile;
+            std::function<void(const Rotation_frame_handle&)> callback;
+        };
+
+        Rotation_subscriber_id next_subscriber_id { 1 };
+        std::vector<Subscriber> subscribers {};
+        std::vector<Owner_of<Rotation_reducer>> reducers {};
+
+        std::function<void(const Rotation_sector&)> sector_callback = nullptr;
+        std::atomic<std::uint16_t> sector_azimuths { 0 };
+        std::atomic<float> sector_degrees { 0.0f };
+        std::int32_t current_sector { 0 };
+
+        void update_callback_set();
+        void deliver(const Rotation_frame_handle& frame);
+        std::uint16_t sector_size() const;
+        void complete_sectors(std::int32_t up_to, bool last_in_rotation);
+        std::int32_t advance(std::uint16_t azimuth);
+        Rotation_frame_handle acquire_frame();
+        void complete_rotation();
+    };
+
+} // namespace Navtech
+
+#endif // ROTATION_ASSEMBLER_H
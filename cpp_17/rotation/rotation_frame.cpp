@@ -0,0 +1,109 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include "rotation_frame.h"
+
+namespace Navtech {
+
+    void Rotation_frame::attach(std::uint8_t* storage,
+                                std::uint16_t azimuth_samples,
+                                std::uint16_t range_in_bins,
+                                std::size_t stride,
+                                std::uint16_t encoder_size)
+    {
+        samples    = storage;
+        azimuths   = azimuth_samples;
+        bins       = range_in_bins;
+        row_stride = stride;
+        encoder    = encoder_size;
+
+        records.assign(azimuths, Azimuth_record {});
+        valid_count     = 0;
+        rotation_number = 0;
+    }
+
+
+    void Rotation_frame::clear()
+    {
+        for (auto& record : records) {
+            record.valid = false;
+        }
+        valid_count       = 0;
+        continuity_counts = Continuity_counters {};
+    }
+
+
+    void Rotation_frame::write(std::uint16_t azimuth_index,
+                               const Azimuth_record& record,
+                               const std::uint8_t* data,
+                               std::size_t size)
+    {
+        if (azimuth_index >= azimuths) return;
+
+        auto count = std::min<std::size_t>(size, bins);
+        auto dest  = row(azimuth_index);
+        std::memcpy(dest, data, count);
+        if (count < bins) std::memset(dest + count, 0, bins - count);
+
+        mark(azimuth_index, record);
+    }
+
+
+    void Rotation_frame::mark(std::uint16_t azimuth_index, const Azimuth_record& record)
+    {
+        if (azimuth_index >= azimuths) return;
+
+        if (!records[azimuth_index].valid) ++valid_count;
+        records[azimuth_index]       = record;
+        records[azimuth_index].valid = true;
+
+        auto& continuity = record.continuity;
+        ++continuity_counts.azimuths_received;
+        if (continuity.missing_before > 0) {
+            ++continuity_counts.gaps;
+            continuity_counts.azimuths_missing += continuity.missing_before;
+        }
+        if (continuity.duplicate) ++continuity_counts.azimuths_duplicated;
+        if (continuity.sweep_discontinuity) ++continuity_counts.sweep_discontinuities;
+    }
+
+
+    void Rotation_frame::invalidate(std::uint16_t azimuth_index)
+    {
+        if (azimuth_index >= azimuths) return;
+
+        std::memset(row(azimuth_index), 0, bins);
+        if (!records[azimuth_index].valid) return;
+
+        records[azimuth_index].valid = false;
+        --valid_count;
+    }
+
+
+    void Rotation_frame::blank_missing(std::uint16_t first_azimuth, std::uint16_t count)
+    {
+        if (azimuths == 0) return;
+
+        for (std::uint16_t n = 0; n < count; ++n) {
+            auto i = static_cast<std::uint16_t>((first_azimuth + n) % azimuths);
+            if (!records[i].valid) std::memset(row(i), 0, bins);
+        }
+    }
+
+
+    void Rotation_frame::blank_missing()
+    {
+        if (valid_count == azimuths) return;
+
+        for (std::uint16_t i = 0; i < azimuths; ++i) {
+            if (!records[i].valid) std::memset(row(i), 0, bins);
+        }
+    }
+
+} // namespace Navtech
@@ -0,0 +1,136 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef ROTATION_FRAME_H
+#define ROTATION_FRAME_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "continuity_tracker.h"
+
+namespace Navtech {
+
+    class Rotation_frame_arena;
+    class Rotation_frame_handle;
+
+    // Per-azimuth metadata for one row of a Rotation_frame.
+    // Rows that were not received during the rotation have valid == false
+    // and their FFT data set to zero. continuity describes the azimuth
+    // relative to the one received before it.
+    //
+    struct Azimuth_record
+    {
+        bool valid { false };
+        std::uint16_t azimuth { 0 };
+        std::uint16_t sweep_counter { 0 };
+        std::uint32_t ntp_seconds { 0 };
+        std::uint32_t ntp_split_seconds { 0 };
+        Continuity continuity {};
+    };
+
+
+    // --------------------------------------------------------------------------------------------------
+    // A complete rotation of FFT data, stored as one contiguous block of
+    // azimuth_samples rows of range_in_bins samples. Row n holds azimuth
+    // index n; that is, encoder position (n * encoder_size / azimuth_samples).
+    //
+    // Each row starts on a cache line; stride() gives the distance between
+    // rows, which may be larger than range_in_bins.
+    //
+    // Frames are owned by a Rotation_frame_pool and accessed through a
+    // Rotation_frame_handle; writing a row never allocates.
+    //
+    class Rotation_frame {
+    public:
+        Rotation_frame() = default;
+
+        Rotation_frame(const Rotation_frame&) = delete;
+        Rotation_frame& operator=(const Rotation_frame&) = delete;
+
+        void attach(std::uint8_t* storage,
+                    std::uint16_t azimuth_samples,
+                    std::uint16_t range_in_bins,
+                    std::size_t stride,
+                    std::uint16_t encoder_size);
+        void clear();
+
+        std::uint16_t azimuth_samples() const { return azimuths; }
+        std::uint16_t range_in_bins() const { return bins; }
+        std::uint16_t encoder_size() const { return encoder; }
+        std::size_t stride() const { return row_stride; }
+
+        // The range bin held in column 0 of each row; non-zero if the frame
+        // holds a range window (see Region_of_interest).
+        //
+        std::uint16_t first_bin() const { return first_column_bin; }
+        void first_bin(std::uint16_t value) { first_column_bin = value; }
+
+        std::uint64_t rotation() const { return rotation_number; }
+        void rotation(std::uint64_t value) { rotation_number = value; }
+
+        // Copy one azimuth of FFT data into its row. Data longer than
+        // range_in_bins is truncated; shorter data is zero-padded.
+        //
+        void write(std::uint16_t azimuth_index,
+                   const Azimuth_record& record,
+                   const std::uint8_t* data,
+                   std::size_t size);
+
+        // Record a row whose data has been written directly, via row().
+        //
+        void mark(std::uint16_t azimuth_index, const Azimuth_record& record);
+
+        // Zero the data of every row not written since clear().
+        //
+        void blank_missing();
+        void blank_missing(std::uint16_t first_azimuth, std::uint16_t count);
+
+        // Mark one row as not received, and zero its data.
+        //
+        void invalidate(std::uint16_t azimuth_index);
+
+        std::uint8_t* row(std::uint16_t azimuth_index) { return samples + (azimuth_index * row_stride); }
+        const std::uint8_t* row(std::uint16_t azimuth_index) const { return samples + (azimuth_index * row_stride); }
+
+        const Azimuth_record& record(std::uint16_t azimuth_index) const { return records[azimuth_index]; }
+        bool is_valid(std::uint16_t azimuth_index) const { return records[azimuth_index].valid; }
+
+        std::uint16_t valid_azimuths() const { return valid_count; }
+        bool is_complete() const { return azimuths > 0 && valid_count == azimuths; }
+
+        // Gaps, duplicates and sweep counter jumps seen while this frame
+        // was being filled.
+        //
+        const Continuity_counters& continuity() const { return continuity_counts; }
+        void continuity(const Continuity_counters& counters) { continuity_counts = counters; }
+
+        const std::uint8_t* data() const { return samples; }
+        std::size_t size() const { return azimuths * row_stride; }
+
+    private:
+        friend class Rotation_frame_arena;
+        friend class Rotation_frame_handle;
+
+        std::uint8_t* samples { nullptr };
+        std::uint16_t azimuths { 0 };
+        std::uint16_t bins { 0 };
+        std::size_t row_stride { 0 };
+        std::uint16_t encoder { 0 };
+        std::uint16_t first_column_bin { 0 };
+        std::uint16_t valid_count { 0 };
+        std::uint64_t rotation_number { 0 };
+        std::vector<Azimuth_record> records {};
+        Continuity_counters continuity_counts {};
+
+        std::atomic<std::uint32_t> references { 0 };
+        Rotation_frame_arena* arena { nullptr };
+    };
+
+} // namespace Navtech
+
+#endif // ROTATION_FRAME_H
@@ -0,0 +1,284 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "rotation_frame_pool.h"
+
+namespace Navtech {
+
+    constexpr std::size_t cache_line_size { 64 };
+    constexpr std::size_t huge_page_size { 2 * 1024 * 1024 };
+
+    static std::size_t round_up(std::size_t value, std::size_t multiple)
+    {
+        return ((value + multiple - 1) / multiple) * multiple;
+    }
+
+
+    // --------------------------------------------------------------------------------------------------
+    // The pool's shared state. The arena outlives the pool if handles
+    // are still outstanding when the pool is destroyed; it deletes itself
+    // when the last frame is returned.
+    //
+    class Rotation_frame_arena {
+    public:
+        Rotation_frame_arena(std::size_t frame_count,
+                             std::uint16_t azimuth_samples,
+                             std::uint16_t range_in_bins,
+                             std::uint16_t encoder_size,
+                             Page_size page_size);
+        ~Rotation_frame_arena();
+
+        Rotation_frame_handle acquire();
+        void release(Rotation_frame* frame);
+        void close();
+
+        std::size_t capacity() const { return count; }
+        std::size_t available() const;
+        bool uses_huge_pages() const { return huge_pages; }
+
+    private:
+        std::size_t count { 0 };
+        std::unique_ptr<Rotation_frame[]> frames {};
+
+        void* mapping { nullptr };
+        std::size_t mapping_size { 0 };
+        bool huge_pages { false };
+
+        mutable std::mutex free_mutex {};
+        std::vector<Rotation_frame*> free_frames {};
+        bool closed { false };
+
+        std::uint8_t* allocate(std::size_t size, Page_size page_size);
+    };
+
+
+    Rotation_frame_arena::Rotation_frame_arena(std::size_t frame_count,
+                                               std::uint16_t azimuth_samples,
+                                               std::uint16_t range_in_bins,
+                                               std::uint16_t encoder_size,
+                                               Page_size page_size) :
+        count  { frame_count },
+        frames { new Rotation_frame[frame_count] }
+    {
+        auto stride      = round_up(range_in_bins, cache_line_size);
+        auto frame_bytes = round_up(azimuth_samples * stride, cache_line_size);
+        auto memory      = allocate(frame_bytes * count, page_size);
+
+        // Touch every page now, so that the first rotations do not take
+        // page faults.
+        //
+        std::memset(memory, 0, frame_bytes * count);
+
+        free_frames.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            frames[i].attach(memory + (i * frame_bytes), azimuth_samples, range_in_bins, stride, encoder_size);
+            frames[i].arena = this;
+            free_frames.push_back(&frames[i]);
+        }
+    }
+
+
+    Rotation_frame_arena::~Rotation_frame_arena()
+    {
+        if (mapping != nullptr) ::munmap(mapping, mapping_size);
+    }
+
+
+    std::uint8_t* Rotation_frame_arena::allocate(std::size_t size, Page_size page_size)
+    {
+        if (page_size == Page_size::huge) {
+            auto huge_size = round_up(size, huge_page_size);
+
+            mapping = ::mmap(
+                nullptr, huge_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (mapping != MAP_FAILED) {
+                mapping_size = huge_size;
+                huge_pages   = true;
+                return static_cast<std::uint8_t*>(mapping);
+            }
+
+            // No reserved huge pages; fall back to transparent huge pages.
+            // Over-allocate so the block can start on a huge page boundary.
+            //
+            mapping_size = huge_size + huge_page_size;
+            mapping      = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mapping == MAP_FAILED) throw std::bad_alloc {};
+
+            auto aligned = round_up(reinterpret_cast<std::uintptr_t>(mapping), huge_page_size);
+            auto memory  = reinterpret_cast<std::uint8_t*>(aligned);
+            huge_pages   = (::madvise(memory, huge_size, MADV_HUGEPAGE) == 0);
+            return memory;
+        }
+
+        mapping_size = round_up(size, static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)));
+        mapping      = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED) throw std::bad_alloc {};
+
+        return static_cast<std::uint8_t*>(mapping);
+    }
+
+
+    Rotation_frame_handle Rotation_frame_arena::acquire()
+    {
+        std::lock_guard lock { free_mutex };
+        if (free_frames.empty()) return Rotation_frame_handle {};
+
+        auto frame = free_frames.back();
+        free_frames.pop_back();
+
+        frame->clear();
+        frame->rotation(0);
+        frame->references.store(1, std::memory_order_relaxed);
+        return Rotation_frame_handle { frame };
+    }
+
+
+    void Rotation_frame_arena::release(Rotation_frame* frame)
+    {
+        std::unique_lock lock { free_mutex };
+        free_frames.push_back(frame);
+        auto last = closed && free_frames.size() == count;
+        lock.unlock();
+
+        if (last) delete this;
+    }
+
+
+    void Rotation_frame_arena::close()
+    {
+        std::unique_lock lock { free_mutex };
+        closed    = true;
+        auto last = free_frames.size() == count;
+        lock.unlock();
+
+        if (last) delete this;
+    }
+
+
+    std::size_t Rotation_frame_arena::available() const
+    {
+        std::lock_guard lock { free_mutex };
+        return free_frames.size();
+    }
+
+
+    // --------------------------------------------------------------------------------------------------
+    //
+    Rotation_frame_handle::Rotation_frame_handle(Rotation_frame* acquired) :
+        frame { acquired }
+    {
+    }
+
+
+    Rotation_frame_handle::Rotation_frame_handle(const Rotation_frame_handle& other) :
+        frame { other.frame }
+    {
+        if (frame != nullptr) frame->references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+
+    Rotation_frame_handle::Rotation_frame_handle(Rotation_frame_handle&& other) noexcept :
+        frame { other.frame }
+    {
+        other.frame = nullptr;
+    }
+
+
+    Rotation_frame_handle& Rotation_frame_handle::operator=(const Rotation_frame_handle& other)
+    {
+        // other may be this handle, which reset() empties
+        //
+        auto acquired = other.frame;
+        if (acquired != nullptr) acquired->references.fetch_add(1, std::memory_order_relaxed);
+        reset();
+        frame = acquired;
+        return *this;
+    }
+
+
+    Rotation_frame_handle& Rotation_frame_handle::operator=(Rotation_frame_handle&& other) noexcept
+    {
+        if (this == &other) return *this;
+
+        reset();
+        frame       = other.frame;
+        other.frame = nullptr;
+        return *this;
+    }
+
+
+    Rotation_frame_handle::~Rotation_frame_handle()
+    {
+        reset();
+    }
+
+
+    void Rotation_frame_handle::reset()
+    {
+        if (frame == nullptr) return;
+
+        if (frame->references.fetch_sub(1, std::memory_order_acq_rel) == 1) frame->arena->release(frame);
+        frame = nullptr;
+    }
+
+
+    std::uint32_t Rotation_frame_handle::use_count() const
+    {
+        return (frame != nullptr) ? frame->references.load(std::memory_order_relaxed) : 0;
+    }
+
+
+    // --------------------------------------------------------------------------------------------------
+    //
+    Rotation_frame_pool::Rotation_frame_pool(std::size_t frame_count,
+                                             std::uint16_t azimuth_samples,
+                                             std::uint16_t range_in_bins,
+                                             std::uint16_t encoder_size,
+                                             Page_size page_size) :
+        arena { new Rotation_frame_arena { frame_count, azimuth_samples, range_in_bins, encoder_size, page_size } }
+    {
+    }
+
+
+    Rotation_frame_pool::~Rotation_frame_pool()
+    {
+        arena->close();
+    }
+
+
+    Rotation_frame_handle Rotation_frame_pool::acquire()
+    {
+        return arena->acquire();
+    }
+
+
+    std::size_t Rotation_frame_pool::capacity() const
+    {
+        return arena->capacity();
+    }
+
+
+    std::size_t Rotation_frame_pool::available() const
+    {
+        return arena->available();
+    }
+
+
+    bool Rotation_frame_pool::uses_huge_pages() const
+    {
+        return arena->uses_huge_pages();
+    }
+
+} // namespace Navtech
@@ -0,0 +1,97 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef ROTATION_FRAME_POOL_H
+#define ROTATION_FRAME_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "rotation_frame.h"
+
+namespace Navtech {
+
+    constexpr std::size_t default_rotation_pool_size { 4 };
+
+    // Huge pages are used if the system has any reserved (MAP_HUGETLB);
+    // otherwise transparent huge pages are requested for the pool memory.
+    // Page_size::standard uses ordinary pages only.
+    //
+    enum class Page_size { standard, huge };
+
+
+    // --------------------------------------------------------------------------------------------------
+    // A reference-counted handle to a pooled Rotation_frame. Copying a
+    // handle only increments the frame's reference count; when the last
+    // handle is released the frame returns to its pool. Handles may be
+    // copied, kept and released on any thread.
+    //
+    // A frame delivered to several consumers is shared; modify it through
+    // writable() only while the handle is unique.
+    //
+    class Rotation_frame_handle {
+    public:
+        Rotation_frame_handle() = default;
+        Rotation_frame_handle(const Rotation_frame_handle& other);
+        Rotation_frame_handle(Rotation_frame_handle&& other) noexcept;
+        Rotation_frame_handle& operator=(const Rotation_frame_handle& other);
+        Rotation_frame_handle& operator=(Rotation_frame_handle&& other) noexcept;
+        ~Rotation_frame_handle();
+
+        void reset();
+
+        const Rotation_frame* get() const { return frame; }
+        const Rotation_frame* operator->() const { return frame; }
+        const Rotation_frame& operator*() const { return *frame; }
+        explicit operator bool() const { return frame != nullptr; }
+
+        Rotation_frame& writable() { return *frame; }
+        bool unique() const { return use_count() == 1; }
+        std::uint32_t use_count() const;
+
+    private:
+        friend class Rotation_frame_arena;
+
+        explicit Rotation_frame_handle(Rotation_frame* acquired);
+
+        Rotation_frame* frame { nullptr };
+    };
+
+
+    // --------------------------------------------------------------------------------------------------
+    // A fixed number of Rotation_frames, all of the same dimensions, held
+    // in a single block of memory allocated (and pre-faulted) at
+    // construction. Each frame, and each row, starts on a cache line.
+    //
+    // acquire() returns an empty handle if every frame is in use; it never
+    // allocates. Destroying the pool while handles are outstanding is
+    // safe - the memory is released with the last handle.
+    //
+    class Rotation_frame_pool {
+    public:
+        Rotation_frame_pool(std::size_t frame_count,
+                            std::uint16_t azimuth_samples,
+                            std::uint16_t range_in_bins,
+                            std::uint16_t encoder_size,
+                            Page_size page_size = Page_size::huge);
+        ~Rotation_frame_pool();
+
+        Rotation_frame_pool(const Rotation_frame_pool&) = delete;
+        Rotation_frame_pool& operator=(const Rotation_frame_pool&) = delete;
+
+        Rotation_frame_handle acquire();
+
+        std::size_t capacity() const;
+        std::size_t available() const;
+        bool uses_huge_pages() const;
+
+    private:
+        Rotation_frame_arena* arena { nullptr };
+    };
+
+} // namespace Navtech
+
+#endif // ROTATION_FRAME_POOL_H
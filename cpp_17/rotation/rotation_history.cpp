@@ -0,0 +1,190 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <algorithm>
+
+#include "rotation_history.h"
+
+namespace Navtech {
+
+    Rotation_history::Rotation_history(std::size_t depth) : entries(depth)
+    {
+    }
+
+
+    void Rotation_history::set_depth(std::size_t depth)
+    {
+        std::vector<Entry> released {};
+        {
+            std::lock_guard lock { history_mutex };
+            released.swap(entries);
+            entries.resize(depth);
+            any    = false;
+            newest = 0;
+            period = std::chrono::nanoseconds { 0 };
+        }
+    }
+
+
+    std::size_t Rotation_history::depth() const
+    {
+        std::lock_guard lock { history_mutex };
+        return entries.size();
+    }
+
+
+    void Rotation_history::clear()
+    {
+        set_depth(depth());
+    }
+
+
+    bool Rotation_history::empty() const
+    {
+        std::lock_guard lock { history_mutex };
+        return !any;
+    }
+
+
+    std::uint64_t Rotation_history::newest_rotation() const
+    {
+        std::lock_guard lock { history_mutex };
+        return newest;
+    }
+
+
+    void Rotation_history::add(const Rotation_frame_handle& frame)
+    {
+        if (!frame) return;
+
+        Entry entry { frame, frame->rotation(), Radar_time::max(), Radar_time::min() };
+        for (std::uint16_t i = 0; i < frame->azimuth_samples(); ++i) {
+            auto& record = frame->record(i);
+            if (!record.valid || !is_valid_timestamp(record.ntp_seconds, record.ntp_split_seconds)) continue;
+
+            auto time   = to_radar_time(record.ntp_seconds, record.ntp_split_seconds);
+            entry.start = std::min(entry.start, time);
+            entry.end   = std::max(entry.end, time);
+        }
+        if (entry.start > entry.end) entry.start = entry.end = Radar_time {};
+
+        // Replaced frames are released outside the lock
+        //
+        Rotation_frame_handle released {};
+        std::vector<Entry> released_entries {};
+        {
+            std::lock_guard lock { history_mutex };
+            if (entries.empty()) return;
+
+            // Rotation numbers going backwards means a new source
+            //
+            if (any && entry.rotation <= newest) {
+                auto depth = entries.size();
+                released_entries.swap(entries);
+                entries.resize(depth);
+                any    = false;
+                period = std::chrono::nanoseconds { 0 };
+            }
+
+            auto previous = find(newest);
+            if (any && previous != nullptr && previous->start != Radar_time {} && entry.start != Radar_time {}) {
+                period = (entry.start - previous->start) / static_cast<std::int64_t>(entry.rotation - newest);
+            }
+
+            auto& slot = entries[entry.rotation % entries.size()];
+            released   = std::move(slot.frame);
+            slot       = std::move(entry);
+            newest     = slot.rotation;
+            any        = true;
+        }
+    }
+
+
+    Rotation_frame_handle Rotation_history::rotation(std::uint64_t rotation_number) const
+    {
+        std::lock_guard lock { history_mutex };
+
+        auto entry = find(rotation_number);
+        return entry ? entry->frame : Rotation_frame_handle {};
+    }
+
+
+    Rotation_frame_handle Rotation_history::ago(std::uint64_t rotations_ago) const
+    {
+        std::lock_guard lock { history_mutex };
+        if (rotations_ago > newest) return Rotation_frame_handle {};
+
+        auto entry = find(newest - rotations_ago);
+        return entry ? entry->frame : Rotation_frame_handle {};
+    }
+
+
+    Rotation_frame_handle Rotation_history::nearest(Radar_time time) const
+    {
+        std::lock_guard lock { history_mutex };
+
+        auto latest = find(newest);
+        if (latest == nullptr) return Rotation_frame_handle {};
+
+        const Entry* best = nullptr;
+        auto consider     = [&best, time](const Entry* entry) {
+            if (entry == nullptr) return;
+            if (best == nullptr || distance(*entry, time) < distance(*best, time)) best = entry;
+        };
+
+        // Estimate the rotation from the rotation period, then walk from it
+        // towards time while the rotations held get closer. Rotations are
+        // in time order, so the walk stops at the first that does not; if
+        // the period is steady that is the estimate's neighbour. Dropped
+        // rotations, and those without timestamps, are stepped over.
+        //
+        if (period.count() > 0) {
+            auto rotations_ago = std::max<std::int64_t>((latest->start - time) / period, 0);
+            auto depth         = static_cast<std::int64_t>(entries.size());
+            auto last          = static_cast<std::int64_t>(newest);
+            auto oldest        = last - std::min<std::int64_t>(depth - 1, last);
+            auto guess         = std::max<std::int64_t>(last - rotations_ago, oldest);
+
+            consider(find(static_cast<std::uint64_t>(guess)));
+            for (auto step : { -1, 1 }) {
+                for (auto n = guess + step; n >= oldest && n <= last; n += step) {
+                    auto entry = find(static_cast<std::uint64_t>(n));
+                    if (entry == nullptr || entry->start == Radar_time {}) continue;
+                    if (best != nullptr && distance(*entry, time) >= distance(*best, time)) break;
+                    best = entry;
+                }
+            }
+        }
+
+        // Without a period, or with gaps around the estimate, look at every
+        // rotation held
+        //
+        if (best == nullptr) {
+            for (auto& entry : entries) {
+                if (entry.frame) consider(&entry);
+            }
+        }
+        return best ? best->frame : Rotation_frame_handle {};
+    }
+
+
+    const Rotation_history::Entry* Rotation_history::find(std::uint64_t rotation_number) const
+    {
+        if (!any || entries.empty()) return nullptr;
+
+        auto& entry = entries[rotation_number % entries.size()];
+        return (entry.frame && entry.rotation == rotation_number) ? &entry : nullptr;
+    }
+
+
+    std::chrono::nanoseconds Rotation_history::distance(const Entry& entry, Radar_time time)
+    {
+        if (time < entry.start) return entry.start - time;
+        if (time > entry.end) return time - entry.end;
+        return std::chrono::nanoseconds { 0 };
+    }
+
+} // namespace Navtech
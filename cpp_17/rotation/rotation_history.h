@@ -0,0 +1,94 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef ROTATION_HISTORY_H
+#define ROTATION_HISTORY_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "rotation_frame_pool.h"
+#include "timestamp_normaliser.h"
+
+namespace Navtech {
+
+    // --------------------------------------------------------------------------------------------------
+    // The most recent rotations, up to depth() of them, held by handle so
+    // that lookups share the frames rather than copying them.
+    //
+    // Rotations are found by rotation number or by age in constant time,
+    // or by time; see nearest(). Entries are slotted by rotation number,
+    // so a dropped rotation leaves a gap and lookups for it return an
+    // empty handle.
+    // Each rotation spans the earliest to the latest valid radar timestamp
+    // of its rows.
+    //
+    // Adding a rotation releases the handle of the one it replaces, which
+    // returns that frame to its pool once no other consumer holds it. The
+    // history therefore keeps up to depth() frames out of the pool
+    // supplying it, and that pool must be sized to allow for them.
+    //
+    // add() and set_depth() may be called from one thread while lookups are
+    // made from others. Handles returned stay valid after the rotation
+    // leaves the history.
+    //
+    class Rotation_history {
+    public:
+        explicit Rotation_history(std::size_t depth = 0);
+
+        Rotation_history(const Rotation_history&) = delete;
+        Rotation_history& operator=(const Rotation_history&) = delete;
+
+        // Changing the depth empties the history
+        //
+        void set_depth(std::size_t depth);
+        std::size_t depth() const;
+
+        void add(const Rotation_frame_handle& frame);
+        void clear();
+
+        bool empty() const;
+        std::uint64_t newest_rotation() const;
+
+        // rotations_ago counts back from the newest, which is 0
+        //
+        Rotation_frame_handle rotation(std::uint64_t rotation_number) const;
+        Rotation_frame_handle ago(std::uint64_t rotations_ago) const;
+
+        // The rotation whose time span is closest to time. Constant time
+        // while the rotation period is steady; otherwise proportional to
+        // the number of rotations the period's estimate is out by.
+        //
+        Rotation_frame_handle nearest(Radar_time time) const;
+
+    private:
+        struct Entry
+        {
+            Rotation_frame_handle frame {};
+            std::uint64_t rotation { 0 };
+            Radar_time start {};
+            Radar_time end {};
+        };
+
+        mutable std::mutex history_mutex;
+        std::vector<Entry> entries {};
+        std::uint64_t newest { 0 };
+        bool any { false };
+
+        // Time from the start of one rotation to the start of the next,
+        // from the two newest rotations
+        //
+        std::chrono::nanoseconds period { 0 };
+
+        const Entry* find(std::uint64_t rotation_number) const;
+        static std::chrono::nanoseconds distance(const Entry& entry, Radar_time time);
+    };
+
+} // namespace Navtech
+
+#endif // ROTATION_HISTORY_H
@@ -0,0 +1,79 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include "rotation_integrator.h"
+
+namespace Navtech {
+
+    Rotation_integrator::Rotation_integrator(const Rotation_integration_profile& profile,
+                                             std::size_t frames,
+                                             Page_size page_size) :
+        integration    { profile },
+        pool_size      { std::max<std::size_t>(frames, 1) },
+        pool_page_size { page_size }
+    {
+        integration.window_length = std::max<std::uint16_t>(integration.window_length, 1);
+    }
+
+
+    Rotation_frame_handle Rotation_integrator::integrate(const Rotation_frame& in)
+    {
+        if (!pool || in.azimuth_samples() != input_azimuths || in.range_in_bins() != input_bins ||
+            in.encoder_size() != input_encoder || in.first_bin() != input_first_bin) {
+            input_azimuths  = in.azimuth_samples();
+            input_bins      = in.range_in_bins();
+            input_encoder   = in.encoder_size();
+            input_first_bin = in.first_bin();
+
+            engine.configure(static_cast<std::size_t>(input_azimuths) * input_bins,
+                             integration.window_length,
+                             integration.mode,
+                             integration.window);
+            pool = allocate_owned<Rotation_frame_pool>(
+                pool_size, input_azimuths, input_bins, input_encoder, pool_page_size);
+        }
+
+        // The frame's rows are strided; the window's are packed
+        //
+        auto row = engine.next_row();
+        for (std::uint16_t azimuth = 0; azimuth < input_azimuths; ++azimuth) {
+            std::memcpy(row + static_cast<std::size_t>(azimuth) * input_bins, in.row(azimuth), input_bins);
+        }
+        if (!engine.commit()) return Rotation_frame_handle {};
+
+        auto frame = pool->acquire();
+        if (!frame) {
+            ++dropped;
+            return frame;
+        }
+
+        auto& out = frame.writable();
+        out.first_bin(input_first_bin);
+
+        for (std::uint16_t azimuth = 0; azimuth < input_azimuths; ++azimuth) {
+            if (!in.is_valid(azimuth)) {
+                std::memset(out.row(azimuth), 0, input_bins);
+                continue;
+            }
+            engine.result(out.row(azimuth), static_cast<std::size_t>(azimuth) * input_bins, input_bins);
+            out.mark(azimuth, in.record(azimuth));
+        }
+
+        out.continuity(in.continuity());
+        out.rotation(in.rotation());
+        return frame;
+    }
+
+
+    void Rotation_integrator::reset()
+    {
+        engine.reset();
+    }
+
+} // namespace Navtech
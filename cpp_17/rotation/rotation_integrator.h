@@ -0,0 +1,77 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef ROTATION_INTEGRATOR_H
+#define ROTATION_INTEGRATOR_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "../utility/pointer_types.h"
+#include "rotation_frame.h"
+#include "rotation_frame_pool.h"
+#include "temporal_integrator.h"
+
+namespace Navtech {
+
+    struct Rotation_integration_profile
+    {
+        std::uint16_t window_length { 4 };
+        Integration_mode mode { Integration_mode::mean };
+        Integration_window window { Integration_window::sliding };
+    };
+
+
+    // --------------------------------------------------------------------------------------------------
+    // Integrates consecutive rotations, cell by cell, with a
+    // Temporal_integrator whose rows are whole frames.
+    //
+    // Integrated frames come from the integrator's own pool. Each has the
+    // records, continuity and rotation number of the newest rotation in
+    // the window; rows not received in that rotation are zeroed, as in
+    // any other frame. Missing rows count as zeros in the window.
+    //
+    // The window and the pool are sized on first use, and the window
+    // restarts whenever the input dimensions change.
+    //
+    class Rotation_integrator {
+    public:
+        explicit Rotation_integrator(const Rotation_integration_profile& profile,
+                                     std::size_t pool_size = default_rotation_pool_size,
+                                     Page_size page_size   = Page_size::standard);
+
+        Rotation_integrator(const Rotation_integrator&) = delete;
+        Rotation_integrator& operator=(const Rotation_integrator&) = delete;
+
+        const Rotation_integration_profile& profile() const { return integration; }
+
+        // Adds a rotation to the window. Returns the integrated frame if
+        // the window has a result, or an empty handle if it does not or if
+        // every frame in the pool is in use.
+        //
+        Rotation_frame_handle integrate(const Rotation_frame& in);
+        void reset();
+
+        std::uint16_t rotations() const { return engine.rows(); }
+        std::uint64_t rotations_dropped() const { return dropped; }
+
+    private:
+        Rotation_integration_profile integration {};
+        std::size_t pool_size { default_rotation_pool_size };
+        Page_size pool_page_size { Page_size::standard };
+        Owner_of<Rotation_frame_pool> pool {};
+        std::uint16_t input_azimuths { 0 };
+        std::uint16_t input_bins { 0 };
+        std::uint16_t input_encoder { 0 };
+        std::uint16_t input_first_bin { 0 };
+
+        Temporal_integrator engine {};
+        std::atomic<std::uint64_t> dropped { 0 };
+    };
+
+} // namespace Navtech
+
+#endif // ROTATION_INTEGRATOR_H
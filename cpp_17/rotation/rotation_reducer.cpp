@@ -0,0 +1,72 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include "rotation_reducer.h"
+#include "row_kernels.h"
+
+namespace Navtech {
+
+    Rotation_reducer::Rotation_reducer(const Reduction_profile& profile, std::size_t frames, Page_size page_size) :
+        reduction      { profile },
+        pool_size      { std::max<std::size_t>(frames, 1) },
+        pool_page_size { page_size }
+    {
+        reduction.range_factor   = std::max<std::uint16_t>(reduction.range_factor, 1);
+        reduction.azimuth_stride = std::max<std::uint16_t>(reduction.azimuth_stride, 1);
+    }
+
+
+    Rotation_frame_handle Rotation_reducer::reduce(const Rotation_frame& in)
+    {
+        auto factor = reduction.range_factor;
+        auto stride = reduction.azimuth_stride;
+
+        if (!pool || in.azimuth_samples() != input_azimuths || in.range_in_bins() != input_bins ||
+            in.encoder_size() != input_encoder) {
+            input_azimuths = in.azimuth_samples();
+            input_bins     = in.range_in_bins();
+            input_encoder  = in.encoder_size();
+
+            auto azimuths = static_cast<std::uint16_t>((input_azimuths + stride - 1) / stride);
+            auto bins     = static_cast<std::uint16_t>((input_bins + factor - 1) / factor);
+
+            pool = allocate_owned<Rotation_frame_pool>(pool_size, azimuths, bins, input_encoder, pool_page_size);
+        }
+
+        auto frame = pool->acquire();
+        if (!frame) {
+            ++dropped;
+            return frame;
+        }
+
+        auto& out = frame.writable();
+        out.first_bin(in.first_bin());
+
+        for (std::uint16_t i = 0; i < out.azimuth_samples(); ++i) {
+            auto source = static_cast<std::uint16_t>(i * stride);
+            if (!in.is_valid(source)) {
+                std::memset(out.row(i), 0, out.range_in_bins());
+                continue;
+            }
+
+            if (reduction.range_reduction == Range_reduction::mean) {
+                Row_kernels::reduce_mean(in.row(source), in.range_in_bins(), out.row(i), factor);
+            }
+            else {
+                Row_kernels::reduce_max(in.row(source), in.range_in_bins(), out.row(i), factor);
+            }
+            out.mark(i, in.record(source));
+        }
+
+        out.continuity(in.continuity());
+        out.rotation(in.rotation());
+        return frame;
+    }
+
+} // namespace Navtech
@@ -0,0 +1,84 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef ROTATION_REDUCER_H
+#define ROTATION_REDUCER_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "../utility/pointer_types.h"
+#include "rotation_frame.h"
+#include "rotation_frame_pool.h"
+
+namespace Navtech {
+
+    enum class Range_reduction { max, mean };
+
+    // A reduced-resolution view of each rotation:
+    // - range_factor consecutive bins are combined into one, by taking
+    //   their maximum or their mean.
+    // - Only every azimuth_stride'th azimuth is kept.
+    // The default profile is full resolution.
+    //
+    struct Reduction_profile
+    {
+        std::uint16_t range_factor { 1 };
+        Range_reduction range_reduction { Range_reduction::max };
+        std::uint16_t azimuth_stride { 1 };
+
+        bool is_full_resolution() const { return range_factor <= 1 && azimuth_stride <= 1; }
+
+        bool operator==(const Reduction_profile& other) const
+        {
+            if (is_full_resolution() && other.is_full_resolution()) return true;
+            return range_factor == other.range_factor && range_reduction == other.range_reduction &&
+                   azimuth_stride == other.azimuth_stride;
+        }
+
+        bool operator!=(const Reduction_profile& other) const { return !(*this == other); }
+    };
+
+
+    // --------------------------------------------------------------------------------------------------
+    // Produces the reduced-resolution frame for one Reduction_profile.
+    // Output row n is input row (n * azimuth_stride), binned in range;
+    // first_bin() is unchanged, in full-resolution bins.
+    //
+    // Reduced frames come from the reducer's own pool, which is sized on
+    // first use and whenever the input dimensions change.
+    //
+    class Rotation_reducer {
+    public:
+        explicit Rotation_reducer(const Reduction_profile& profile,
+                                  std::size_t pool_size = default_rotation_pool_size,
+                                  Page_size page_size   = Page_size::standard);
+
+        Rotation_reducer(const Rotation_reducer&) = delete;
+        Rotation_reducer& operator=(const Rotation_reducer&) = delete;
+
+        const Reduction_profile& profile() const { return reduction; }
+
+        // Returns an empty handle if every frame in the pool is in use.
+        //
+        Rotation_frame_handle reduce(const Rotation_frame& in);
+
+        std::uint64_t rotations_dropped() const { return dropped; }
+
+    private:
+        Reduction_profile reduction {};
+        std::size_t pool_size { default_rotation_pool_size };
+        Page_size pool_page_size { Page_size::standard };
+        Owner_of<Rotation_frame_pool> pool {};
+        std::uint16_t input_azimuths { 0 };
+        std::uint16_t input_bins { 0 };
+        std::uint16_t input_encoder { 0 };
+        std::atomic<std::uint64_t> dropped { 0 };
+    };
+
+} // namespace Navtech
+
+#endif // ROTATION_REDUCER_H
@@ -0,0 +1,47 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef ROTATION_SECTOR_H
+#define ROTATION_SECTOR_H
+
+#include <cstdint>
+
+#include "rotation_frame.h"
+#include "rotation_frame_pool.h"
+
+namespace Navtech {
+
+    // --------------------------------------------------------------------------------------------------
+    // A completed sector of the rotation currently being assembled: rows
+    // first_azimuth to (first_azimuth + azimuth_count - 1) of frame. The
+    // rows are contiguous in memory unless the sector wraps through azimuth
+    // zero, which can only happen when a Region_of_interest is set.
+    //
+    // frame is the in-progress rotation; it is still being written, so
+    // only the sector's own rows should be read. Holding the handle keeps
+    // the frame (and so the sector) alive.
+    //
+    struct Rotation_sector
+    {
+        Rotation_frame_handle frame {};
+        std::uint16_t first_azimuth { 0 };
+        std::uint16_t azimuth_count { 0 };
+        std::uint16_t sector { 0 };
+        bool last_in_rotation { false };
+
+        std::uint16_t azimuth_index(std::uint16_t n) const
+        {
+            return static_cast<std::uint16_t>((first_azimuth + n) % frame->azimuth_samples());
+        }
+
+        const std::uint8_t* row(std::uint16_t n) const { return frame->row(azimuth_index(n)); }
+        const Azimuth_record& record(std::uint16_t n) const { return frame->record(azimuth_index(n)); }
+        bool is_valid(std::uint16_t n) const { return frame->is_valid(azimuth_index(n)); }
+    };
+
+} // namespace Navtech
+
+#endif // ROTATION_SECTOR_H
@@ -0,0 +1,276 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "row_kernels.h"
+
+namespace Navtech::Row_kernels {
+
+#if defined(__SSE2__)
+    // Maximum of each pair of bytes in a and b, packed into one register
+    //
+    static inline __m128i max_pairs(__m128i a, __m128i b)
+    {
+        const auto low_bytes = _mm_set1_epi16(0x00ff);
+
+        auto max_a = _mm_max_epu8(_mm_and_si128(a, low_bytes), _mm_srli_epi16(a, 8));
+        auto max_b = _mm_max_epu8(_mm_and_si128(b, low_bytes), _mm_srli_epi16(b, 8));
+        return _mm_packus_epi16(max_a, max_b);
+    }
+
+
+    // Sum of each pair of bytes, as 16-bit values
+    //
+    static inline __m128i sum_pairs(__m128i a)
+    {
+        const auto low_bytes = _mm_set1_epi16(0x00ff);
+        return _mm_add_epi16(_mm_and_si128(a, low_bytes), _mm_srli_epi16(a, 8));
+    }
+#endif
+
+
+    // Scalar reduction of the groups from first_group onwards
+    //
+    template <typename Reduce_fn>
+    static void reduce_tail(const std::uint8_t* in,
+                            std::size_t size,
+                            std::uint8_t* out,
+                            std::uint16_t factor,
+                            std::size_t first_group,
+                            Reduce_fn reduce)
+    {
+        for (auto start = first_group * factor; start < size; start += factor) {
+            auto count          = std::min<std::size_t>(factor, size - start);
+            out[start / factor] = reduce(in + start, count);
+        }
+    }
+
+
+    void blend(const std::uint8_t* first,
+               const std::uint8_t* second,
+               std::uint8_t* out,
+               std::size_t size,
+               std::uint16_t weight)
+    {
+        if (weight == 0) {
+            std::memcpy(out, first, size);
+            return;
+        }
+        if (weight >= 256) {
+            std::memcpy(out, second, size);
+            return;
+        }
+
+        auto first_weight = static_cast<std::uint16_t>(256 - weight);
+        std::size_t n     = 0;
+
+#if defined(__SSE2__)
+        const auto zero  = _mm_setzero_si128();
+        const auto w1    = _mm_set1_epi16(static_cast<std::int16_t>(first_weight));
+        const auto w2    = _mm_set1_epi16(static_cast<std::int16_t>(weight));
+        const auto round = _mm_set1_epi16(128);
+
+        for (; n + 16 <= size; n += 16) {
+            auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + n));
+            auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + n));
+
+            auto lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), w1),
+                                    _mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), w2));
+            auto hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), w1),
+                                    _mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), w2));
+
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, round), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, round), 8);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + n), _mm_packus_epi16(lo, hi));
+        }
+#elif defined(__ARM_NEON)
+        const auto w1 = vdup_n_u8(static_cast<std::uint8_t>(first_weight));
+        const auto w2 = vdup_n_u8(static_cast<std::uint8_t>(weight));
+
+        for (; n + 16 <= size; n += 16) {
+            auto a = vld1q_u8(first + n);
+            auto b = vld1q_u8(second + n);
+
+            auto lo = vmlal_u8(vmull_u8(vget_low_u8(a), w1), vget_low_u8(b), w2);
+            auto hi = vmlal_u8(vmull_u8(vget_high_u8(a), w1), vget_high_u8(b), w2);
+
+            vst1q_u8(out + n, vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8)));
+        }
+#endif
+
+        for (; n < size; ++n) {
+            out[n] = static_cast<std::uint8_t>((first[n] * first_weight + second[n] * weight + 128) >> 8);
+        }
+    }
+
+
+    void reduce_max(const std::uint8_t* in, std::size_t size, std::uint8_t* out, std::uint16_t factor)
+    {
+        if (factor <= 1) {
+            std::memcpy(out, in, size);
+            return;
+        }
+
+        std::size_t groups = 0;
+
+#if defined(__SSE2__)
+        if (factor == 2) {
+            for (; (groups + 16) * 2 <= size; groups += 16) {
+                auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + groups * 2));
+                auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + groups * 2 + 16));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + groups), max_pairs(a, b));
+            }
+        }
+        else if (factor == 4) {
+            for (; (groups + 16) * 4 <= size; groups += 16) {
+                auto src = reinterpret_cast<const __m128i*>(in + groups * 4);
+                auto ab  = max_pairs(_mm_loadu_si128(src), _mm_loadu_si128(src + 1));
+                auto cd  = max_pairs(_mm_loadu_si128(src + 2), _mm_loadu_si128(src + 3));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + groups), max_pairs(ab, cd));
+            }
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        if (factor == 2) {
+            for (; (groups + 16) * 2 <= size; groups += 16) {
+                auto src = in + groups * 2;
+                vst1q_u8(out + groups, vpmaxq_u8(vld1q_u8(src), vld1q_u8(src + 16)));
+            }
+        }
+        else if (factor == 4) {
+            for (; (groups + 16) * 4 <= size; groups += 16) {
+                auto src = in + groups * 4;
+                auto ab  = vpmaxq_u8(vld1q_u8(src), vld1q_u8(src + 16));
+                auto cd  = vpmaxq_u8(vld1q_u8(src + 32), vld1q_u8(src + 48));
+                vst1q_u8(out + groups, vpmaxq_u8(ab, cd));
+            }
+        }
+#endif
+
+        reduce_tail(in, size, out, factor, groups, [](const std::uint8_t* group, std::size_t count) {
+            return *std::max_element(group, group + count);
+        });
+    }
+
+
+    void reduce_mean(const std::uint8_t* in, std::size_t size, std::uint8_t* out, std::uint16_t factor)
+    {
+        if (factor <= 1) {
+            std::memcpy(out, in, size);
+            return;
+        }
+
+        std::size_t groups = 0;
+
+#if defined(__SSE2__)
+        if (factor == 2) {
+            const auto one = _mm_set1_epi16(1);
+
+            for (; (groups + 16) * 2 <= size; groups += 16) {
+                auto src = reinterpret_cast<const __m128i*>(in + groups * 2);
+                auto a   = _mm_srli_epi16(_mm_add_epi16(sum_pairs(_mm_loadu_si128(src)), one), 1);
+                auto b   = _mm_srli_epi16(_mm_add_epi16(sum_pairs(_mm_loadu_si128(src + 1)), one), 1);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + groups), _mm_packus_epi16(a, b));
+            }
+        }
+        else if (factor == 4) {
+            const auto ones = _mm_set1_epi16(1);
+            const auto two  = _mm_set1_epi32(2);
+
+            for (; (groups + 16) * 4 <= size; groups += 16) {
+                auto src = reinterpret_cast<const __m128i*>(in + groups * 4);
+                __m128i means[4];
+                for (auto i = 0; i < 4; ++i) {
+                    auto sums = _mm_madd_epi16(sum_pairs(_mm_loadu_si128(src + i)), ones);
+                    means[i]  = _mm_srli_epi32(_mm_add_epi32(sums, two), 2);
+                }
+                auto low  = _mm_packs_epi32(means[0], means[1]);
+                auto high = _mm_packs_epi32(means[2], means[3]);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + groups), _mm_packus_epi16(low, high));
+            }
+        }
+#elif defined(__ARM_NEON)
+        if (factor == 2) {
+            for (; (groups + 8) * 2 <= size; groups += 8) {
+                vst1_u8(out + groups, vrshrn_n_u16(vpaddlq_u8(vld1q_u8(in + groups * 2)), 1));
+            }
+        }
+        else if (factor == 4) {
+            for (; (groups + 8) * 4 <= size; groups += 8) {
+                auto src = in + groups * 4;
+                auto a   = vrshrn_n_u32(vpaddlq_u16(vpaddlq_u8(vld1q_u8(src))), 2);
+                auto b   = vrshrn_n_u32(vpaddlq_u16(vpaddlq_u8(vld1q_u8(src + 16))), 2);
+                vst1_u8(out + groups, vmovn_u16(vcombine_u16(a, b)));
+            }
+        }
+#endif
+
+        reduce_tail(in, size, out, factor, groups, [](const std::uint8_t* group, std::size_t count) {
+            std::uint32_t sum = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                sum += group[i];
+            }
+            return static_cast<std::uint8_t>((sum + count / 2) / count);
+        });
+    }
+
+
+    void clip(std::uint8_t* row, std::size_t size, std::size_t keep)
+    {
+        if (keep >= size) return;
+
+        auto n = keep & ~std::size_t { 15 };
+
+#if defined(__SSE2__)
+        if (n + 16 <= size) {
+            const auto lanes = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+            const auto mask  = _mm_cmplt_epi8(lanes, _mm_set1_epi8(static_cast<char>(keep - n)));
+            const auto zero  = _mm_setzero_si128();
+
+            auto boundary = reinterpret_cast<__m128i*>(row + n);
+            _mm_storeu_si128(boundary, _mm_and_si128(_mm_loadu_si128(boundary), mask));
+
+            for (n += 16; n + 16 <= size; n += 16) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(row + n), zero);
+            }
+        }
+        else {
+            n = keep;
+        }
+#elif defined(__ARM_NEON)
+        if (n + 16 <= size) {
+            static const std::uint8_t lane_index[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+            const auto mask = vcltq_u8(vld1q_u8(lane_index), vdupq_n_u8(static_cast<std::uint8_t>(keep - n)));
+            const auto zero = vdupq_n_u8(0);
+
+            vst1q_u8(row + n, vandq_u8(vld1q_u8(row + n), mask));
+
+            for (n += 16; n + 16 <= size; n += 16) {
+                vst1q_u8(row + n, zero);
+            }
+        }
+        else {
+            n = keep;
+        }
+#else
+        n = keep;
+#endif
+
+        for (; n < size; ++n) {
+            row[n] = 0;
+        }
+    }
+
+} // namespace Navtech::Row_kernels
@@ -0,0 +1,46 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef ROW_KERNELS_H
+#define ROW_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// --------------------------------------------------------------------------------------------------
+// Operations on rows of 8-bit FFT samples. Each kernel has an SSE2 (x86-64)
+// or NEON (AArch64) implementation, selected at compile time, and a scalar
+// fallback that gives identical results.
+//
+namespace Navtech::Row_kernels {
+
+    // Linear interpolation between two rows:
+    //   out[n] = (first[n] * (256 - weight) + second[n] * weight + 128) / 256
+    // weight is in the range [0, 256].
+    //
+    void blend(const std::uint8_t* first,
+               const std::uint8_t* second,
+               std::uint8_t* out,
+               std::size_t size,
+               std::uint16_t weight);
+
+    // Range binning: each output sample is the maximum, or the rounded
+    // mean, of factor consecutive input samples. The last group may be
+    // shorter than factor. out must hold (size + factor - 1) / factor
+    // samples. Factors of 2 and 4 are vectorised.
+    //
+    void reduce_max(const std::uint8_t* in, std::size_t size, std::uint8_t* out, std::uint16_t factor);
+    void reduce_mean(const std::uint8_t* in, std::size_t size, std::uint8_t* out, std::uint16_t factor);
+
+    // Zero samples keep to (size - 1) of row. The vector holding the
+    // boundary is masked and stored whole; the rest is zeroed a vector at
+    // a time.
+    //
+    void clip(std::uint8_t* row, std::size_t size, std::size_t keep);
+
+} // namespace Navtech::Row_kernels
+
+#endif // ROW_KERNELS_H
@@ -0,0 +1,148 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <algorithm>
+
+#include "../common.h"
+#include "staring_integrator.h"
+
+namespace Navtech {
+
+    void Staring_integrator::set_profile(const Staring_profile& new_profile)
+    {
+        std::lock_guard lock { profile_mutex };
+        requested = new_profile;
+    }
+
+
+    void Staring_integrator::set_pool_size(std::size_t frame_count)
+    {
+        std::lock_guard lock { profile_mutex };
+        pool_size = std::max<std::size_t>(frame_count, 1);
+    }
+
+
+    void Staring_integrator::configure(std::uint16_t range_in_bins,
+                                       std::uint16_t encoder_size,
+                                       const Region_of_interest& roi)
+    {
+        std::size_t frames = 0;
+        {
+            std::lock_guard lock { profile_mutex };
+            profile = requested;
+            frames  = pool_size;
+        }
+        profile.window_length = std::max<std::uint16_t>(profile.window_length, 1);
+
+        bins      = roi.bins(range_in_bins);
+        first_bin = roi.first_bin(range_in_bins);
+
+        window.configure(bins, profile.window_length, profile.mode);
+        pool = allocate_owned<Rotation_frame_pool>(
+            frames, std::uint16_t { 1 }, bins, encoder_size, Page_size::standard);
+
+        Log("Staring_integrator - Window [" + std::to_string(profile.window_length) + "] FFTs, flush every [" +
+            std::to_string(profile.flush_interval.count()) + "] ms");
+
+        reset();
+    }
+
+
+    void Staring_integrator::reset()
+    {
+        window.reset();
+        continuity = Continuity_counters {};
+        timing     = false;
+    }
+
+
+    void Staring_integrator::set_callback(std::function<void(const Rotation_frame_handle&)> fn)
+    {
+        std::lock_guard lock { callback_mutex };
+        callback     = std::move(fn);
+        callback_set = (callback != nullptr);
+    }
+
+
+    void Staring_integrator::add(const Azimuth_record& record, const std::uint8_t* data, std::size_t size)
+    {
+        add(record, data, size, std::chrono::steady_clock::now());
+    }
+
+
+    void Staring_integrator::add(const Azimuth_record& record,
+                                 const std::uint8_t* data,
+                                 std::size_t size,
+                                 std::chrono::steady_clock::time_point now)
+    {
+        if (!pool || bins == 0) return;
+
+        window.add(data, size);
+        newest = record;
+
+        ++continuity.azimuths_received;
+        if (record.continuity.missing_before > 0) {
+            ++continuity.gaps;
+            continuity.azimuths_missing += record.continuity.missing_before;
+        }
+        if (record.continuity.duplicate) ++continuity.azimuths_duplicated;
+        if (record.continuity.sweep_discontinuity) ++continuity.sweep_discontinuities;
+
+        if (!timing) {
+            timing     = true;
+            last_flush = now;
+        }
+        poll(now);
+    }
+
+
+    bool Staring_integrator::poll()
+    {
+        return poll(std::chrono::steady_clock::now());
+    }
+
+
+    bool Staring_integrator::poll(std::chrono::steady_clock::time_point now)
+    {
+        if (now < next_flush()) return false;
+
+        last_flush = now;
+        flush();
+        return true;
+    }
+
+
+    std::chrono::steady_clock::time_point Staring_integrator::next_flush() const
+    {
+        if (!pool || continuity.azimuths_received == 0) return std::chrono::steady_clock::time_point::max();
+        return last_flush + profile.flush_interval;
+    }
+
+
+    void Staring_integrator::flush()
+    {
+        if (!pool || continuity.azimuths_received == 0) return;
+
+        auto frame = pool->acquire();
+        if (!frame) {
+            ++dropped;
+            return;
+        }
+
+        auto& out = frame.writable();
+        window.result(out.row(0));
+
+        out.first_bin(first_bin);
+        out.mark(0, newest);
+        out.continuity(continuity);
+        out.rotation(++delivered);
+        continuity = Continuity_counters {};
+
+        std::lock_guard lock { callback_mutex };
+        if (callback != nullptr) callback(frame);
+    }
+
+} // namespace Navtech
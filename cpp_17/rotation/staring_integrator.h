@@ -0,0 +1,127 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef STARING_INTEGRATOR_H
+#define STARING_INTEGRATOR_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+#include "../utility/pointer_types.h"
+#include "continuity_tracker.h"
+#include "region_of_interest.h"
+#include "rotation_frame.h"
+#include "rotation_frame_pool.h"
+#include "temporal_integrator.h"
+
+namespace Navtech {
+
+    // The last window_length FFTs are integrated, bin by bin; see
+    // Temporal_integrator. A product is delivered every flush_interval; a
+    // zero interval delivers one for every FFT.
+    //
+    struct Staring_profile
+    {
+        std::uint16_t window_length { 16 };
+        Integration_mode mode { Integration_mode::mean };
+        std::chrono::milliseconds flush_interval { 100 };
+    };
+
+
+    // --------------------------------------------------------------------------------------------------
+    // The staring-mode counterpart of the Rotation_assembler. A staring
+    // radar sends a continuous sequence of FFTs at one bearing, so there is
+    // no rotation wrap to complete a frame. Instead, each FFT is added to a
+    // sliding window and the integrated window is delivered on a timer.
+    //
+    // Products are single-row Rotation_frames from a pool: row 0 is the
+    // integrated window, record(0) is the newest FFT in it and rotation()
+    // counts products. The frame's continuity() covers the FFTs received
+    // since the previous product. If every frame is held, the product is
+    // discarded and counted in products_dropped().
+    //
+    // The window and the pool are allocated by configure(); add() does
+    // not allocate. Only the region's range window
+    // is used; staring radars have no azimuth sector.
+    //
+    // add() and configure() must be called from the same thread, which is
+    // also the thread the callback is called on.
+    //
+    class Staring_integrator {
+    public:
+        Staring_integrator() = default;
+
+        Staring_integrator(const Staring_integrator&) = delete;
+        Staring_integrator& operator=(const Staring_integrator&) = delete;
+
+        // Both take effect at the next configure()
+        //
+        void set_profile(const Staring_profile& profile);
+        void set_pool_size(std::size_t frame_count);
+
+        void configure(std::uint16_t range_in_bins,
+                       std::uint16_t encoder_size,
+                       const Region_of_interest& roi = Region_of_interest {});
+        void reset();
+
+        // data is the region's range window of the FFT
+        //
+        void add(const Azimuth_record& record, const std::uint8_t* data, std::size_t size);
+        void add(const Azimuth_record& record,
+                 const std::uint8_t* data,
+                 std::size_t size,
+                 std::chrono::steady_clock::time_point now);
+
+        // add() only delivers a product when an FFT arrives. If FFTs stop,
+        // those added since the last product are delivered by poll(), once
+        // the flush interval has passed, or at once by flush(). Neither
+        // does anything if no FFT has been added since the last product.
+        // Call them on the thread that calls add(); poll() returns true if
+        // it delivered (or dropped) a product. next_flush() is the time
+        // poll() next has something to deliver.
+        //
+        bool poll();
+        bool poll(std::chrono::steady_clock::time_point now);
+        void flush();
+        std::chrono::steady_clock::time_point next_flush() const;
+
+        void set_callback(std::function<void(const Rotation_frame_handle&)> fn = nullptr);
+        bool has_callback() const { return callback_set; }
+
+        std::uint64_t products_delivered() const { return delivered; }
+        std::uint64_t products_dropped() const { return dropped; }
+
+    private:
+        std::mutex profile_mutex;
+        Staring_profile requested {};
+        Staring_profile profile {};
+        std::size_t pool_size { default_rotation_pool_size };
+
+        Owner_of<Rotation_frame_pool> pool {};
+        std::uint16_t bins { 0 };
+        std::uint16_t first_bin { 0 };
+
+        Temporal_integrator window {};
+        Azimuth_record newest {};
+        Continuity_counters continuity {};
+
+        bool timing { false };
+        std::chrono::steady_clock::time_point last_flush {};
+
+        std::atomic<std::uint64_t> delivered { 0 };
+        std::atomic<std::uint64_t> dropped { 0 };
+
+        std::mutex callback_mutex;
+        std::function<void(const Rotation_frame_handle&)> callback = nullptr;
+        std::atomic_bool callback_set { false };
+    };
+
+} // namespace Navtech
+
+#endif // STARING_INTEGRATOR_H
@@ -0,0 +1,261 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "power_codes.h"
+#include "temporal_integrator.h"
+
+namespace Navtech {
+
+    using Power_codes::half_db;
+    using Power_codes::linear_power;
+
+
+    void Temporal_integrator::configure(std::size_t cells,
+                                        std::uint16_t window_length,
+                                        Integration_mode mode,
+                                        Integration_window window)
+    {
+        cell_count  = cells;
+        length      = std::max<std::uint16_t>(window_length, 1);
+        integration = mode;
+        windowing   = window;
+        slots       = (windowing == Integration_window::sliding) ? length : 1;
+
+        ring.assign(static_cast<std::size_t>(slots) * cell_count, 0);
+        sums.clear();
+        power_sums.clear();
+        head_max.clear();
+        tail_max.clear();
+
+        switch (integration) {
+            case Integration_mode::mean:
+                sums.resize(cell_count);
+                break;
+            case Integration_mode::power_mean:
+                power_sums.resize(cell_count);
+                break;
+            case Integration_mode::max:
+                head_max.resize(cell_count);
+                if (windowing == Integration_window::sliding) tail_max.resize(ring.size());
+                break;
+        }
+
+        reset();
+    }
+
+
+    void Temporal_integrator::reset()
+    {
+        clear_window();
+        std::fill(tail_max.begin(), tail_max.end(), 0);
+        next_slot = 0;
+        pending   = false;
+    }
+
+
+    void Temporal_integrator::clear_window()
+    {
+        std::fill(sums.begin(), sums.end(), 0);
+        std::fill(power_sums.begin(), power_sums.end(), 0.0);
+        std::fill(head_max.begin(), head_max.end(), 0);
+        rows_filled = 0;
+    }
+
+
+    std::uint8_t* Temporal_integrator::next_row()
+    {
+        if (pending) return slot(next_slot);
+        pending = true;
+
+        if (windowing == Integration_window::block) {
+            if (rows_filled == length) clear_window();
+            return slot(next_slot);
+        }
+
+        // The oldest row leaves the sums before it is overwritten. Its
+        // contribution to the max is already held in tail_max.
+        //
+        if (rows_filled == length) {
+            auto oldest = slot(next_slot);
+            if (integration == Integration_mode::mean) {
+                for (std::size_t cell = 0; cell < cell_count; ++cell) {
+                    sums[cell] -= oldest[cell];
+                }
+            }
+            else if (integration == Integration_mode::power_mean) {
+                for (std::size_t cell = 0; cell < cell_count; ++cell) {
+                    power_sums[cell] -= linear_power(oldest[cell]);
+                }
+            }
+        }
+        return slot(next_slot);
+    }
+
+
+    bool Temporal_integrator::commit()
+    {
+        if (!pending) return false;
+        pending = false;
+
+        auto row = slot(next_slot);
+        switch (integration) {
+            case Integration_mode::mean:
+                for (std::size_t cell = 0; cell < cell_count; ++cell) {
+                    sums[cell] += row[cell];
+                }
+                break;
+            case Integration_mode::power_mean:
+                for (std::size_t cell = 0; cell < cell_count; ++cell) {
+                    power_sums[cell] += linear_power(row[cell]);
+                }
+                break;
+            case Integration_mode::max:
+                for (std::size_t cell = 0; cell < cell_count; ++cell) {
+                    head_max[cell] = std::max(head_max[cell], row[cell]);
+                }
+                break;
+        }
+
+        if (rows_filled < length) ++rows_filled;
+
+        if (windowing == Integration_window::sliding) {
+            next_slot = static_cast<std::uint16_t>((next_slot + 1) % length);
+            if (next_slot == 0) complete_block();
+        }
+        return rows_filled == length;
+    }
+
+
+    bool Temporal_integrator::add(const std::uint8_t* row, std::size_t size)
+    {
+        auto dest  = next_row();
+        auto count = std::min(size, cell_count);
+
+        std::memcpy(dest, row, count);
+        std::memset(dest + count, 0, cell_count - count);
+        return commit();
+    }
+
+
+    // Every slot now holds a row of the block just completed, which
+    // becomes the tail of the window from the next row on
+    //
+    void Temporal_integrator::complete_block()
+    {
+        if (integration == Integration_mode::max) {
+            auto last = static_cast<std::uint16_t>(length - 1);
+            std::memcpy(tail_max.data() + last * cell_count, slot(last), cell_count);
+
+            for (auto n = last; n-- > 0;) {
+                auto row    = slot(n);
+                auto suffix = tail_max.data() + (n + 1) * cell_count;
+                auto dest   = tail_max.data() + n * cell_count;
+                for (std::size_t cell = 0; cell < cell_count; ++cell) {
+                    dest[cell] = std::max(row[cell], suffix[cell]);
+                }
+            }
+            std::fill(head_max.begin(), head_max.end(), 0);
+        }
+        else if (integration == Integration_mode::power_mean) {
+            sum_powers();
+        }
+    }
+
+
+    // Recalculate the power sums from the ring, so that rounding errors
+    // from the running sums do not build up
+    //
+    void Temporal_integrator::sum_powers()
+    {
+        std::fill(power_sums.begin(), power_sums.end(), 0.0);
+        for (std::uint16_t n = 0; n < slots; ++n) {
+            auto row = slot(n);
+            for (std::size_t cell = 0; cell < cell_count; ++cell) {
+                power_sums[cell] += linear_power(row[cell]);
+            }
+        }
+    }
+
+
+    void Temporal_integrator::result(std::uint8_t* out, std::size_t first_cell, std::size_t count) const
+    {
+        count = std::min(count, cell_count - std::min(first_cell, cell_count));
+
+        if (rows_filled == 0) {
+            std::memset(out, 0, count);
+            return;
+        }
+
+        switch (integration) {
+            case Integration_mode::mean: {
+                auto sum  = sums.data() + first_cell;
+                auto half = rows_filled / 2u;
+                for (std::size_t cell = 0; cell < count; ++cell) {
+                    out[cell] = static_cast<std::uint8_t>((sum[cell] + half) / rows_filled);
+                }
+                break;
+            }
+            case Integration_mode::power_mean: {
+                auto sum = power_sums.data() + first_cell;
+                for (std::size_t cell = 0; cell < count; ++cell) {
+                    auto value = std::round(half_db(sum[cell] / rows_filled));
+                    out[cell]  = static_cast<std::uint8_t>(std::clamp(value, 0.0, 255.0));
+                }
+                break;
+            }
+            case Integration_mode::max: {
+                auto head = head_max.data() + first_cell;
+                if (windowing == Integration_window::block) {
+                    std::memcpy(out, head, count);
+                    break;
+                }
+                auto tail = tail_max.data() + next_slot * cell_count + first_cell;
+                for (std::size_t cell = 0; cell < count; ++cell) {
+                    out[cell] = std::max(head[cell], tail[cell]);
+                }
+                break;
+            }
+        }
+    }
+
+
+    void Temporal_integrator::result(double* out) const
+    {
+        if (rows_filled == 0) {
+            std::fill(out, out + cell_count, 0.0);
+            return;
+        }
+
+        switch (integration) {
+            case Integration_mode::mean:
+                for (std::size_t cell = 0; cell < cell_count; ++cell) {
+                    out[cell] = static_cast<double>(sums[cell]) / rows_filled;
+                }
+                break;
+            case Integration_mode::power_mean:
+                for (std::size_t cell = 0; cell < cell_count; ++cell) {
+                    out[cell] = half_db(power_sums[cell] / rows_filled);
+                }
+                break;
+            case Integration_mode::max: {
+                if (windowing == Integration_window::block) {
+                    std::copy(head_max.begin(), head_max.end(), out);
+                    break;
+                }
+                auto tail = tail_max.data() + next_slot * cell_count;
+                for (std::size_t cell = 0; cell < cell_count; ++cell) {
+                    out[cell] = std::max(head_max[cell], tail[cell]);
+                }
+                break;
+            }
+        }
+    }
+
+} // namespace Navtech
@@ -0,0 +1,116 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef TEMPORAL_INTEGRATOR_H
+#define TEMPORAL_INTEGRATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Navtech {
+
+    // - mean and max combine the half-dB samples directly.
+    // - power_mean averages in linear power, 10^(sample / 20), and gives
+    //   the result back in half-dB units.
+    //
+    enum class Integration_mode { mean, max, power_mean };
+
+    // A sliding window integrates the latest window_length rows, and has
+    // a result after every row once it is full. A block window has a
+    // result after every window_length rows, then starts again.
+    //
+    enum class Integration_window { sliding, block };
+
+
+    // --------------------------------------------------------------------------------------------------
+    // Integrates a stream of uint8 rows, cell by cell, over a window of
+    // rows: consecutive FFTs at one bearing, or consecutive rotations of
+    // a whole frame.
+    //
+    // The window is a fixed ring of rows, allocated by configure(). Each
+    // row costs O(cells), whatever the window length:
+    // - mean and power_mean keep running sums, removing the oldest row as
+    //   it is overwritten. Samples are converted to linear power through a
+    //   table of the 256 codes, and results back to half-dB by a fast log.
+    // - A sliding max splits the ring into blocks of window_length rows.
+    //   The window is the tail of the previous block, whose suffix maxima
+    //   are computed once as the block completes, plus the head of the
+    //   current one, whose maximum is kept as rows arrive.
+    //
+    // Rows are written in place: fill next_row(), then commit() it. add()
+    // does both for a contiguous row.
+    //
+    class Temporal_integrator {
+    public:
+        Temporal_integrator() = default;
+
+        void configure(std::size_t cells,
+                       std::uint16_t window_length,
+                       Integration_mode mode,
+                       Integration_window window = Integration_window::sliding);
+        void reset();
+
+        // The cells of the row being added. Its contents are undefined;
+        // every cell must be written before commit().
+        //
+        std::uint8_t* next_row();
+
+        // Returns true if there is a result for a full window
+        //
+        bool commit();
+        bool add(const std::uint8_t* row, std::size_t size);
+
+        // The integrated window, which may be part-filled. The uint8
+        // result is rounded; the double result is not.
+        //
+        void result(std::uint8_t* out, std::size_t first_cell, std::size_t count) const;
+        void result(std::uint8_t* out) const { result(out, 0, cell_count); }
+        void result(double* out) const;
+
+        std::size_t cells() const { return cell_count; }
+        std::uint16_t window_length() const { return length; }
+        std::uint16_t rows() const { return rows_filled; }
+        bool full() const { return length > 0 && rows_filled == length; }
+
+        Integration_mode mode() const { return integration; }
+        Integration_window window() const { return windowing; }
+
+    private:
+        std::size_t cell_count { 0 };
+        std::uint16_t length { 0 };
+        Integration_mode integration { Integration_mode::mean };
+        Integration_window windowing { Integration_window::sliding };
+
+        // window_length rows for a sliding window. A block window only
+        // needs the row being added.
+        //
+        std::vector<std::uint8_t> ring {};
+        std::uint16_t slots { 0 };
+        std::uint16_t next_slot { 0 };
+        std::uint16_t rows_filled { 0 };
+        bool pending { false };
+
+        std::vector<std::uint32_t> sums {};
+        std::vector<double> power_sums {};
+
+        // Sliding max: maxima of the current block so far, and of each
+        // suffix of the previous block
+        //
+        std::vector<std::uint8_t> head_max {};
+        std::vector<std::uint8_t> tail_max {};
+
+        std::uint8_t* slot(std::uint16_t n) { return ring.data() + n * cell_count; }
+        const std::uint8_t* slot(std::uint16_t n) const { return ring.data() + n * cell_count; }
+
+        void clear_window();
+        void complete_block();
+        void sum_powers();
+    };
+
+} // namespace Navtech
+
+#endif // TEMPORAL_INTEGRATOR_H
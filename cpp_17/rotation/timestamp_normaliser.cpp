@@ -0,0 +1,174 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#include "timestamp_normaliser.h"
+
+namespace Navtech {
+
+    void Timestamp_normaliser::configure(std::uint16_t encoder_size, std::uint32_t rotation_rate)
+    {
+        // One rotation takes (1000 / rotation_rate) seconds
+        //
+        encoder         = encoder_size;
+        rotation_period = (rotation_rate > 0) ? (1000LL * nanoseconds_per_second) / rotation_rate : 0;
+        reset();
+    }
+
+
+    void Timestamp_normaliser::reset()
+    {
+        first = true;
+    }
+
+
+    std::chrono::nanoseconds Timestamp_normaliser::step_tolerance() const
+    {
+        return std::chrono::nanoseconds { tolerance.load(std::memory_order_relaxed) };
+    }
+
+
+    void Timestamp_normaliser::step_tolerance(std::chrono::nanoseconds new_tolerance)
+    {
+        tolerance = new_tolerance.count();
+    }
+
+
+    Radar_time Timestamp_normaliser::normalise(std::uint16_t azimuth,
+                                               std::uint32_t ntp_seconds,
+                                               std::uint32_t ntp_split_seconds)
+    {
+        increment(timestamps);
+
+        auto encoder_size = encoder.load(std::memory_order_relaxed);
+        auto position     = (encoder_size > 0) ? static_cast<std::uint16_t>(azimuth % encoder_size) : azimuth;
+        auto has_time     = is_valid_timestamp(ntp_seconds, ntp_split_seconds);
+        auto time         = has_time ? to_radar_time(ntp_seconds, ntp_split_seconds) : Radar_time {};
+
+        if (first) {
+            if (!has_time) return time;
+
+            first        = false;
+            last_azimuth = position;
+            last_time    = time;
+            return time;
+        }
+
+        auto turned   = (encoder_size > 0) ? (position + encoder_size - last_azimuth) % encoder_size : 0u;
+        auto expected = turn_time(turned, encoder_size);
+
+        if (!has_time || (time == last_time && turned != 0)) {
+            increment(interpolated);
+            time = last_time + expected;
+        }
+        else if (is_step(time - last_time, expected)) {
+            increment(steps);
+        }
+
+        last_azimuth = position;
+        last_time    = time;
+        return time;
+    }
+
+
+    bool Timestamp_normaliser::normalise(const Rotation_frame& frame,
+                                         std::vector<Radar_time>& out,
+                                         std::uint16_t first_row) const
+    {
+        std::uint32_t rows = frame.azimuth_samples();
+        out.assign(rows, Radar_time {});
+        if (rows == 0) return false;
+
+        auto row_at = [&](std::uint32_t position) { return (first_row + position) % rows; };
+
+        // Positions between two good timestamps are interpolated between
+        // them, unless there was a step in between; then they follow on
+        // from the earlier one. Positions before the first good timestamp
+        // lead up to it.
+        //
+        auto fill_gap = [&](std::int32_t before, std::uint32_t after) {
+            auto after_time = out[row_at(after)];
+
+            if (before < 0) {
+                for (std::uint32_t position = 0; position < after; ++position) {
+                    out[row_at(position)] = after_time - turn_time(after - position, rows);
+                }
+                return;
+            }
+
+            auto before_time = out[row_at(before)];
+            auto span        = after - before;
+            auto step        = is_step(after_time - before_time, turn_time(span, rows));
+
+            for (auto position = before + 1u; position < after; ++position) {
+                auto offset = position - before;
+                if (step) {
+                    out[row_at(position)] = before_time + turn_time(offset, rows);
+                }
+                else {
+                    out[row_at(position)] = before_time + (after_time - before_time) * offset / span;
+                }
+            }
+        };
+
+        std::int32_t previous = -1;
+
+        for (std::uint32_t position = 0; position < rows; ++position) {
+            auto row = row_at(position);
+            if (!frame.is_valid(row)) continue;
+
+            auto& record = frame.record(row);
+            if (!is_valid_timestamp(record.ntp_seconds, record.ntp_split_seconds)) continue;
+
+            auto time = to_radar_time(record.ntp_seconds, record.ntp_split_seconds);
+            if (previous >= 0 && time == out[row_at(previous)]) continue;
+
+            out[row] = time;
+            fill_gap(previous, position);
+            previous = static_cast<std::int32_t>(position);
+        }
+
+        if (previous < 0) return false;
+
+        auto last_time = out[row_at(previous)];
+        for (auto position = previous + 1u; position < rows; ++position) {
+            out[row_at(position)] = last_time + turn_time(position - previous, rows);
+        }
+        return true;
+    }
+
+
+    Timestamp_counters Timestamp_normaliser::counters() const
+    {
+        Timestamp_counters result {};
+        result.timestamps   = timestamps.load(std::memory_order_relaxed);
+        result.interpolated = interpolated.load(std::memory_order_relaxed);
+        result.steps        = steps.load(std::memory_order_relaxed);
+        return result;
+    }
+
+
+    std::chrono::nanoseconds Timestamp_normaliser::turn_time(std::uint32_t azimuths, std::uint32_t per_rotation) const
+    {
+        if (per_rotation == 0) return std::chrono::nanoseconds { 0 };
+        return std::chrono::nanoseconds { rotation_period.load(std::memory_order_relaxed) * azimuths / per_rotation };
+    }
+
+
+    bool Timestamp_normaliser::is_step(std::chrono::nanoseconds actual, std::chrono::nanoseconds expected) const
+    {
+        if (rotation_period.load(std::memory_order_relaxed) == 0) return false;
+
+        auto error = (actual > expected) ? (actual - expected) : (expected - actual);
+        return error.count() > tolerance.load(std::memory_order_relaxed);
+    }
+
+
+    void Timestamp_normaliser::increment(std::atomic<std::uint64_t>& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+} // namespace Navtech
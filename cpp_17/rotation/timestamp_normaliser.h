@@ -0,0 +1,114 @@
+// Copyright 2016 Navtech Radar Limited
+// This file is part of iasdk which is released under The MIT License (MIT).
+// See file LICENSE.txt in project root or go to https://opensource.org/licenses/MIT
+// for full license details.
+//
+
+#ifndef TIMESTAMP_NORMALISER_H
+#define TIMESTAMP_NORMALISER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "rotation_frame.h"
+
+namespace Navtech {
+
+    // Radar timestamps are sent as seconds since the Unix epoch
+    // (ntp_seconds) and nanoseconds within that second (ntp_split_seconds).
+    //
+    using Radar_clock = std::chrono::system_clock;
+    using Radar_time  = std::chrono::time_point<Radar_clock, std::chrono::nanoseconds>;
+
+    constexpr std::uint32_t nanoseconds_per_second = 1000000000;
+
+    inline bool is_valid_timestamp(std::uint32_t ntp_seconds, std::uint32_t ntp_split_seconds)
+    {
+        return (ntp_seconds != 0 || ntp_split_seconds != 0) && ntp_split_seconds < nanoseconds_per_second;
+    }
+
+    inline Radar_time to_radar_time(std::uint32_t ntp_seconds, std::uint32_t ntp_split_seconds)
+    {
+        return Radar_time { std::chrono::seconds { ntp_seconds } + std::chrono::nanoseconds { ntp_split_seconds } };
+    }
+
+
+    struct Timestamp_counters
+    {
+        std::uint64_t timestamps { 0 };
+        std::uint64_t interpolated { 0 };
+        std::uint64_t steps { 0 };
+    };
+
+
+    // --------------------------------------------------------------------------------------------------
+    // Converts per-azimuth radar timestamps to Radar_time, repairing them
+    // from the expected rotation rate:
+    // - A missing timestamp (zero or malformed), or one that repeats the
+    //   previous timestamp on a different azimuth, is replaced by the
+    //   previous timestamp advanced by the time the antenna takes to turn
+    //   through the intervening azimuths.
+    // - A timestamp that differs from that prediction by more than the
+    //   step tolerance is an NTP step. It is kept, and counted, and later
+    //   azimuths are predicted from it.
+    // Without a rotation rate, missing timestamps repeat the previous one
+    // and steps are not detected.
+    //
+    // normalise(azimuth, ...) is for a stream of azimuths in arrival order
+    // and must be called from a single thread. normalise(frame, ...) does
+    // a whole rotation at once, interpolating between the timestamps either
+    // side of each gap; it has no state and may be called from any thread,
+    // as may counters().
+    //
+    class Timestamp_normaliser {
+    public:
+        Timestamp_normaliser() = default;
+
+        Timestamp_normaliser(const Timestamp_normaliser&) = delete;
+        Timestamp_normaliser& operator=(const Timestamp_normaliser&) = delete;
+
+        // rotation_rate is in milli-Hertz, as in the radar configuration.
+        //
+        void configure(std::uint16_t encoder_size, std::uint32_t rotation_rate);
+        void reset();
+
+        std::chrono::nanoseconds step_tolerance() const;
+        void step_tolerance(std::chrono::nanoseconds tolerance);
+
+        Radar_time normalise(std::uint16_t azimuth, std::uint32_t ntp_seconds, std::uint32_t ntp_split_seconds);
+
+        // Fills out with one timestamp per row of frame. Rows are taken in
+        // time order starting at first_row, which is the end of the sector
+        // for frames restricted to a Region_of_interest. Returns false, and
+        // leaves every timestamp at the epoch, if no row has a timestamp.
+        //
+        bool normalise(const Rotation_frame& frame, std::vector<Radar_time>& out, std::uint16_t first_row = 0) const;
+
+        Timestamp_counters counters() const;
+
+    private:
+        std::atomic<std::uint16_t> encoder { 0 };
+        std::atomic<std::int64_t> rotation_period { 0 };
+        std::atomic<std::int64_t> tolerance { 10000000 };
+
+        bool first { true };
+        std::uint16_t last_azimuth { 0 };
+        Radar_time last_time {};
+
+        // Only ever written by the normalising thread; see
+        // Continuity_tracker.
+        //
+        std::atomic<std::uint64_t> timestamps { 0 };
+        std::atomic<std::uint64_t> interpolated { 0 };
+        std::atomic<std::uint64_t> steps { 0 };
+
+        std::chrono::nanoseconds turn_time(std::uint32_t azimuths, std::uint32_t per_rotation) const;
+        bool is_step(std::chrono::nanoseconds actual, std::chrono::nanoseconds expected) const;
+        static void increment(std::atomic<std::uint64_t>& counter);
+    };
+
+} // namespace Navtech
+
+#endif // TIMESTAMP_NORMALISER_H
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <random>
+
+#include "../rotation/clock_offset_estimator.h"
+
+using namespace Navtech;
+using namespace std::chrono_literals;
+
+// A simulated radar whose clock runs behind the host's by offset, and
+// drifts by drift parts per million. Messages are sent at 100 Hz; each
+// takes the minimum latency plus 50 us to 2 ms, except every 50th, which
+// takes the minimum exactly. The jitter is more than the drift over a
+// window, so each window's minimum is one of the fastest messages. A
+// window closes with the first message a second after it opened, so
+// holds 101 messages.
+//
+class given_a_clock_offset_estimator : public ::testing::Test {
+protected:
+    static constexpr std::chrono::nanoseconds message_interval { 10ms };
+    static constexpr std::chrono::nanoseconds minimum_latency { 400us };
+
+    Clock_offset_estimator estimator {};
+    std::mt19937 random { 2856 };
+
+    const Radar_time host_start { 1700000000s };
+    Radar_time host_time { host_start };
+    std::chrono::nanoseconds offset { 3200ms };
+    double drift { 25.0 };
+
+    std::chrono::nanoseconds true_offset() const
+    {
+        auto elapsed = std::chrono::duration<double>(host_time - host_start).count();
+        return offset + std::chrono::nanoseconds { static_cast<std::int64_t>(drift * 1000.0 * elapsed) };
+    }
+
+    // Returns the number of windows closed
+    //
+    int run(std::chrono::nanoseconds duration)
+    {
+        std::uniform_int_distribution<std::int64_t> jitter { 50000, 2000000 };
+        auto closed = 0;
+
+        for (auto end = host_time + duration; host_time < end; host_time += message_interval) {
+            auto fastest = (host_time - host_start) % (message_interval * 50) == 0ns;
+            auto latency = minimum_latency + std::chrono::nanoseconds { fastest ? 0 : jitter(random) };
+            auto sent    = host_time - latency;
+
+            if (estimator.add(sent - true_offset(), host_time)) ++closed;
+        }
+        return closed;
+    }
+};
+
+
+TEST_F(given_a_clock_offset_estimator, WhenNoWindowHasClosedItShouldHaveNoEstimate)
+{
+    ASSERT_FALSE(estimator.add(host_time - offset, host_time));
+    ASSERT_FALSE(estimator.estimate().valid);
+    ASSERT_EQ(0ns, estimator.latency(host_time - offset, host_time + 1ms));
+}
+
+
+TEST_F(given_a_clock_offset_estimator, WhenTheClocksDriftItShouldEstimateTheDriftAndOffset)
+{
+    ASSERT_EQ(19, run(20s));
+
+    auto estimate = estimator.estimate();
+    ASSERT_TRUE(estimate.valid);
+    ASSERT_EQ(19u, estimate.windows);
+    ASSERT_EQ(19u * 101, estimate.messages);
+    ASSERT_NEAR(drift, estimate.drift, 0.001);
+
+    // The offset is given at the last window's minimum, which is within
+    // the last two seconds; over those the true offset moves by 50 us
+    //
+    auto expected = true_offset() + minimum_latency;
+    ASSERT_LE(estimate.offset, expected);
+    ASSERT_GE(estimate.offset, expected - 50us);
+    ASSERT_GE(estimate.mean_latency, 900us);
+    ASSERT_LE(estimate.mean_latency, 1100us);
+    ASSERT_LE(estimate.max_latency, 2000us);
+}
+
+
+TEST_F(given_a_clock_offset_estimator, WhenMeasuringAMessageItsLatencyShouldBeRelativeToTheFastest)
+{
+    run(10s);
+
+    auto sent = host_time - minimum_latency - 5ms;
+    ASSERT_NEAR(5000000, estimator.latency(sent - true_offset(), host_time).count(), 2000);
+
+    sent = host_time - minimum_latency;
+    ASSERT_NEAR(0, estimator.latency(sent - true_offset(), host_time).count(), 2000);
+}
+
+
+TEST_F(given_a_clock_offset_estimator, WhenMoreWindowsThanTheHistoryCloseTheOldestShouldBeDropped)
+{
+    run(40s);
+    ASSERT_EQ(32u, estimator.estimate().windows);
+    ASSERT_NEAR(drift, estimator.estimate().drift, 0.001);
+}
+
+
+TEST_F(given_a_clock_offset_estimator, WhenAClockIsSteppedTheFitShouldRestart)
+{
+    auto closed = run(10s);
+    ASSERT_EQ(closed, estimator.estimate().windows);
+
+    // The window open at the step closes with its minimum after it
+    //
+    offset -= 500ms;
+    closed = run(1100ms);
+
+    auto estimate = estimator.estimate();
+    ASSERT_EQ(1, closed);
+    ASSERT_EQ(1u, estimate.windows);
+    ASSERT_EQ(0.0, estimate.drift);
+    ASSERT_NEAR((true_offset() + minimum_latency).count(), estimate.offset.count(), 30000);
+
+    closed += run(10s);
+    ASSERT_EQ(closed, estimator.estimate().windows);
+    ASSERT_NEAR(drift, estimator.estimate().drift, 0.001);
+}
+
+
+TEST_F(given_a_clock_offset_estimator, WhenTheOffsetMovesWithinTheThresholdTheFitShouldNotRestart)
+{
+    auto closed = run(10s);
+
+    offset += 5ms;
+    closed += run(5s);
+    ASSERT_EQ(closed, estimator.estimate().windows);
+}
+
+
+TEST_F(given_a_clock_offset_estimator, WhenResetItShouldHaveNoEstimate)
+{
+    run(5s);
+    estimator.reset();
+
+    auto estimate = estimator.estimate();
+    ASSERT_FALSE(estimate.valid);
+    ASSERT_EQ(0u, estimate.messages);
+
+    ASSERT_EQ(2, run(2030ms));
+    ASSERT_EQ(2u, estimator.estimate().windows);
+    ASSERT_EQ(202u, estimator.estimate().messages);
+}
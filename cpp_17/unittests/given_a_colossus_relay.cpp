@@ -0,0 +1,307 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "../network/colossus_relay.h"
+
+using namespace Navtech;
+using namespace std::chrono_literals;
+using Network::Colossus_protocol::Message;
+using Message_type = Message::Type;
+
+// The relay is run on loopback, between a fake radar and fake clients,
+// each a plain blocking socket
+//
+class given_a_colossus_relay : public ::testing::Test {
+protected:
+    static std::vector<std::uint8_t> framed(Message_type type, const std::vector<std::uint8_t>& payload = {})
+    {
+        Message msg {};
+        msg.type(type);
+        if (!payload.empty()) msg.append(payload);
+        return msg.relinquish();
+    }
+
+    class Connection {
+    public:
+        explicit Connection(int socket = -1) : fd { socket } { }
+        Connection(Connection&& other) noexcept : fd { other.fd } { other.fd = -1; }
+        ~Connection()
+        {
+            if (fd != -1) ::close(fd);
+        }
+
+        static Connection to_loopback(std::uint16_t port)
+        {
+            Connection connection { ::socket(AF_INET, SOCK_STREAM, 0) };
+
+            sockaddr_in addr {};
+            addr.sin_family      = AF_INET;
+            addr.sin_port        = htons(port);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            if (::connect(connection.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1) return Connection {};
+            return connection;
+        }
+
+        Connection& operator=(Connection&& other) noexcept
+        {
+            std::swap(fd, other.fd);
+            return *this;
+        }
+
+        bool is_open() const { return fd != -1; }
+
+        void send(const std::vector<std::uint8_t>& data) const { ::send(fd, data.data(), data.size(), MSG_NOSIGNAL); }
+
+        void send(Message_type type, const std::vector<std::uint8_t>& payload = {}) const
+        {
+            send(framed(type, payload));
+        }
+
+        // The next whole message, or nothing if none arrives in time or the
+        // connection is closed
+        //
+        std::optional<std::vector<std::uint8_t>> receive(std::chrono::milliseconds timeout = 1000ms) const
+        {
+            std::vector<std::uint8_t> message(Message::header_size());
+            if (!read(message.data(), message.size(), timeout)) return std::nullopt;
+
+            Message header { message.data(), message.size() };
+            if (!header.is_valid()) return std::nullopt;
+
+            message.resize(Message::header_size() + header.payload_size());
+            if (!read(message.data() + Message::header_size(), header.payload_size(), timeout)) return std::nullopt;
+            return message;
+        }
+
+        std::optional<Message_type> receive_type(std::chrono::milliseconds timeout = 1000ms) const
+        {
+            auto message = receive(timeout);
+            if (!message) return std::nullopt;
+            return Message { *message }.type();
+        }
+
+        bool is_closed_by_peer() const
+        {
+            std::uint8_t byte {};
+            pollfd pfd { fd, POLLIN, 0 };
+            return ::poll(&pfd, 1, 1000) > 0 && ::recv(fd, &byte, 1, 0) == 0;
+        }
+
+    private:
+        int fd { -1 };
+
+        bool read(std::uint8_t* data, std::size_t size, std::chrono::milliseconds timeout) const
+        {
+            for (std::size_t done = 0; done < size;) {
+                pollfd pfd { fd, POLLIN, 0 };
+                if (::poll(&pfd, 1, static_cast<int>(timeout.count())) <= 0) return false;
+
+                auto received = ::recv(fd, data + done, size - done, 0);
+                if (received <= 0) return false;
+                done += received;
+            }
+            return true;
+        }
+    };
+
+    int radar_listener { -1 };
+    std::uint16_t radar_port { 0 };
+    std::uint16_t relay_port { 0 };
+    Connection radar {};
+    Owner_of<Colossus_relay> relay {};
+
+    void SetUp() override
+    {
+        radar_listener = listen_on_loopback(radar_port);
+        ASSERT_NE(-1, radar_listener);
+        open_relay();
+    }
+
+    // A relay, connected to the radar, which has sent its configuration
+    //
+    void open_relay(std::size_t max_queue_size = 800)
+    {
+        relay.reset();
+        radar = Connection {};
+
+        // Find a free port for the relay to listen on
+        //
+        ::close(listen_on_loopback(relay_port));
+
+        relay = allocate_owned<Colossus_relay>(
+            Utility::IP_address { "127.0.0.1" }, radar_port, relay_port, max_queue_size);
+        ASSERT_TRUE(relay->open());
+        relay->start();
+
+        pollfd pfd { radar_listener, POLLIN, 0 };
+        ASSERT_EQ(1, ::poll(&pfd, 1, 5000));
+        radar = Connection { ::accept(radar_listener, nullptr, nullptr) };
+        ASSERT_TRUE(radar.is_open());
+
+        radar.send(Message_type::configuration, std::vector<std::uint8_t>(40, 0x5a));
+    }
+
+    void TearDown() override
+    {
+        relay.reset();
+        ::close(radar_listener);
+    }
+
+    static int listen_on_loopback(std::uint16_t& port)
+    {
+        auto fd = ::socket(AF_INET, SOCK_STREAM, 0);
+
+        sockaddr_in addr {};
+        addr.sin_family      = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addr_size  = sizeof(addr);
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), addr_size) == -1 || ::listen(fd, 4) == -1 ||
+            ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &addr_size) == -1) {
+            ::close(fd);
+            return -1;
+        }
+
+        port = ntohs(addr.sin_port);
+        return fd;
+    }
+
+    // A client, connected once it has received the configuration
+    //
+    Connection connect_client()
+    {
+        auto client = Connection::to_loopback(relay_port);
+        EXPECT_EQ(Message_type::configuration, client.receive_type());
+        return client;
+    }
+
+    // Lets the relay's threads pass on anything in flight
+    //
+    static void settle() { std::this_thread::sleep_for(100ms); }
+
+    bool wait_for_clients(std::size_t count)
+    {
+        for (auto deadline = std::chrono::steady_clock::now() + 1s; std::chrono::steady_clock::now() < deadline;) {
+            if (relay->statistics().clients == count) return true;
+            std::this_thread::sleep_for(10ms);
+        }
+        return false;
+    }
+};
+
+
+TEST_F(given_a_colossus_relay, WhenClientsShareAStreamItShouldBeStartedOnceAndStoppedByTheLast)
+{
+    auto first  = connect_client();
+    auto second = connect_client();
+
+    first.send(Message_type::start_fft_data);
+    ASSERT_EQ(Message_type::start_fft_data, radar.receive_type());
+    second.send(Message_type::start_fft_data);
+
+    // Every subscriber receives the same data
+    //
+    auto data = framed(Message_type::fft_data, std::vector<std::uint8_t>(500, 0x33));
+    settle();
+    radar.send(data);
+    ASSERT_EQ(data, first.receive());
+    ASSERT_EQ(data, second.receive());
+
+    first.send(Message_type::stop_fft_data);
+    ASSERT_FALSE(radar.receive(200ms));
+    second.send(Message_type::stop_fft_data);
+    ASSERT_EQ(Message_type::stop_fft_data, radar.receive_type());
+}
+
+
+TEST_F(given_a_colossus_relay, WhenClientsRequestTheSameReplyEachShouldReceiveTheOneItAskedFor)
+{
+    auto first  = connect_client();
+    auto second = connect_client();
+
+    first.send(Message_type::navigation_config_request);
+    ASSERT_EQ(Message_type::navigation_config_request, radar.receive_type());
+    second.send(Message_type::navigation_config_request);
+    ASSERT_EQ(Message_type::navigation_config_request, radar.receive_type());
+
+    auto first_reply  = framed(Message_type::navigation_configuration, std::vector<std::uint8_t>(12, 1));
+    auto second_reply = framed(Message_type::navigation_configuration, std::vector<std::uint8_t>(12, 2));
+
+    radar.send(first_reply);
+    radar.send(second_reply);
+
+    ASSERT_EQ(first_reply, first.receive());
+    ASSERT_EQ(second_reply, second.receive());
+    ASSERT_FALSE(first.receive(200ms));
+    ASSERT_FALSE(second.receive(200ms));
+}
+
+
+TEST_F(given_a_colossus_relay, WhenAClientIsNotTheControllerItsCommandsShouldBeRejected)
+{
+    auto controller = connect_client();
+    auto other      = connect_client();
+
+    other.send(Message_type::set_nav_threshold, { 0, 0, 0, 60 });
+    ASSERT_FALSE(radar.receive(200ms));
+    ASSERT_EQ(1u, relay->statistics().commands_rejected);
+
+    controller.send(Message_type::set_nav_threshold, { 0, 0, 0, 60 });
+    ASSERT_EQ(Message_type::set_nav_threshold, radar.receive_type());
+
+    // The next longest connected client takes control
+    //
+    controller = Connection {};
+    ASSERT_TRUE(wait_for_clients(1));
+    other.send(Message_type::set_nav_threshold, { 0, 0, 0, 60 });
+    ASSERT_EQ(Message_type::set_nav_threshold, radar.receive_type());
+    ASSERT_EQ(1u, relay->statistics().commands_rejected);
+}
+
+
+TEST_F(given_a_colossus_relay, WhenAClientAnnouncesAnOversizedMessageItShouldBeDisconnected)
+{
+    auto client = connect_client();
+    auto other  = connect_client();
+
+    auto data = framed(Message_type::set_nav_threshold, std::vector<std::uint8_t>(4));
+
+    // A payload size of max_relay_client_payload + 1, big-endian
+    //
+    auto size = max_relay_client_payload + 1;
+    for (auto n = 0; n < 4; ++n) {
+        data[Message::header_size() - 1 - n] = static_cast<std::uint8_t>(size >> (8 * n));
+    }
+    client.send(data);
+
+    ASSERT_TRUE(client.is_closed_by_peer());
+    ASSERT_FALSE(radar.receive(200ms));
+    ASSERT_TRUE(wait_for_clients(1));
+}
+
+
+TEST_F(given_a_colossus_relay, WhenAClientStopsReadingItShouldBeDisconnectedOnceItsQueueIsFull)
+{
+    open_relay(4);
+    auto stalled = connect_client();
+
+    // Configuration is never dropped, so it fills the queue once the
+    // client's socket is full
+    //
+    auto configuration = framed(Message_type::configuration, std::vector<std::uint8_t>(60000, 0x5a));
+    for (auto n = 0; n < 400; ++n) {
+        radar.send(configuration);
+    }
+
+    ASSERT_TRUE(wait_for_clients(0));
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "../rotation/continuity_tracker.h"
+
+using namespace Navtech;
+
+class given_a_continuity_tracker : public ::testing::Test {
+protected:
+    static constexpr std::uint16_t encoder_size { 5600 };
+    static constexpr std::uint16_t azimuth_samples { 400 };
+    static constexpr std::uint16_t encoder_step { encoder_size / azimuth_samples };
+
+    Continuity_tracker tracker {};
+    std::mt19937 random { 2856 };
+
+    void SetUp() override { tracker.configure(encoder_size, azimuth_samples); }
+
+    static std::uint16_t encoder_position(std::uint32_t index)
+    {
+        return static_cast<std::uint16_t>((index % azimuth_samples) * encoder_step);
+    }
+
+    static void assert_counters(const Continuity_counters& expected, const Continuity_counters& actual)
+    {
+        ASSERT_EQ(expected.azimuths_received, actual.azimuths_received);
+        ASSERT_EQ(expected.azimuths_missing, actual.azimuths_missing);
+        ASSERT_EQ(expected.azimuths_duplicated, actual.azimuths_duplicated);
+        ASSERT_EQ(expected.gaps, actual.gaps);
+        ASSERT_EQ(expected.sweep_discontinuities, actual.sweep_discontinuities);
+    }
+};
+
+
+TEST_F(given_a_continuity_tracker, WhenAzimuthsArriveInOrderAcrossRotationsTheyShouldBeContinuous)
+{
+    for (std::uint32_t n = 0; n < 3u * azimuth_samples; ++n) {
+        auto sweep = static_cast<std::uint16_t>(65000 + n);
+        ASSERT_TRUE(tracker.check(encoder_position(n + 390), sweep).is_continuous()) << n;
+    }
+
+    Continuity_counters expected {};
+    expected.azimuths_received = 3u * azimuth_samples;
+    assert_counters(expected, tracker.counters());
+}
+
+
+TEST_F(given_a_continuity_tracker, WhenAzimuthsAreSkippedAcrossTheWrapTheGapShouldBeCounted)
+{
+    tracker.check(encoder_position(397), 10);
+    tracker.check(encoder_position(398), 11);
+
+    auto result = tracker.check(encoder_position(2), 15);
+    ASSERT_EQ(3u, result.missing_before);
+    ASSERT_TRUE(result.sweep_discontinuity);
+    ASSERT_FALSE(result.duplicate);
+
+    result = tracker.check(encoder_position(3), 16);
+    ASSERT_TRUE(result.is_continuous());
+
+    Continuity_counters expected {};
+    expected.azimuths_received     = 4;
+    expected.azimuths_missing      = 3;
+    expected.gaps                  = 1;
+    expected.sweep_discontinuities = 1;
+    assert_counters(expected, tracker.counters());
+}
+
+
+TEST_F(given_a_continuity_tracker, WhenAnAzimuthRepeatsItShouldBeADuplicate)
+{
+    tracker.check(encoder_position(5), 100);
+    auto result = tracker.check(encoder_position(5), 100);
+    ASSERT_TRUE(result.duplicate);
+    ASSERT_EQ(0u, result.missing_before);
+    ASSERT_FALSE(result.sweep_discontinuity);
+
+    ASSERT_TRUE(tracker.check(encoder_position(6), 101).is_continuous());
+    ASSERT_EQ(1u, tracker.counters().azimuths_duplicated);
+}
+
+
+TEST_F(given_a_continuity_tracker, WhenEncoderPositionsShareAnIndexTheyShouldBeDuplicates)
+{
+    tracker.check(encoder_position(20));
+    ASSERT_TRUE(tracker.check(encoder_position(20) + encoder_step - 1).duplicate);
+    ASSERT_TRUE(tracker.check(encoder_position(21)).is_continuous());
+}
+
+
+TEST_F(given_a_continuity_tracker, WhenOnlyTheSweepCounterJumpsItShouldBeASweepDiscontinuity)
+{
+    tracker.check(encoder_position(0), 65534);
+    ASSERT_TRUE(tracker.check(encoder_position(1), 65535).is_continuous());
+    ASSERT_TRUE(tracker.check(encoder_position(2), 0).is_continuous());
+
+    auto result = tracker.check(encoder_position(3), 7);
+    ASSERT_TRUE(result.sweep_discontinuity);
+    ASSERT_EQ(0u, result.missing_before);
+    ASSERT_EQ(1u, tracker.counters().sweep_discontinuities);
+    ASSERT_EQ(0u, tracker.counters().gaps);
+}
+
+
+TEST_F(given_a_continuity_tracker, WhenStaringOnlyTheSweepCounterShouldBeChecked)
+{
+    tracker.configure(encoder_size, azimuth_samples, true);
+
+    ASSERT_TRUE(tracker.check(encoder_position(9), 65535).is_continuous());
+    ASSERT_TRUE(tracker.check(encoder_position(9), 0).is_continuous());
+    ASSERT_TRUE(tracker.check(encoder_position(9), 0).duplicate);
+
+    auto result = tracker.check(encoder_position(9), 4);
+    ASSERT_EQ(3u, result.missing_before);
+    ASSERT_FALSE(result.sweep_discontinuity);
+
+    Continuity_counters expected {};
+    expected.azimuths_received   = 4;
+    expected.azimuths_missing    = 3;
+    expected.azimuths_duplicated = 1;
+    expected.gaps                = 1;
+    assert_counters(expected, tracker.counters());
+}
+
+
+TEST_F(given_a_continuity_tracker, WhenResetTheCountersShouldBeZeroAndTheNextAzimuthUnchecked)
+{
+    tracker.check(encoder_position(0), 0);
+    tracker.check(encoder_position(0), 0);
+    tracker.check(encoder_position(100), 50);
+
+    tracker.reset();
+    assert_counters(Continuity_counters {}, tracker.counters());
+
+    ASSERT_TRUE(tracker.check(encoder_position(300), 9000).is_continuous());
+    ASSERT_EQ(1u, tracker.counters().azimuths_received);
+}
+
+
+TEST_F(given_a_continuity_tracker, WhenAzimuthsAreLostAndRepeatedAtRandomTheCountersShouldMatch)
+{
+    std::uniform_int_distribution<int> events { 0, 99 };
+
+    // Brute force: walk the stream one azimuth at a time, noting each
+    // azimuth that is dropped or repeated
+    //
+    Continuity_counters expected {};
+    std::uint32_t index   = 123;
+    std::uint16_t sweep   = 65300;
+    bool dropping         = false;
+    std::uint32_t dropped = 0;
+    bool have_last        = false;
+
+    for (auto n = 0; n < 100000; ++n, ++index, ++sweep) {
+        auto event = events(random);
+        if (event < 3 && have_last) {
+            ++dropped;
+            dropping = true;
+            continue;
+        }
+
+        auto result = tracker.check(encoder_position(index), sweep);
+        ++expected.azimuths_received;
+
+        auto expected_missing = dropping ? dropped % azimuth_samples : 0u;
+        ASSERT_EQ(expected_missing, result.missing_before) << n;
+        ASSERT_EQ(dropping, result.sweep_discontinuity) << n;
+        if (dropping && expected_missing > 0) {
+            ++expected.gaps;
+            expected.azimuths_missing += expected_missing;
+        }
+        if (dropping) ++expected.sweep_discontinuities;
+
+        dropping  = false;
+        dropped   = 0;
+        have_last = true;
+
+        if (event > 96) {
+            ASSERT_TRUE(tracker.check(encoder_position(index), sweep).duplicate) << n;
+            ++expected.azimuths_received;
+            ++expected.azimuths_duplicated;
+        }
+    }
+
+    assert_counters(expected, tracker.counters());
+}
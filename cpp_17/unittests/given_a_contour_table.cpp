@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../rotation/contour_table.h"
+#include "../rotation/rotation_frame_pool.h"
+
+using namespace Navtech;
+
+class given_a_contour_table : public ::testing::Test {
+protected:
+    static constexpr std::uint16_t azimuth_samples { 400 };
+    static constexpr std::uint16_t range_in_bins { 301 };
+    static constexpr std::uint16_t encoder_size { 5600 };
+    static constexpr double bin_size { 0.175 };
+
+    Rotation_frame_pool pool { 3, azimuth_samples, range_in_bins, encoder_size, Page_size::standard };
+    Rotation_frame_handle in { pool.acquire() };
+    std::vector<std::uint16_t> metres {};
+    std::vector<std::uint8_t> contour {};
+    std::mt19937 random { 2856 };
+
+    void make_contour()
+    {
+        metres.resize(360);
+        contour.clear();
+        for (auto& range : metres) {
+            range = static_cast<std::uint16_t>(random() % 70);
+            contour.push_back(static_cast<std::uint8_t>(range >> 8));
+            contour.push_back(static_cast<std::uint8_t>(range & 0xff));
+        }
+    }
+
+    void make_rotation(std::uint16_t first_bin = 0)
+    {
+        auto& frame = in.writable();
+        frame.clear();
+        frame.first_bin(first_bin);
+
+        std::vector<std::uint8_t> data(range_in_bins);
+        for (std::uint16_t index = 0; index < azimuth_samples; ++index) {
+            for (auto& sample : data) {
+                sample = static_cast<std::uint8_t>(1 + random() % 255);
+            }
+
+            Azimuth_record record {};
+            record.azimuth = static_cast<std::uint16_t>(index * (encoder_size / azimuth_samples));
+            frame.write(index, record, data.data(), data.size());
+        }
+    }
+
+    // Frames can't be copied; an empty table copies every bin
+    //
+    Rotation_frame_handle copy(const Rotation_frame& frame)
+    {
+        auto result = pool.acquire();
+        result.writable().clear();
+        Contour_table {}.apply(frame, result.writable());
+        return result;
+    }
+
+    // Brute force: each bin is kept if the range to its near edge, from
+    // the radar, is inside the contour for its degree
+    //
+    void assert_clipped(const Rotation_frame& original, const Rotation_frame& clipped)
+    {
+        auto first_bin = original.first_bin();
+
+        for (std::uint16_t index = 0; index < azimuth_samples; ++index) {
+            auto degree = (index * 360u) / azimuth_samples;
+            auto keep   = static_cast<std::size_t>(std::ceil(metres[degree] / bin_size));
+
+            for (std::uint16_t bin = 0; bin < range_in_bins; ++bin) {
+                auto expected = (first_bin + bin < keep) ? original.row(index)[bin] : 0;
+                ASSERT_EQ(expected, clipped.row(index)[bin]) << index << ", " << bin;
+            }
+        }
+    }
+};
+
+
+TEST_F(given_a_contour_table, WhenAppliedInPlaceBinsBeyondTheContourShouldBeZeroed)
+{
+    for (std::uint16_t first_bin : { 0, 7, 200 }) {
+        make_contour();
+        make_rotation(first_bin);
+        auto original = copy(*in);
+
+        Contour_table table { contour, bin_size, azimuth_samples };
+        ASSERT_FALSE(table.empty());
+        table.apply(in.writable());
+
+        assert_clipped(*original, *in);
+    }
+}
+
+
+TEST_F(given_a_contour_table, WhenAppliedToACopyTheOriginalShouldBeUnchanged)
+{
+    make_contour();
+    make_rotation(12);
+    auto original = copy(*in);
+
+    Contour_table table { contour, bin_size, azimuth_samples };
+    auto out = pool.acquire();
+    out.writable().clear();
+    table.apply(*in, out.writable());
+
+    assert_clipped(*in, *out);
+    assert_clipped(*original, *out);
+    ASSERT_EQ(in->first_bin(), out->first_bin());
+    for (std::uint16_t index = 0; index < azimuth_samples; ++index) {
+        ASSERT_TRUE(std::equal(in->row(index), in->row(index) + range_in_bins, original->row(index))) << index;
+    }
+}
+
+
+TEST_F(given_a_contour_table, WhenTheContourIsMalformedTheTableShouldBeEmptyAndClipNothing)
+{
+    make_contour();
+    Contour_table table { contour, bin_size, azimuth_samples };
+    ASSERT_FALSE(table.empty());
+
+    contour.pop_back();
+    ASSERT_FALSE(table.compile(contour, bin_size, azimuth_samples));
+    ASSERT_TRUE(table.empty());
+
+    contour.push_back(0);
+    ASSERT_FALSE(table.compile(contour, 0.0, azimuth_samples));
+    ASSERT_FALSE(table.compile(contour, bin_size, 0));
+    ASSERT_TRUE(table.empty());
+
+    make_rotation();
+    auto original = copy(*in);
+    table.apply(in.writable());
+
+    for (std::uint16_t index = 0; index < azimuth_samples; ++index) {
+        ASSERT_TRUE(std::equal(in->row(index), in->row(index) + range_in_bins, original->row(index))) << index;
+    }
+}
+
+
+TEST_F(given_a_contour_table, WhenTheFrameHasADifferentAzimuthCountItShouldBeUnchanged)
+{
+    make_contour();
+    make_rotation();
+    auto original = copy(*in);
+
+    Contour_table table { contour, bin_size, azimuth_samples / 2 };
+    ASSERT_EQ(azimuth_samples / 2, table.azimuth_samples());
+    table.apply(in.writable());
+
+    for (std::uint16_t index = 0; index < azimuth_samples; ++index) {
+        ASSERT_TRUE(std::equal(in->row(index), in->row(index) + range_in_bins, original->row(index))) << index;
+    }
+}
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "../network/discovery_client.h"
+
+using namespace Navtech;
+using namespace std::chrono_literals;
+using Network::Colossus_protocol::Message;
+
+class given_a_discovery_client : public ::testing::Test {
+protected:
+    Discovered_radar radar {};
+
+    static std::vector<std::uint8_t> reply(const Colossus::Protobuf::Discovery& discovery)
+    {
+        Message msg {};
+        msg.type(Message::Type::configuration);
+        msg.append(discovery.SerializeAsString());
+        return msg.relinquish();
+    }
+
+    static Colossus::Protobuf::Discovery discovery(const std::string& model, int clients)
+    {
+        Colossus::Protobuf::Discovery result {};
+        result.mutable_model()->set_name(model);
+        result.mutable_model()->set_rangeinmetres(500.0f);
+        result.set_rangeresolutionmetres(0.175f);
+        result.set_maxclientsallowed(4);
+        result.set_staringmode(0);
+        result.set_transmitterenabled(1);
+        for (auto n = 0; n < clients; ++n) {
+            result.add_ipclients("192.168.0." + std::to_string(10 + n));
+        }
+        return result;
+    }
+
+    bool parse(const std::vector<std::uint8_t>& data)
+    {
+        return Discovery_client::parse_reply(data.data(), data.size(), radar);
+    }
+};
+
+
+TEST_F(given_a_discovery_client, WhenAReplyIsValidItShouldBeDecoded)
+{
+    ASSERT_TRUE(parse(reply(discovery("CTS350-X", 3))));
+
+    ASSERT_EQ("CTS350-X", radar.model);
+    ASSERT_EQ(500.0f, radar.maximum_range);
+    ASSERT_EQ(0.175f, radar.range_resolution);
+    ASSERT_EQ(4, radar.max_clients);
+    ASSERT_EQ(3, radar.connected_clients);
+    ASSERT_EQ(1, radar.free_client_slots);
+    ASSERT_FALSE(radar.staring_mode);
+    ASSERT_TRUE(radar.transmitter_enabled);
+    ASSERT_NE(nullptr, radar.protobuf_discovery);
+}
+
+
+TEST_F(given_a_discovery_client, WhenMoreClientsAreConnectedThanAllowedNoSlotsShouldBeFree)
+{
+    ASSERT_TRUE(parse(reply(discovery("CIR204-H", 6))));
+    ASSERT_EQ(6, radar.connected_clients);
+    ASSERT_EQ(0, radar.free_client_slots);
+}
+
+
+TEST_F(given_a_discovery_client, WhenAReplyIsMalformedItShouldBeRejected)
+{
+    auto good = reply(discovery("CTS350-X", 1));
+
+    // Shorter than a header
+    //
+    ASSERT_FALSE(parse({ good.begin(), good.begin() + Message::header_size() - 1 }));
+
+    // A corrupt signature
+    //
+    auto bad_signature = good;
+    bad_signature[3] ^= 0xff;
+    ASSERT_FALSE(parse(bad_signature));
+
+    // Truncated, or followed by more data than the payload size
+    //
+    ASSERT_FALSE(parse({ good.begin(), good.end() - 1 }));
+    auto extended = good;
+    extended.push_back(0);
+    ASSERT_FALSE(parse(extended));
+
+    // A payload that is not a Discovery protobuf
+    //
+    Message msg {};
+    msg.type(Message::Type::configuration);
+    msg.append(std::vector<std::uint8_t> { 0xff, 0xff, 0xff });
+    ASSERT_FALSE(parse(msg.relinquish()));
+
+    ASSERT_TRUE(parse(good));
+}
+
+
+TEST_F(given_a_discovery_client, WhenARadarRepliesMoreThanOnceItShouldBeReportedOnce)
+{
+    // A radar on loopback, which answers the probe with a malformed reply
+    // and then the same reply twice
+    //
+    auto sock = ::socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_NE(-1, sock);
+
+    sockaddr_in addr {};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_size  = sizeof(addr);
+    ASSERT_EQ(0, ::bind(sock, reinterpret_cast<sockaddr*>(&addr), addr_size));
+    ASSERT_EQ(0, ::getsockname(sock, reinterpret_cast<sockaddr*>(&addr), &addr_size));
+
+    std::vector<std::uint8_t> probe {};
+    std::thread fake_radar { [sock, &probe] {
+        pollfd pfd { sock, POLLIN, 0 };
+        if (::poll(&pfd, 1, 1000) <= 0) return;
+
+        sockaddr_in from {};
+        socklen_t from_size = sizeof(from);
+        probe.resize(1024);
+        auto received = ::recvfrom(sock, probe.data(), probe.size(), 0, reinterpret_cast<sockaddr*>(&from), &from_size);
+        probe.resize(std::max<ssize_t>(received, 0));
+
+        auto good = reply(discovery("CTS350-X", 1));
+        std::vector<std::uint8_t> bad { good.begin(), good.end() - 1 };
+        for (auto& data : { bad, good, good }) {
+            ::sendto(sock, data.data(), data.size(), 0, reinterpret_cast<sockaddr*>(&from), from_size);
+        }
+    } };
+
+    Discovery_client client { Utility::IP_address { "127.0.0.1" }, ntohs(addr.sin_port) };
+    auto radars = client.discover(200ms);
+    fake_radar.join();
+    ::close(sock);
+
+    ASSERT_EQ(Message::header_size(), probe.size());
+    Message sent { probe };
+    ASSERT_TRUE(sent.is_valid());
+    ASSERT_EQ(Message::Type::configuration_request, sent.type());
+
+    ASSERT_EQ(1u, radars.size());
+    ASSERT_EQ("127.0.0.1", radars[0].address.to_string());
+    ASSERT_EQ("CTS350-X", radars[0].model);
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../network/colossus_network_message.h"
+#include "../network/tcp_radar_client.h"
+
+using namespace Navtech;
+using Network::Colossus_protocol::Message;
+
+// A TCP stream of messages, with noise between them, read in arbitrary
+// pieces as Tcp_radar_client's polled mode does
+//
+class given_a_message_stream : public ::testing::Test {
+protected:
+    std::mt19937 random { 2856 };
+
+    std::vector<std::uint8_t> stream {};
+    std::vector<std::vector<std::uint8_t>> sent {};
+    std::vector<std::vector<std::uint8_t>> received {};
+
+    std::vector<std::uint8_t> buffer {};
+    std::size_t offset { 0 };
+
+    std::vector<std::uint8_t> make_message(std::size_t payload_size)
+    {
+        std::vector<std::uint8_t> payload(payload_size);
+        for (auto& byte : payload) {
+            byte = static_cast<std::uint8_t>(random() % 256);
+        }
+
+        Message msg {};
+        msg.type(Message::Type::fft_data);
+        msg.append(std::move(payload));
+        return msg.relinquish();
+    }
+
+    std::vector<std::uint8_t> make_message() { return make_message(random() % 300); }
+
+    void send(const std::vector<std::uint8_t>& data, bool is_message = true)
+    {
+        stream.insert(stream.end(), data.begin(), data.end());
+        if (is_message) sent.push_back(data);
+    }
+
+    void send_noise(std::size_t size)
+    {
+        std::vector<std::uint8_t> noise(size);
+        for (auto& byte : noise) {
+            byte = static_cast<std::uint8_t>(random() % 256);
+        }
+        send(noise, false);
+    }
+
+    // Read the stream max_read bytes at most at a time, framing after
+    // each read
+    //
+    void receive(std::size_t max_read)
+    {
+        for (std::size_t position = 0; position < stream.size();) {
+            auto read = std::min<std::size_t>(1 + random() % max_read, stream.size() - position);
+            buffer.insert(buffer.end(), stream.begin() + position, stream.begin() + position + read);
+            position += read;
+
+            while (auto size = frame_message(buffer.data(), offset, buffer.size())) {
+                received.emplace_back(buffer.begin() + offset, buffer.begin() + offset + size);
+                offset += size;
+            }
+            ASSERT_LE(offset, buffer.size());
+        }
+    }
+};
+
+
+TEST_F(given_a_message_stream, WhenMessagesArriveInPiecesEachShouldBeFramedWhole)
+{
+    for (auto n = 0; n < 200; ++n) {
+        send(make_message());
+    }
+
+    for (std::size_t max_read : { 1, 7, 22, 23, 100, 4096 }) {
+        received.clear();
+        buffer.clear();
+        offset = 0;
+
+        receive(max_read);
+        ASSERT_EQ(sent, received) << max_read;
+    }
+}
+
+
+TEST_F(given_a_message_stream, WhenNoiseIsBetweenMessagesTheyShouldStillBeFramed)
+{
+    const auto& signature = Message::valid_signature();
+
+    for (auto n = 0; n < 200; ++n) {
+        switch (random() % 5) {
+            case 0:
+                send_noise(random() % 100);
+                break;
+
+            // Part of a signature, which is only found to be noise when
+            // the next message's signature starts within it
+            //
+            case 1:
+                send({ signature.begin(), signature.begin() + 1 + random() % (signature.size() - 1) }, false);
+                break;
+
+            // A whole signature, with a bad version after it
+            //
+            case 2: {
+                auto bad = make_message();
+                bad[signature.size()] ^= 0xff;
+                send(bad, false);
+                break;
+            }
+            default:
+                break;
+        }
+        send(make_message());
+    }
+
+    for (std::size_t max_read : { 1, 13, 64, 4096 }) {
+        received.clear();
+        buffer.clear();
+        offset = 0;
+
+        receive(max_read);
+        ASSERT_EQ(sent, received) << max_read;
+    }
+}
+
+
+TEST_F(given_a_message_stream, WhenOnlyNoiseHasArrivedItShouldBeDiscardedButForAPossibleSignature)
+{
+    const auto& signature = Message::valid_signature();
+
+    send_noise(1000);
+    buffer = stream;
+
+    // Noise ending in the first part of a signature; that part is kept
+    //
+    buffer.insert(buffer.end(), signature.begin(), signature.begin() + 5);
+    ASSERT_EQ(0u, frame_message(buffer.data(), offset, buffer.size()));
+    ASSERT_LE(offset, buffer.size() - 5);
+    ASSERT_GE(offset, buffer.size() - (signature.size() - 1));
+
+    auto message = make_message();
+    buffer.insert(buffer.end(), message.begin() + 5, message.end());
+
+    auto size = frame_message(buffer.data(), offset, buffer.size());
+    ASSERT_EQ(message.size(), size);
+    ASSERT_TRUE(std::equal(message.begin(), message.end(), buffer.begin() + offset));
+}
+
+
+TEST_F(given_a_message_stream, WhenAMessageIsIncompleteItShouldWaitForTheRest)
+{
+    auto message = make_message(50);
+
+    for (std::size_t size = 0; size < message.size(); ++size) {
+        ASSERT_EQ(0u, frame_message(message.data(), offset, size)) << size;
+        ASSERT_EQ(0u, offset) << size;
+    }
+    ASSERT_EQ(message.size(), frame_message(message.data(), offset, message.size()));
+    ASSERT_EQ(0u, offset);
+}
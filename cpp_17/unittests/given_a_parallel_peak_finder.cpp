@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "../navigation/parallel_peak_finder.h"
+
+using namespace Navtech;
+
+class given_a_parallel_peak_finder : public ::testing::Test {
+public:
+    given_a_parallel_peak_finder()
+    {
+        configuration                = allocate_shared<Configuration_data>();
+        configuration->range_in_bins = 1024;
+        configuration->range_gain    = 1;
+        configuration->range_offset  = 0;
+        protobuf_configuration       = allocate_shared<Colossus::Protobuf::ConfigurationData>();
+        protobuf_configuration->set_rangeresolutionmetres(0.175);
+
+        std::mt19937 random { 2856 };
+        for (std::uint16_t azimuth = 0; azimuth < 400; ++azimuth) {
+            auto fft_data     = allocate_shared<Fft_data>();
+            fft_data->azimuth = azimuth;
+            fft_data->angle   = azimuth * 0.9;
+            fft_data->data.resize(configuration->range_in_bins);
+
+            int level = 60;
+            for (auto& sample : fft_data->data) {
+                level  = std::clamp(level + static_cast<int>(random() % 9) - 4, 0, 255);
+                sample = static_cast<std::uint8_t>((random() % 41 == 0) ? random() % 256 : level);
+            }
+            azimuths.push_back(fft_data);
+        }
+    }
+
+protected:
+    Configuration_data::Pointer configuration;
+    Configuration_data::ProtobufPointer protobuf_configuration;
+    std::vector<Fft_data::Pointer> azimuths {};
+
+    template <typename Finder>
+    std::vector<Azimuth_target> find_targets(Finder& finder, BufferModes buffer_mode)
+    {
+        std::vector<Azimuth_target> found {};
+        finder.set_target_callback([&found](const Azimuth_target& target) { found.push_back(target); });
+        finder.configure(configuration, protobuf_configuration, 70.0, 6, 50, buffer_mode, 4, 10);
+
+        for (auto& fft_data : azimuths) {
+            finder.fft_data_handler(fft_data);
+        }
+
+        // Every target must be delivered before found is returned, and
+        // the callback must not outlive it
+        //
+        if constexpr (std::is_same_v<Finder, Parallel_peak_finder>) finder.flush();
+        finder.set_target_callback();
+        return found;
+    }
+
+    void assert_same(const std::vector<Azimuth_target>& expected, const std::vector<Azimuth_target>& actual)
+    {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (std::size_t n = 0; n < expected.size(); ++n) {
+            ASSERT_EQ(expected[n].azimuth, actual[n].azimuth);
+            ASSERT_EQ(expected[n].targets.size(), actual[n].targets.size());
+            for (std::size_t t = 0; t < expected[n].targets.size(); ++t) {
+                ASSERT_EQ(expected[n].targets[t].range, actual[n].targets[t].range);
+                ASSERT_EQ(expected[n].targets[t].power, actual[n].targets[t].power);
+            }
+        }
+    }
+};
+
+
+TEST_F(given_a_parallel_peak_finder, WhenSearchingAzimuthsTheTargetsShouldMatchASinglePeakFinderInOrder)
+{
+    Peak_finder single {};
+    auto expected = find_targets(single, BufferModes::off);
+    ASSERT_FALSE(expected.empty());
+
+    for (std::size_t workers : { 1, 3, 8 }) {
+        for (std::size_t in_flight : { 1, 2, 64 }) {
+            Parallel_peak_finder parallel { workers, in_flight };
+            auto actual = find_targets(parallel, BufferModes::off);
+
+            assert_same(expected, actual);
+        }
+    }
+}
+
+
+TEST_F(given_a_parallel_peak_finder, WhenBufferingTheTargetsShouldMatchASinglePeakFinderInOrder)
+{
+    for (auto buffer_mode : { BufferModes::average, BufferModes::max }) {
+        Peak_finder single {};
+        auto expected = find_targets(single, buffer_mode);
+        ASSERT_FALSE(expected.empty());
+
+        Parallel_peak_finder parallel { 4, 16 };
+        auto actual = find_targets(parallel, buffer_mode);
+
+        assert_same(expected, actual);
+    }
+}
+
+
+TEST_F(given_a_parallel_peak_finder, WhenNotConfiguredShouldIgnoreFftData)
+{
+    Parallel_peak_finder parallel { 2, 4 };
+
+    auto target_found = false;
+    parallel.set_target_callback([&target_found](const Azimuth_target&) { target_found = true; });
+    parallel.fft_data_handler(azimuths.front());
+    parallel.flush();
+
+    ASSERT_FALSE(target_found);
+}
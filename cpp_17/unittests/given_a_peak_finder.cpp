@@ -1,6 +1,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <limits>
+
 #include "../navigation/peak_finder.h"
 
 using namespace Navtech;
@@ -46,7 +50,7 @@ TEST_F(given_a_peak_finder, WhenCallingFindPeakBinWithNoDataAboveThresholdShould
     };
 
     auto threshold             = 90.0;             // Threshold in dB
-    auto bins_to_operate_on    = 4;                // Radar bins window size to search for peaks in
+    auto bins_to_operate_on    = 5;                // Radar bins window size to search for peaks in
     auto start_bin             = 1;                // Start Bin
     auto buffer_mode           = BufferModes::off; // Buffer mode should only be used with a staring radar
     auto buffer_length         = 10;               // Buffer Length
@@ -89,7 +93,7 @@ TEST_F(given_a_peak_finder, WhenCallingFindPeakBinWithASinglePeakAboveThresholdS
     };
 
     auto threshold             = 90.0;             // Threshold in dB
-    auto bins_to_operate_on    = 4;                // Radar bins window size to search for peaks in
+    auto bins_to_operate_on    = 5;                // Radar bins window size to search for peaks in
     auto start_bin             = 1;                // Start Bin
     auto buffer_mode           = BufferModes::off; // Buffer mode should only be used with a staring radar
     auto buffer_length         = 10;               // Buffer Length
@@ -134,7 +138,7 @@ TEST_F(given_a_peak_finder, WhenCallingFindPeakBinWithATwinPeaksAboveThresholdSh
     };
 
     auto threshold             = 90.0;             // Threshold in dB
-    auto bins_to_operate_on    = 4;                // Radar bins window size to search for peaks in
+    auto bins_to_operate_on    = 5;                // Radar bins window size to search for peaks in
     auto start_bin             = 1;                // Start Bin
     auto buffer_mode           = BufferModes::off; // Buffer mode should only be used with a staring radar
     auto buffer_length         = 10;               // Buffer Length
@@ -162,3 +166,78 @@ TEST_F(given_a_peak_finder, WhenCallingFindPeakBinWithATwinPeaksAboveThresholdSh
     ASSERT_TRUE(target_found);
     ASSERT_EQ(2, target_count);
 }
+
+
+TEST_F(given_a_peak_finder, WhenCallingFindTargetsShouldWriteNoMoreThanTheCapacity)
+{
+    Peak_finder pf {};
+
+    auto threshold             = 90.0;             // Threshold in dB
+    auto bins_to_operate_on    = 5;                // Radar bins window size to search for peaks in
+    auto start_bin             = 1;                // Start Bin
+    auto buffer_mode           = BufferModes::off; // Buffer mode should only be used with a staring radar
+    auto buffer_length         = 10;               // Buffer Length
+    auto max_peaks_per_azimuth = 2;                // Maximum number of peaks to find in a single azimuth
+
+    pf.configure(configuration,
+                 protobuf_configuration,
+                 threshold,
+                 bins_to_operate_on,
+                 start_bin,
+                 buffer_mode,
+                 buffer_length,
+                 max_peaks_per_azimuth);
+
+    std::array<Target, 2> targets {};
+
+    ASSERT_EQ(2, pf.find_targets(twin_peaks.data(), twin_peaks.size(), targets.data(), targets.size()));
+    ASSERT_EQ(2.0, targets[0].range);
+    ASSERT_EQ(120.0, targets[0].power);
+    ASSERT_EQ(6.25, targets[1].range);
+
+    ASSERT_EQ(1, pf.find_targets(twin_peaks.data(), twin_peaks.size(), targets.data(), 1));
+    ASSERT_EQ(0, pf.find_targets(no_peak.data(), no_peak.size(), targets.data(), targets.size()));
+}
+
+
+TEST_F(given_a_peak_finder, WhenAPeakIsNotFiniteFindTargetsShouldSkipIt)
+{
+    Peak_finder pf {};
+
+    auto threshold             = 90.0;             // Threshold in dB
+    auto bins_to_operate_on    = 5;                // Radar bins window size to search for peaks in
+    auto start_bin             = 1;                // Start Bin
+    auto buffer_mode           = BufferModes::off; // Buffer mode should only be used with a staring radar
+    auto buffer_length         = 10;               // Buffer Length
+    auto max_peaks_per_azimuth = 4;                // Maximum number of peaks to find in a single azimuth
+
+    pf.configure(configuration,
+                 protobuf_configuration,
+                 threshold,
+                 bins_to_operate_on,
+                 start_bin,
+                 buffer_mode,
+                 buffer_length,
+                 max_peaks_per_azimuth);
+
+    // The first peak cannot be resolved; the second can
+    //
+    std::array<double, 32> data {};
+    std::copy(twin_peaks.begin(), twin_peaks.end(), data.begin());
+    std::array<Target, 4> targets {};
+
+    for (auto not_finite : { std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity() }) {
+        data[7] = not_finite;
+        ASSERT_EQ(1, pf.find_targets(data.data(), data.size(), targets.data(), targets.size())) << not_finite;
+        ASSERT_EQ(6.25, targets[0].range);
+        ASSERT_EQ(120.0, targets[0].power);
+
+        data[7] = 100.0;
+        data[8] = not_finite;
+        ASSERT_EQ(1, pf.find_targets(data.data(), data.size(), targets.data(), targets.size())) << not_finite;
+        ASSERT_EQ(6.25, targets[0].range);
+
+        data[8] = 120.0;
+    }
+    ASSERT_EQ(2, pf.find_targets(data.data(), data.size(), targets.data(), targets.size()));
+}
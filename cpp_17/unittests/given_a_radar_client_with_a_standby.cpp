@@ -0,0 +1,304 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "../network/colossus_messages.h"
+#include "../network/radar_client.h"
+
+using namespace Navtech;
+using namespace std::chrono_literals;
+using Network::Colossus_protocol::Message;
+using Message_type = Message::Type;
+
+// A primary and a standby radar, on two loopback addresses with the same
+// port, each a plain blocking socket
+//
+class given_a_radar_client_with_a_standby : public ::testing::Test {
+protected:
+    static constexpr std::uint16_t encoder_size { 5600 };
+    static constexpr std::uint16_t azimuth_samples { 400 };
+    static constexpr std::uint16_t encoder_step { encoder_size / azimuth_samples };
+    static constexpr std::uint16_t primary_range { 1000 };
+    static constexpr std::uint16_t standby_range { 2000 };
+
+    class Connection {
+    public:
+        explicit Connection(int socket = -1) : fd { socket } { }
+        Connection(Connection&& other) noexcept : fd { other.fd } { other.fd = -1; }
+        ~Connection()
+        {
+            if (fd != -1) ::close(fd);
+        }
+
+        Connection& operator=(Connection&& other) noexcept
+        {
+            std::swap(fd, other.fd);
+            return *this;
+        }
+
+        bool is_open() const { return fd != -1; }
+
+        void send(const std::vector<std::uint8_t>& data) const { ::send(fd, data.data(), data.size(), MSG_NOSIGNAL); }
+
+        // The type of the next whole message, or nothing if none arrives
+        // in time or the connection is closed
+        //
+        std::optional<Message_type> receive_type(std::chrono::milliseconds timeout = 1000ms) const
+        {
+            std::vector<std::uint8_t> message(Message::header_size());
+            if (!read(message.data(), message.size(), timeout)) return std::nullopt;
+
+            Message header { message.data(), message.size() };
+            if (!header.is_valid()) return std::nullopt;
+
+            message.resize(Message::header_size() + header.payload_size());
+            if (!read(message.data() + Message::header_size(), header.payload_size(), timeout)) return std::nullopt;
+            return Message { message }.type();
+        }
+
+    private:
+        int fd { -1 };
+
+        bool read(std::uint8_t* data, std::size_t size, std::chrono::milliseconds timeout) const
+        {
+            for (std::size_t done = 0; done < size;) {
+                pollfd pfd { fd, POLLIN, 0 };
+                if (::poll(&pfd, 1, static_cast<int>(timeout.count())) <= 0) return false;
+
+                auto received = ::recv(fd, data + done, size - done, 0);
+                if (received <= 0) return false;
+                done += received;
+            }
+            return true;
+        }
+    };
+
+    std::uint16_t port { 0 };
+    int primary_listener { -1 };
+    int standby_listener { -1 };
+    Connection primary {};
+    Connection standby {};
+    Owner_of<Radar_client> client {};
+
+    // Configurations and FFT azimuths, in the order they were delivered
+    //
+    std::mutex events_mutex {};
+    std::vector<std::string> events {};
+    std::vector<Failover_report> reports {};
+
+    void SetUp() override
+    {
+        primary_listener = listen_on(INADDR_LOOPBACK, port);
+        ASSERT_NE(-1, primary_listener);
+        standby_listener = listen_on(INADDR_LOOPBACK + 1, port);
+        ASSERT_NE(-1, standby_listener);
+
+        client = allocate_owned<Radar_client>(
+            Utility::IP_address { "127.0.0.1" }, Utility::IP_address { "127.0.0.2" }, port);
+
+        client->set_configuration_data_callback(
+            [this](const Configuration_data::Pointer& configuration, const Configuration_data::ProtobufPointer&) {
+                record("configuration " + std::to_string(configuration->range_in_bins));
+            });
+        client->set_fft_data_callback(
+            [this](const Fft_data::Pointer& fft) { record("fft " + std::to_string(fft->azimuth)); });
+        client->set_failover_callback([this](const Failover_report::Pointer& report) {
+            std::lock_guard lock { events_mutex };
+            reports.push_back(*report);
+        });
+        client->start();
+
+        primary = accept(primary_listener);
+        ASSERT_TRUE(primary.is_open());
+        standby = accept(standby_listener);
+        ASSERT_TRUE(standby.is_open());
+    }
+
+    void TearDown() override
+    {
+        if (client != nullptr) client->stop();
+        ::close(primary_listener);
+        ::close(standby_listener);
+    }
+
+    static int listen_on(std::uint32_t address, std::uint16_t& port)
+    {
+        auto fd = ::socket(AF_INET, SOCK_STREAM, 0);
+
+        sockaddr_in addr {};
+        addr.sin_family      = AF_INET;
+        addr.sin_port        = htons(port);
+        addr.sin_addr.s_addr = htonl(address);
+        socklen_t addr_size  = sizeof(addr);
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), addr_size) == -1 || ::listen(fd, 4) == -1 ||
+            ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &addr_size) == -1) {
+            ::close(fd);
+            return -1;
+        }
+
+        port = ntohs(addr.sin_port);
+        return fd;
+    }
+
+    static Connection accept(int listener)
+    {
+        pollfd pfd { listener, POLLIN, 0 };
+        if (::poll(&pfd, 1, 5000) != 1) return Connection {};
+        return Connection { ::accept(listener, nullptr, nullptr) };
+    }
+
+    static std::vector<std::uint8_t> configuration(std::uint16_t range_in_bins, std::uint16_t rotation_speed = 0)
+    {
+        Network::Colossus_protocol::Configuration config {};
+        config.encoder_size(encoder_size);
+        config.azimuth_samples(azimuth_samples);
+        config.range_in_bins(range_in_bins);
+        config.rotation_speed(rotation_speed);
+
+        Colossus::Protobuf::ConfigurationData protobuf {};
+        protobuf.set_rangeresolutionmetres(0.175f);
+
+        Message msg {};
+        msg.type(Message_type::configuration);
+        msg.append(config);
+        msg.append(protobuf.SerializeAsString());
+        return msg.relinquish();
+    }
+
+    static std::vector<std::uint8_t> fft(std::uint16_t azimuth)
+    {
+        Network::Colossus_protocol::Fft_data header {};
+        header.azimuth(azimuth);
+
+        Message msg {};
+        msg.type(Message_type::fft_data);
+        msg.append(header);
+        msg.append(std::vector<std::uint8_t>(100, 0x40));
+        return msg.relinquish();
+    }
+
+    void record(std::string event)
+    {
+        std::lock_guard lock { events_mutex };
+        events.push_back(std::move(event));
+    }
+
+    bool wait_for(const std::string& event)
+    {
+        for (auto deadline = std::chrono::steady_clock::now() + 2s; std::chrono::steady_clock::now() < deadline;) {
+            {
+                std::lock_guard lock { events_mutex };
+                if (!events.empty() && events.back() == event) return true;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return false;
+    }
+
+    // Both radars have sent their configuration, and the primary is
+    // sending FFT data, azimuths 0 to last_azimuth
+    //
+    void start_streaming(std::uint16_t rotation_speed, std::uint16_t last_azimuth)
+    {
+        standby.send(configuration(standby_range, rotation_speed));
+        primary.send(configuration(primary_range, rotation_speed));
+        ASSERT_TRUE(wait_for("configuration " + std::to_string(primary_range)));
+
+        client->start_fft_data();
+        ASSERT_EQ(Message_type::start_fft_data, primary.receive_type());
+
+        for (std::uint16_t azimuth = 0; azimuth <= last_azimuth; azimuth += encoder_step) {
+            primary.send(fft(azimuth));
+        }
+        ASSERT_TRUE(wait_for("fft " + std::to_string(last_azimuth)));
+    }
+};
+
+
+TEST_F(given_a_radar_client_with_a_standby, WhenThePrimaryIsLostTheStandbyShouldTakeOverWithItsOwnConfiguration)
+{
+    const std::uint16_t last_primary { 9 * encoder_step };
+    const std::uint16_t first_standby { 13 * encoder_step };
+
+    auto streaming_started = std::chrono::steady_clock::now();
+    start_streaming(0, last_primary);
+
+    primary = Connection {};
+
+    // The stream is requested again on the standby
+    //
+    ASSERT_EQ(Message_type::start_fft_data, standby.receive_type());
+
+    std::this_thread::sleep_for(50ms);
+    standby.send(fft(first_standby));
+    ASSERT_TRUE(wait_for("fft " + std::to_string(first_standby)));
+    auto latency_limit = std::chrono::steady_clock::now() - streaming_started;
+
+    // The configuration the standby sent at the start is applied before
+    // its first data, without waiting for it to be sent again
+    //
+    std::lock_guard lock { events_mutex };
+    ASSERT_EQ(13u, events.size());
+    ASSERT_EQ("fft " + std::to_string(last_primary), events[10]);
+    ASSERT_EQ("configuration " + std::to_string(standby_range), events[11]);
+
+    // Three azimuths were never sent
+    //
+    ASSERT_EQ(1u, reports.size());
+    ASSERT_EQ("127.0.0.1", reports[0].from_address.to_string());
+    ASSERT_EQ("127.0.0.2", reports[0].to_address.to_string());
+    ASSERT_EQ(3u, reports[0].azimuths_lost);
+    ASSERT_GE(reports[0].switchover_latency, 50ms);
+    ASSERT_LE(reports[0].switchover_latency, latency_limit);
+}
+
+
+TEST_F(given_a_radar_client_with_a_standby, WhenThePrimaryFallsSilentTheStandbyShouldTakeOver)
+{
+    // At 4 Hz, a quarter of a rotation is 62ms
+    //
+    start_streaming(4000, 20 * encoder_step);
+
+    auto silent_since = std::chrono::steady_clock::now();
+    ASSERT_EQ(Message_type::start_fft_data, standby.receive_type(2000ms));
+    ASSERT_GE(std::chrono::steady_clock::now() - silent_since, 50ms);
+
+    // The primary is still connected, so its stream is stopped
+    //
+    ASSERT_EQ(Message_type::stop_fft_data, primary.receive_type());
+
+    standby.send(fft(21 * encoder_step));
+    ASSERT_TRUE(wait_for("fft " + std::to_string(21 * encoder_step)));
+
+    std::lock_guard lock { events_mutex };
+    ASSERT_EQ(1u, reports.size());
+    ASSERT_EQ(0u, reports[0].azimuths_lost);
+}
+
+
+TEST_F(given_a_radar_client_with_a_standby, WhenTheStandbyIsIdleItsDataShouldNotBeDelivered)
+{
+    start_streaming(0, 5 * encoder_step);
+
+    standby.send(fft(100 * encoder_step));
+    primary.send(fft(6 * encoder_step));
+    ASSERT_TRUE(wait_for("fft " + std::to_string(6 * encoder_step)));
+
+    std::lock_guard lock { events_mutex };
+    for (auto& event : events) {
+        ASSERT_NE("fft " + std::to_string(100 * encoder_step), event);
+    }
+    ASSERT_TRUE(reports.empty());
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "../rotation/range_table.h"
+
+using namespace Navtech;
+
+class given_a_range_table : public ::testing::Test {
+protected:
+    static constexpr std::uint16_t range_in_bins { 2856 };
+    static constexpr double bin_size { 0.1752 };
+
+    std::mt19937 random { 2856 };
+
+    // The gains and offsets radars are configured with, and some that are
+    // not
+    //
+    struct Calibration
+    {
+        float gain;
+        float offset;
+    };
+    const std::vector<Calibration> calibrations {
+        { 1.0f, 0.0f }, { 1.0f, 2.5f }, { 0.9876f, -1.25f }, { 1.1f, 0.35f }, { 2.0f, -300.0f }
+    };
+};
+
+
+TEST_F(given_a_range_table, WhenLookedUpEachBinShouldMatchTheFormula)
+{
+    for (auto& calibration : calibrations) {
+        Range_table table { range_in_bins, bin_size, calibration.gain, calibration.offset };
+
+        ASSERT_FALSE(table.empty());
+        ASSERT_EQ(range_in_bins, table.range_in_bins());
+        ASSERT_EQ(bin_size, table.bin_size());
+        ASSERT_EQ(calibration.gain, table.gain());
+        ASSERT_EQ(calibration.offset, table.offset());
+
+        for (std::uint16_t bin = 0; bin < range_in_bins; ++bin) {
+            auto expected =
+                static_cast<float>((static_cast<double>(bin) * calibration.gain * bin_size) + calibration.offset);
+            ASSERT_EQ(expected, table.range(bin)) << calibration.gain << ", " << bin;
+            ASSERT_EQ(expected, table.row()[bin]) << calibration.gain << ", " << bin;
+        }
+
+        // A row from a first bin starts at that bin's range
+        //
+        for (std::uint16_t first_bin : { 1, 100, range_in_bins - 1 }) {
+            ASSERT_EQ(table.range(first_bin), table.row(first_bin)[0]);
+        }
+    }
+}
+
+
+TEST_F(given_a_range_table, WhenABinIsPastTheEndItsRangeShouldBeCalculated)
+{
+    for (auto& calibration : calibrations) {
+        Range_table table { 100, bin_size, calibration.gain, calibration.offset };
+
+        for (std::uint32_t bin = 100; bin <= 0xffff; bin += 97) {
+            auto expected =
+                static_cast<float>((static_cast<double>(bin) * calibration.gain * bin_size) + calibration.offset);
+            ASSERT_EQ(expected, table.range(static_cast<std::uint16_t>(bin))) << calibration.gain << ", " << bin;
+        }
+        ASSERT_EQ(static_cast<float>(table.fractional_range(100)), table.range(100));
+    }
+
+    // An empty table calculates every range
+    //
+    Range_table empty {};
+    ASSERT_TRUE(empty.empty());
+    ASSERT_EQ(0.0f, empty.range(1000));
+}
+
+
+TEST_F(given_a_range_table, WhenConvertingBackBinAtShouldInvertFractionalRange)
+{
+    std::uniform_real_distribution<double> fractional_bin { 0.0, 65535.0 };
+
+    for (auto& calibration : calibrations) {
+        Range_table table { range_in_bins, bin_size, calibration.gain, calibration.offset };
+
+        for (auto n = 0; n < 1000; ++n) {
+            auto bin = fractional_bin(random);
+            ASSERT_NEAR(bin, table.bin_at(table.fractional_range(bin)), 1e-9) << calibration.gain << ", " << bin;
+        }
+
+        // Whole bins convert back to themselves from the table
+        //
+        for (std::uint16_t bin = 0; bin < range_in_bins; bin += 7) {
+            ASSERT_NEAR(bin, table.bin_at(table.range(bin)), 1e-3) << calibration.gain << ", " << bin;
+        }
+    }
+}
+
+
+TEST_F(given_a_range_table, WhenTheGainOrBinSizeIsZeroBinAtShouldReturnZero)
+{
+    Range_table zero_gain { range_in_bins, bin_size, 0.0f, 2.5f };
+    Range_table zero_bin_size { range_in_bins, 0.0, 1.0f, 2.5f };
+    Range_table empty {};
+
+    for (auto range : { -10.0, 0.0, 2.5, 100.0 }) {
+        ASSERT_EQ(0.0, zero_gain.bin_at(range)) << range;
+        ASSERT_EQ(0.0, zero_bin_size.bin_at(range)) << range;
+        ASSERT_EQ(0.0, empty.bin_at(range)) << range;
+    }
+
+    // Every bin is at the offset
+    //
+    ASSERT_EQ(2.5f, zero_gain.range(0));
+    ASSERT_EQ(2.5f, zero_gain.range(range_in_bins - 1));
+}
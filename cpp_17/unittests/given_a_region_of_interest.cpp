@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../rotation/region_of_interest.h"
+#include "../rotation/rotation_assembler.h"
+
+using namespace Navtech;
+
+class given_a_region_of_interest : public ::testing::Test {
+protected:
+    static constexpr std::uint16_t azimuth_samples { 400 };
+    static constexpr std::uint16_t range_in_bins { 1000 };
+    static constexpr std::uint16_t encoder_size { 5600 };
+    static constexpr std::uint16_t encoder_step { encoder_size / azimuth_samples };
+
+    std::mt19937 random { 2856 };
+
+    // Brute force: step from the start of the sector to its end
+    //
+    static bool in_sector(const Region_of_interest& roi, std::uint16_t azimuth_index)
+    {
+        if (roi.start_azimuth == roi.end_azimuth) return true;
+
+        for (auto index = roi.start_azimuth; index != roi.end_azimuth; index = (index + 1) % azimuth_samples) {
+            if (index == azimuth_index) return true;
+        }
+        return false;
+    }
+};
+
+
+TEST_F(given_a_region_of_interest, WhenTheSectorWrapsThroughZeroItShouldContainBothEnds)
+{
+    for (auto trial = 0; trial < 200; ++trial) {
+        Region_of_interest roi {};
+        roi.start_azimuth = static_cast<std::uint16_t>(random() % azimuth_samples);
+        roi.end_azimuth   = static_cast<std::uint16_t>(random() % azimuth_samples);
+        if (trial == 0) roi.end_azimuth = roi.start_azimuth;
+
+        for (std::uint16_t index = 0; index < azimuth_samples; ++index) {
+            ASSERT_EQ(in_sector(roi, index), roi.contains_azimuth(index))
+                << roi.start_azimuth << ", " << roi.end_azimuth << ", " << index;
+        }
+    }
+}
+
+
+TEST_F(given_a_region_of_interest, WhenTheWindowIsOutOfRangeItShouldBeClampedToTheBins)
+{
+    Region_of_interest roi {};
+    ASSERT_EQ(0u, roi.first_bin(range_in_bins));
+    ASSERT_EQ(range_in_bins, roi.bins(range_in_bins));
+
+    roi.start_bin = 100;
+    roi.end_bin   = 300;
+    ASSERT_EQ(100u, roi.first_bin(range_in_bins));
+    ASSERT_EQ(200u, roi.bins(range_in_bins));
+
+    roi.end_bin = 5000;
+    ASSERT_EQ(900u, roi.bins(range_in_bins));
+
+    roi.end_bin = 50;
+    ASSERT_EQ(0u, roi.bins(range_in_bins));
+
+    roi.start_bin = 2000;
+    roi.end_bin   = 0;
+    ASSERT_EQ(range_in_bins, roi.first_bin(range_in_bins));
+    ASSERT_EQ(0u, roi.bins(range_in_bins));
+}
+
+
+TEST_F(given_a_region_of_interest, WhenAWrappedSectorHasPassedTheAssemblerShouldDeliverIt)
+{
+    Region_of_interest roi {};
+    roi.start_azimuth = 350;
+    roi.end_azimuth   = 50;
+    roi.start_bin     = 100;
+    roi.end_bin       = 300;
+
+    Rotation_assembler assembler {};
+    std::vector<Rotation_frame_handle> delivered {};
+    assembler.set_pool_size(2, Page_size::standard);
+    assembler.configure(azimuth_samples, range_in_bins, encoder_size, roi);
+    assembler.set_rotation_callback([&delivered](const Rotation_frame_handle& frame) { delivered.push_back(frame); });
+
+    // The client passes only the window's bins, and skips azimuths
+    // outside the sector
+    //
+    std::vector<std::vector<std::uint8_t>> windows(azimuth_samples, std::vector<std::uint8_t>(roi.bins(range_in_bins)));
+    auto feed = [&](std::uint16_t first, std::uint16_t count) {
+        for (std::uint16_t n = 0; n < count; ++n) {
+            auto index = static_cast<std::uint16_t>((first + n) % azimuth_samples);
+            Azimuth_record record {};
+            record.azimuth = static_cast<std::uint16_t>(index * encoder_step);
+
+            if (!roi.contains_azimuth(index)) {
+                assembler.skip(record.azimuth);
+                continue;
+            }
+            for (auto& sample : windows[index]) {
+                sample = static_cast<std::uint8_t>(random() % 256);
+            }
+            assembler.add(record, windows[index].data(), windows[index].size());
+        }
+    };
+
+    // A partial sector, then a whole one. The sector is delivered as the
+    // first azimuth after it arrives, not a rotation later.
+    //
+    feed(0, 50);
+    feed(50, azimuth_samples);
+    ASSERT_TRUE(delivered.empty());
+
+    feed(50, 1);
+    ASSERT_EQ(1u, delivered.size());
+
+    auto& frame = delivered[0];
+    ASSERT_EQ(roi.bins(range_in_bins), frame->range_in_bins());
+    ASSERT_EQ(roi.first_bin(range_in_bins), frame->first_bin());
+    ASSERT_EQ(100u, frame->valid_azimuths());
+
+    for (std::uint16_t index = 0; index < azimuth_samples; ++index) {
+        ASSERT_EQ(roi.contains_azimuth(index), frame->is_valid(index)) << index;
+        if (!frame->is_valid(index)) continue;
+
+        ASSERT_EQ(0, std::memcmp(windows[index].data(), frame->row(index), windows[index].size())) << index;
+    }
+}
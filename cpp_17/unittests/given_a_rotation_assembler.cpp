@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../rotation/rotation_assembler.h"
+
+using namespace Navtech;
+
+class given_a_rotation_assembler : public ::testing::Test {
+protected:
+    static constexpr std::uint16_t azimuth_samples { 400 };
+    static constexpr std::uint16_t range_in_bins { 300 };
+    static constexpr std::uint16_t encoder_size { 5600 };
+
+    Rotation_assembler assembler {};
+    std::vector<Rotation_frame_handle> delivered {};
+    std::mt19937 random { 2856 };
+
+    void configure(std::size_t pool_size)
+    {
+        assembler.set_pool_size(pool_size, Page_size::standard);
+        assembler.configure(azimuth_samples, range_in_bins, encoder_size);
+        assembler.set_rotation_callback([this](const Rotation_frame_handle& frame) { delivered.push_back(frame); });
+    }
+
+    // One rotation of random FFT data, a row per azimuth index
+    //
+    std::vector<std::vector<std::uint8_t>> make_rotation()
+    {
+        std::vector<std::vector<std::uint8_t>> rows(azimuth_samples, std::vector<std::uint8_t>(range_in_bins));
+        for (auto& row : rows) {
+            for (auto& sample : row) {
+                sample = static_cast<std::uint8_t>(random() % 256);
+            }
+        }
+        return rows;
+    }
+
+    // Add azimuth indices first to last - 1, skipping any in missing
+    //
+    void add(const std::vector<std::vector<std::uint8_t>>& rows,
+             std::uint16_t first                    = 0,
+             std::uint16_t last                     = azimuth_samples,
+             const std::set<std::uint16_t>& missing = {})
+    {
+        for (auto index = first; index < last; ++index) {
+            Azimuth_record record {};
+            record.azimuth       = static_cast<std::uint16_t>(index * (encoder_size / azimuth_samples));
+            record.sweep_counter = index;
+
+            if (missing.count(index) != 0) {
+                assembler.skip(record.azimuth);
+                continue;
+            }
+            assembler.add(record, rows[index].data(), rows[index].size());
+        }
+    }
+
+    void assert_holds(const Rotation_frame_handle& frame,
+                      const std::vector<std::vector<std::uint8_t>>& rows,
+                      const std::set<std::uint16_t>& missing = {})
+    {
+        ASSERT_TRUE(frame);
+        ASSERT_EQ(azimuth_samples, frame->azimuth_samples());
+        ASSERT_EQ(range_in_bins, frame->range_in_bins());
+        ASSERT_EQ(azimuth_samples - missing.size(), frame->valid_azimuths());
+
+        for (std::uint16_t index = 0; index < azimuth_samples; ++index) {
+            auto received = (missing.count(index) == 0);
+            ASSERT_EQ(received, frame->is_valid(index)) << index;
+
+            auto row = frame->row(index);
+            for (std::uint16_t bin = 0; bin < range_in_bins; ++bin) {
+                ASSERT_EQ(received ? rows[index][bin] : 0, row[bin]) << index << ", " << bin;
+            }
+        }
+    }
+};
+
+
+TEST_F(given_a_rotation_assembler, WhenTheAzimuthWrapsItShouldDeliverTheRotation)
+{
+    configure(4);
+    auto partial = make_rotation();
+    auto first   = make_rotation();
+    auto second  = make_rotation();
+
+    add(partial, 150);
+    add(first);
+    ASSERT_TRUE(delivered.empty());
+
+    add(second, 0, 1);
+    ASSERT_EQ(1u, delivered.size());
+    ASSERT_EQ(1u, assembler.rotations_completed());
+    ASSERT_EQ(1u, delivered[0]->rotation());
+    assert_holds(delivered[0], first);
+}
+
+
+TEST_F(given_a_rotation_assembler, WhenTheFirstRotationIsPartialItShouldBeDiscarded)
+{
+    configure(4);
+    auto partial = make_rotation();
+    auto first   = make_rotation();
+
+    add(partial, 150);
+    add(first, 0, 1);
+    ASSERT_TRUE(delivered.empty());
+    ASSERT_EQ(0u, assembler.rotations_completed());
+}
+
+
+TEST_F(given_a_rotation_assembler, WhenAConsumerHoldsARotationTheNextShouldNotOverwriteIt)
+{
+    configure(4);
+    std::vector<std::vector<std::vector<std::uint8_t>>> rotations {};
+    for (auto n = 0; n < 4; ++n) {
+        rotations.push_back(make_rotation());
+    }
+
+    add(make_rotation(), 200);
+    for (auto& rotation : rotations) {
+        add(rotation);
+    }
+    add(make_rotation(), 0, 1);
+
+    // Four held and one filling would need five frames; the fourth
+    // rotation is dropped rather than written over a held one
+    //
+    ASSERT_EQ(3u, delivered.size());
+    ASSERT_EQ(1u, assembler.rotations_dropped());
+    for (std::size_t n = 0; n < delivered.size(); ++n) {
+        assert_holds(delivered[n], rotations[n]);
+    }
+}
+
+
+TEST_F(given_a_rotation_assembler, WhenConsumersReleaseRotationsTheFramesShouldBeReused)
+{
+    configure(2);
+    add(make_rotation(), 200);
+
+    // Each rotation is delivered as the next one starts
+    //
+    std::vector<std::vector<std::uint8_t>> previous {};
+    for (auto n = 0; n < 20; ++n) {
+        auto rotation = make_rotation();
+        add(rotation);
+
+        if (n > 0) {
+            ASSERT_EQ(1u, delivered.size());
+            assert_holds(delivered[0], previous);
+        }
+        delivered.clear();
+        previous = rotation;
+    }
+    ASSERT_EQ(19u, assembler.rotations_completed());
+    ASSERT_EQ(0u, assembler.rotations_dropped());
+}
+
+
+TEST_F(given_a_rotation_assembler, WhenAzimuthsAreMissingTheirRowsShouldBeBlanked)
+{
+    configure(2);
+    add(make_rotation(), 200);
+
+    // Fill both frames, so the missing rows would otherwise hold stale data
+    //
+    for (auto n = 0; n < 3; ++n) {
+        add(make_rotation());
+        delivered.clear();
+    }
+
+    std::set<std::uint16_t> missing { 0, 1, 57, 58, 59, 200, 399 };
+    auto rotation = make_rotation();
+    add(rotation, 0, azimuth_samples, missing);
+    delivered.clear();
+    add(make_rotation(), 0, 1);
+
+    ASSERT_EQ(1u, delivered.size());
+    assert_holds(delivered[0], rotation, missing);
+}
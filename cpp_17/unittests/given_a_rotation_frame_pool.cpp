@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "../rotation/rotation_frame_pool.h"
+#include "../utility/pointer_types.h"
+
+using namespace Navtech;
+
+class given_a_rotation_frame_pool : public ::testing::Test {
+protected:
+    static constexpr std::size_t frame_count { 3 };
+    static constexpr std::uint16_t azimuth_samples { 400 };
+    static constexpr std::uint16_t range_in_bins { 1000 };
+    static constexpr std::uint16_t encoder_size { 5600 };
+
+    Owner_of<Rotation_frame_pool> pool { allocate_owned<Rotation_frame_pool>(
+        frame_count, azimuth_samples, range_in_bins, encoder_size, Page_size::standard) };
+};
+
+
+TEST_F(given_a_rotation_frame_pool, WhenEveryFrameIsAcquiredItShouldReturnAnEmptyHandle)
+{
+    std::vector<Rotation_frame_handle> held {};
+    for (std::size_t n = 0; n < frame_count; ++n) {
+        held.push_back(pool->acquire());
+        ASSERT_TRUE(held.back());
+        ASSERT_EQ(frame_count - n - 1, pool->available());
+    }
+
+    ASSERT_FALSE(pool->acquire());
+
+    held.pop_back();
+    ASSERT_EQ(1u, pool->available());
+    ASSERT_TRUE(pool->acquire());
+}
+
+
+TEST_F(given_a_rotation_frame_pool, WhenAFrameIsAcquiredItsRowsShouldStartOnCacheLines)
+{
+    auto frame = pool->acquire();
+
+    ASSERT_EQ(azimuth_samples, frame->azimuth_samples());
+    ASSERT_EQ(range_in_bins, frame->range_in_bins());
+    ASSERT_EQ(encoder_size, frame->encoder_size());
+    ASSERT_GE(frame->stride(), range_in_bins);
+    ASSERT_EQ(0u, frame->stride() % 64);
+
+    for (std::uint16_t index = 0; index < azimuth_samples; ++index) {
+        ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(frame->row(index)) % 64);
+    }
+}
+
+
+TEST_F(given_a_rotation_frame_pool, WhenAHandleIsCopiedTheFrameShouldReturnWithTheLastCopy)
+{
+    auto frame = pool->acquire();
+    ASSERT_TRUE(frame.unique());
+
+    auto copy        = frame;
+    auto second_copy = copy;
+    ASSERT_EQ(3u, frame.use_count());
+    ASSERT_EQ(frame.get(), second_copy.get());
+    ASSERT_EQ(frame_count - 1, pool->available());
+
+    frame.reset();
+    copy.reset();
+    ASSERT_EQ(1u, second_copy.use_count());
+    ASSERT_EQ(frame_count - 1, pool->available());
+
+    second_copy.reset();
+    ASSERT_EQ(0u, second_copy.use_count());
+    ASSERT_EQ(frame_count, pool->available());
+}
+
+
+TEST_F(given_a_rotation_frame_pool, WhenAHandleIsMovedTheCountShouldNotChange)
+{
+    auto frame = pool->acquire();
+    auto moved = std::move(frame);
+    ASSERT_FALSE(frame);
+    ASSERT_EQ(1u, moved.use_count());
+
+    Rotation_frame_handle assigned {};
+    assigned = std::move(moved);
+    ASSERT_EQ(1u, assigned.use_count());
+
+    auto& self = assigned;
+    assigned   = self;
+    assigned   = std::move(self);
+    ASSERT_EQ(1u, assigned.use_count());
+    ASSERT_EQ(frame_count - 1, pool->available());
+
+    // Assigning over a handle releases the frame it held
+    //
+    assigned = pool->acquire();
+    ASSERT_EQ(frame_count - 1, pool->available());
+}
+
+
+TEST_F(given_a_rotation_frame_pool, WhenAFrameIsReacquiredItShouldBeCleared)
+{
+    {
+        auto frame = pool->acquire();
+        frame.writable().rotation(7);
+        std::vector<std::uint8_t> data(range_in_bins, 0xa5);
+        for (std::uint16_t index = 0; index < azimuth_samples; ++index) {
+            frame.writable().write(index, Azimuth_record {}, data.data(), data.size());
+        }
+        ASSERT_TRUE(frame->is_complete());
+    }
+
+    for (std::size_t n = 0; n < frame_count; ++n) {
+        auto frame = pool->acquire();
+        ASSERT_EQ(0u, frame->rotation());
+        ASSERT_EQ(0u, frame->valid_azimuths());
+        ASSERT_EQ(0u, frame->continuity().azimuths_received);
+    }
+}
+
+
+TEST_F(given_a_rotation_frame_pool, WhenThePoolIsDestroyedHeldFramesShouldRemainUsable)
+{
+    auto frame = pool->acquire();
+    auto copy  = frame;
+    pool.reset();
+
+    std::vector<std::uint8_t> data(range_in_bins, 0x5a);
+    frame.writable().write(azimuth_samples - 1, Azimuth_record {}, data.data(), data.size());
+    frame.reset();
+
+    ASSERT_TRUE(copy->is_valid(azimuth_samples - 1));
+    ASSERT_EQ(0, std::memcmp(data.data(), copy->row(azimuth_samples - 1), data.size()));
+    copy.reset();
+}
+
+
+TEST_F(given_a_rotation_frame_pool, WhenHandlesAreReleasedOnManyThreadsEveryFrameShouldReturn)
+{
+    std::vector<std::thread> threads {};
+    for (auto t = 0; t < 4; ++t) {
+        threads.emplace_back([this] {
+            for (auto n = 0; n < 20000; ++n) {
+                auto frame = pool->acquire();
+                if (!frame) continue;
+
+                std::vector<Rotation_frame_handle> copies(3, frame);
+                frame.reset();
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(frame_count, pool->available());
+}
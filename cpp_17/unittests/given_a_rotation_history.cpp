@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "../rotation/rotation_history.h"
+#include "../utility/pointer_types.h"
+
+using namespace Navtech;
+using namespace std::chrono_literals;
+
+// Rotations of four single-bin rows, each timestamped, added to a history
+// and to a brute-force copy of what the history should hold
+//
+class given_a_rotation_history : public ::testing::Test {
+protected:
+    static constexpr std::size_t depth { 8 };
+    static constexpr std::uint16_t azimuth_samples { 4 };
+
+    // Each rotation spans three quarters of its period; the gap is
+    // between its last row and the next rotation's first
+    //
+    struct Span
+    {
+        std::uint64_t rotation;
+        Radar_time start;
+        Radar_time end;
+    };
+
+    Owner_of<Rotation_frame_pool> pool { allocate_owned<Rotation_frame_pool>(
+        depth + 2, azimuth_samples, std::uint16_t { 1 }, std::uint16_t { 5600 }, Page_size::standard) };
+    Rotation_history history { depth };
+    std::deque<Span> held {};
+
+    Radar_time next_start { std::chrono::seconds { 1700000000 } };
+    std::mt19937 random { 2856 };
+
+    void add(std::uint64_t rotation, std::chrono::nanoseconds period = 250ms)
+    {
+        add(*pool, history, rotation, next_start, period);
+
+        if (!held.empty() && rotation <= held.back().rotation) held.clear();
+        held.push_back({ rotation, next_start, next_start + (period * 3) / 4 });
+        while (held.front().rotation + depth <= rotation) held.pop_front();
+
+        next_start += period;
+    }
+
+    static void add(Rotation_frame_pool& frames,
+                    Rotation_history& to,
+                    std::uint64_t rotation,
+                    Radar_time start,
+                    std::chrono::nanoseconds period)
+    {
+        auto frame = frames.acquire();
+        ASSERT_TRUE(frame);
+
+        for (std::uint16_t row = 0; row < azimuth_samples; ++row) {
+            auto time    = (start + (period * row) / 4).time_since_epoch();
+            auto seconds = std::chrono::floor<std::chrono::seconds>(time);
+
+            Azimuth_record record {};
+            record.ntp_seconds       = static_cast<std::uint32_t>(seconds.count());
+            record.ntp_split_seconds = static_cast<std::uint32_t>((time - seconds).count());
+            frame.writable().mark(row, record);
+        }
+        frame.writable().rotation(rotation);
+        to.add(frame);
+    }
+
+    static std::chrono::nanoseconds distance(const Span& span, Radar_time time)
+    {
+        if (time < span.start) return span.start - time;
+        if (time > span.end) return time - span.end;
+        return 0ns;
+    }
+
+    // The held rotation nearest to time; the first of any that are
+    // equally near
+    //
+    const Span& brute_force_nearest(Radar_time time) const
+    {
+        auto best = &held.front();
+        for (auto& span : held) {
+            if (distance(span, time) < distance(*best, time)) best = &span;
+        }
+        return *best;
+    }
+
+    void assert_nearest(Radar_time time) const
+    {
+        auto found = history.nearest(time);
+        ASSERT_TRUE(found);
+
+        auto& expected = brute_force_nearest(time);
+        const Span* actual { nullptr };
+        for (auto& span : held) {
+            if (span.rotation == found->rotation()) actual = &span;
+        }
+        ASSERT_NE(nullptr, actual) << found->rotation();
+        ASSERT_EQ(distance(expected, time).count(), distance(*actual, time).count())
+            << "expected " << expected.rotation << ", found " << actual->rotation;
+    }
+
+    // Times from before the oldest rotation held to after the newest
+    //
+    void assert_nearest_throughout()
+    {
+        auto first = held.front().start - 1s;
+        auto span  = (held.back().end + 1s) - first;
+
+        for (auto n = 0; n < 2000; ++n) {
+            auto offset = std::chrono::nanoseconds { static_cast<std::int64_t>(random() % span.count()) };
+            assert_nearest(first + offset);
+        }
+        for (auto& rotation : held) {
+            assert_nearest(rotation.start);
+            assert_nearest(rotation.end);
+            assert_nearest(rotation.end + 1ns);
+        }
+    }
+};
+
+
+TEST_F(given_a_rotation_history, WhenRotationsAreAddedTheLastDepthShouldBeFoundByNumberAndAge)
+{
+    ASSERT_TRUE(history.empty());
+    ASSERT_FALSE(history.ago(0));
+    ASSERT_FALSE(history.nearest(next_start));
+
+    for (std::uint64_t rotation = 1; rotation <= 20; ++rotation) {
+        add(rotation);
+    }
+    ASSERT_FALSE(history.empty());
+    ASSERT_EQ(20u, history.newest_rotation());
+
+    for (std::uint64_t rotation = 20 - depth + 1; rotation <= 20; ++rotation) {
+        auto frame = history.rotation(rotation);
+        ASSERT_TRUE(frame) << rotation;
+        ASSERT_EQ(rotation, frame->rotation());
+
+        auto same = history.ago(20 - rotation);
+        ASSERT_EQ(frame.get(), same.get()) << rotation;
+    }
+    ASSERT_FALSE(history.rotation(20 - depth));
+    ASSERT_FALSE(history.rotation(21));
+    ASSERT_FALSE(history.ago(depth));
+    ASSERT_FALSE(history.ago(1000));
+
+    // A dropped rotation leaves a gap
+    //
+    add(21);
+    add(23);
+    ASSERT_FALSE(history.rotation(22));
+    ASSERT_FALSE(history.ago(1));
+    ASSERT_EQ(21u, history.ago(2)->rotation());
+}
+
+
+TEST_F(given_a_rotation_history, WhenThePeriodIsSteadyNearestShouldFindTheClosestRotation)
+{
+    for (std::uint64_t rotation = 1; rotation <= 3 * depth; ++rotation) {
+        add(rotation);
+    }
+    assert_nearest_throughout();
+
+    // Within a rotation's span, that rotation
+    //
+    for (auto& rotation : held) {
+        ASSERT_EQ(rotation.rotation, history.nearest(rotation.start + 10ms)->rotation());
+    }
+}
+
+
+TEST_F(given_a_rotation_history, WhenThePeriodChangesNearestShouldFindTheClosestRotationBeyondTheEstimate)
+{
+    // The estimate comes from the two newest rotations, which are far
+    // further apart than the rest; it picks a slot well away from the
+    // right one for any earlier time
+    //
+    for (std::uint64_t rotation = 1; rotation < depth; ++rotation) {
+        add(rotation, 50ms);
+    }
+    add(depth, 3s);
+    assert_nearest_throughout();
+
+    // And the reverse, with an estimate too short
+    //
+    for (std::uint64_t rotation = depth + 1; rotation < 2 * depth; ++rotation) {
+        add(rotation, 2s);
+    }
+    add(2 * depth, 10ms);
+    assert_nearest_throughout();
+
+    // With dropped rotations among them
+    //
+    for (std::uint64_t rotation = 2 * depth + 1; rotation <= 4 * depth; rotation += 1 + random() % 3) {
+        add(rotation, std::chrono::milliseconds { 10 + random() % 500 });
+    }
+    assert_nearest_throughout();
+}
+
+
+TEST_F(given_a_rotation_history, WhenRotationNumbersGoBackwardsItShouldStartAgain)
+{
+    for (std::uint64_t rotation = 1; rotation <= 10; ++rotation) {
+        add(rotation);
+    }
+
+    // A new source, numbering from the start again
+    //
+    add(3);
+    ASSERT_EQ(3u, history.newest_rotation());
+    ASSERT_EQ(3u, history.ago(0)->rotation());
+    ASSERT_FALSE(history.ago(1));
+    ASSERT_FALSE(history.rotation(10));
+    ASSERT_FALSE(history.rotation(5));
+    ASSERT_EQ(pool->capacity() - 1, pool->available());
+
+    add(4);
+    ASSERT_EQ(3u, history.ago(1)->rotation());
+    assert_nearest_throughout();
+}
+
+
+TEST_F(given_a_rotation_history, WhenRotationsAreEvictedTheirFramesShouldReturnToThePool)
+{
+    // The history holds no more than depth frames out of the pool, however
+    // many rotations pass through it
+    //
+    for (std::uint64_t rotation = 1; rotation <= 10 * depth; ++rotation) {
+        add(rotation);
+        ASSERT_EQ(pool->capacity() - std::min<std::size_t>(rotation, depth), pool->available()) << rotation;
+    }
+
+    // A frame held elsewhere is returned once it is released too
+    //
+    auto kept = history.ago(depth - 1);
+    add(10 * depth + 1);
+    ASSERT_FALSE(history.rotation(kept->rotation()));
+    ASSERT_EQ(pool->capacity() - depth - 1, pool->available());
+    kept.reset();
+    ASSERT_EQ(pool->capacity() - depth, pool->available());
+
+    history.clear();
+    ASSERT_TRUE(history.empty());
+    ASSERT_EQ(pool->capacity(), pool->available());
+
+    add(1);
+    history.set_depth(2);
+    ASSERT_EQ(2u, history.depth());
+    ASSERT_EQ(pool->capacity(), pool->available());
+}
+
+
+TEST_F(given_a_rotation_history, WhenItIsDeeperLookupsShouldTakeNoLonger)
+{
+    // Lookups in a history 512 times deeper take about as long; a search
+    // through it would take hundreds of times longer
+    //
+    constexpr std::size_t deep { depth * 512 };
+    constexpr auto lookups { 20000 };
+
+    Rotation_frame_pool deep_pool { deep + 1, azimuth_samples, 1, 5600, Page_size::standard };
+    Rotation_history deep_history { deep };
+    for (std::uint64_t rotation = 1; rotation <= deep; ++rotation) {
+        add(deep_pool, deep_history, rotation, next_start, 250ms);
+        add(rotation);
+    }
+
+    auto time = [&](const Rotation_history& lookup_in) {
+        auto newest  = lookup_in.newest_rotation();
+        auto oldest  = newest - std::min<std::uint64_t>(lookup_in.depth(), newest) + 1;
+        auto started = std::chrono::steady_clock::now();
+
+        std::uint64_t found { 0 };
+        for (auto n = 0; n < lookups; ++n) {
+            auto rotation = oldest + random() % (newest - oldest + 1);
+            found += lookup_in.rotation(rotation)->rotation();
+            found += lookup_in.ago(newest - rotation)->rotation();
+            found += lookup_in.nearest(next_start - (newest - rotation) * 250ms)->rotation();
+        }
+        EXPECT_NE(0u, found);
+        return std::chrono::steady_clock::now() - started;
+    };
+
+    // The fastest of a few runs of each, to discount interruptions
+    //
+    auto shallow_time = std::chrono::steady_clock::duration::max();
+    auto deep_time    = std::chrono::steady_clock::duration::max();
+    for (auto run = 0; run < 5; ++run) {
+        shallow_time = std::min(shallow_time, time(history));
+        deep_time    = std::min(deep_time, time(deep_history));
+    }
+    ASSERT_LT(deep_time, 8 * shallow_time);
+
+    ASSERT_EQ(deep_pool.capacity() - deep, deep_pool.available());
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../rotation/rotation_assembler.h"
+#include "../rotation/rotation_reducer.h"
+
+using namespace Navtech;
+
+class given_a_rotation_reducer : public ::testing::Test {
+protected:
+    static constexpr std::uint16_t azimuth_samples { 399 };
+    static constexpr std::uint16_t range_in_bins { 1001 };
+    static constexpr std::uint16_t encoder_size { 5586 };
+
+    Rotation_frame_pool pool { 1, azimuth_samples, range_in_bins, encoder_size, Page_size::standard };
+    Rotation_frame_handle in { pool.acquire() };
+    std::mt19937 random { 2856 };
+
+    void make_rotation(const std::vector<std::uint16_t>& missing = {})
+    {
+        auto& frame = in.writable();
+        frame.clear();
+        frame.first_bin(40);
+        frame.rotation(12);
+
+        std::vector<std::uint8_t> data(range_in_bins);
+        for (std::uint16_t index = 0; index < azimuth_samples; ++index) {
+            if (std::find(missing.begin(), missing.end(), index) != missing.end()) {
+                frame.invalidate(index);
+                continue;
+            }
+            for (auto& sample : data) {
+                sample = static_cast<std::uint8_t>(random() % 256);
+            }
+
+            Azimuth_record record {};
+            record.azimuth     = static_cast<std::uint16_t>(index * 14);
+            record.ntp_seconds = index;
+            frame.write(index, record, data.data(), data.size());
+        }
+    }
+
+    // Brute force: every output sample from its group of input samples
+    //
+    void assert_reduced(const Reduction_profile& profile, const Rotation_frame_handle& out)
+    {
+        auto factor = profile.range_factor;
+        auto stride = profile.azimuth_stride;
+
+        ASSERT_TRUE(out);
+        ASSERT_EQ((azimuth_samples + stride - 1) / stride, out->azimuth_samples());
+        ASSERT_EQ((range_in_bins + factor - 1) / factor, out->range_in_bins());
+        ASSERT_EQ(in->first_bin(), out->first_bin());
+        ASSERT_EQ(in->rotation(), out->rotation());
+
+        for (std::uint16_t row = 0; row < out->azimuth_samples(); ++row) {
+            auto source = static_cast<std::uint16_t>(row * stride);
+            ASSERT_EQ(in->is_valid(source), out->is_valid(row)) << row;
+
+            for (std::uint16_t bin = 0; bin < out->range_in_bins(); ++bin) {
+                std::uint32_t maximum = 0;
+                std::uint32_t sum     = 0;
+                std::uint32_t count   = 0;
+                for (auto n = bin * factor; n < std::min<int>((bin + 1) * factor, range_in_bins); ++n) {
+                    maximum = std::max<std::uint32_t>(maximum, in->row(source)[n]);
+                    sum += in->row(source)[n];
+                    ++count;
+                }
+
+                auto expected = (profile.range_reduction == Range_reduction::max) ? maximum : (sum + count / 2) / count;
+                if (!in->is_valid(source)) expected = 0;
+                ASSERT_EQ(expected, out->row(row)[bin]) << row << ", " << bin;
+            }
+            if (!out->is_valid(row)) continue;
+
+            ASSERT_EQ(in->record(source).azimuth, out->record(row).azimuth);
+            ASSERT_EQ(in->record(source).ntp_seconds, out->record(row).ntp_seconds);
+        }
+    }
+};
+
+
+TEST_F(given_a_rotation_reducer, WhenReducingTheFrameShouldMatchEachProfile)
+{
+    make_rotation({ 0, 3, 4, 5, 6, 200, 398 });
+
+    for (auto reduction : { Range_reduction::max, Range_reduction::mean }) {
+        for (std::uint16_t factor : { 1, 2, 3, 4, 8 }) {
+            for (std::uint16_t stride : { 1, 2, 3, 4 }) {
+                Reduction_profile profile { factor, reduction, stride };
+                Rotation_reducer reducer { profile };
+
+                auto out = reducer.reduce(*in);
+                assert_reduced(reducer.profile(), out);
+            }
+        }
+    }
+}
+
+
+TEST_F(given_a_rotation_reducer, WhenEveryReducedFrameIsHeldTheRotationShouldBeDropped)
+{
+    make_rotation();
+    Rotation_reducer reducer { Reduction_profile { 4, Range_reduction::max, 2 }, 2 };
+
+    auto first  = reducer.reduce(*in);
+    auto second = reducer.reduce(*in);
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+
+    ASSERT_FALSE(reducer.reduce(*in));
+    ASSERT_EQ(1u, reducer.rotations_dropped());
+
+    first.reset();
+    assert_reduced(reducer.profile(), reducer.reduce(*in));
+}
+
+
+TEST_F(given_a_rotation_reducer, WhenProfilesAreFullResolutionTheyShouldBeEqual)
+{
+    Reduction_profile full {};
+    Reduction_profile full_mean { 1, Range_reduction::mean, 1 };
+    Reduction_profile halved { 2, Range_reduction::max, 1 };
+    Reduction_profile halved_mean { 2, Range_reduction::mean, 1 };
+
+    ASSERT_TRUE(full.is_full_resolution());
+    ASSERT_EQ(full, full_mean);
+    ASSERT_NE(full, halved);
+    ASSERT_NE(halved, halved_mean);
+    ASSERT_EQ(halved, (Reduction_profile { 2, Range_reduction::max, 1 }));
+}
+
+
+TEST_F(given_a_rotation_reducer, WhenSubscribersShareAProfileEachShouldReceiveTheSameFrame)
+{
+    Rotation_assembler assembler {};
+    assembler.set_pool_size(3, Page_size::standard);
+    assembler.configure(azimuth_samples, range_in_bins, encoder_size);
+
+    Reduction_profile quarter { 4, Range_reduction::mean, 2 };
+    std::vector<Rotation_frame_handle> full {}, first {}, second {}, eighth {};
+    assembler.set_rotation_callback([&full](const Rotation_frame_handle& frame) { full.push_back(frame); });
+    assembler.add_subscriber(quarter, [&first](const Rotation_frame_handle& frame) { first.push_back(frame); });
+    auto id = assembler.add_subscriber(quarter, [&second](const Rotation_frame_handle& frame) {
+        second.push_back(frame);
+    });
+    assembler.add_subscriber(Reduction_profile { 8, Range_reduction::max, 1 },
+                             [&eighth](const Rotation_frame_handle& frame) { eighth.push_back(frame); });
+
+    std::vector<std::uint8_t> data(range_in_bins);
+    auto rotate = [&](std::uint16_t first_index, std::uint16_t last_index) {
+        for (auto index = first_index; index < last_index; ++index) {
+            for (auto& sample : data) {
+                sample = static_cast<std::uint8_t>(random() % 256);
+            }
+            Azimuth_record record {};
+            record.azimuth = static_cast<std::uint16_t>(index * 14);
+            assembler.add(record, data.data(), data.size());
+        }
+    };
+
+    rotate(200, azimuth_samples);
+    rotate(0, azimuth_samples);
+    rotate(0, 1);
+
+    ASSERT_EQ(1u, full.size());
+    ASSERT_EQ(1u, first.size());
+    ASSERT_EQ(1u, second.size());
+    ASSERT_EQ(1u, eighth.size());
+    ASSERT_EQ(first[0].get(), second[0].get());
+    ASSERT_NE(first[0].get(), eighth[0].get());
+
+    in = full[0];
+    assert_reduced(quarter, first[0]);
+    assert_reduced(Reduction_profile { 8, Range_reduction::max, 1 }, eighth[0]);
+
+    assembler.remove_subscriber(id);
+    full.clear();
+    rotate(1, azimuth_samples);
+    rotate(0, 1);
+    ASSERT_EQ(2u, first.size());
+    ASSERT_EQ(1u, second.size());
+}
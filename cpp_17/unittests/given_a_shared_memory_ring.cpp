@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "../network/colossus_messages.h"
+#include "../network/shared_memory_ring.h"
+
+using namespace Navtech;
+using namespace std::chrono_literals;
+using Network::Colossus_protocol::Message;
+
+class given_a_shared_memory_ring : public ::testing::Test {
+protected:
+    static constexpr std::uint32_t slot_count { 16 };
+    static constexpr std::uint32_t slot_size { 1024 };
+
+    const std::string name { "/iasdk_unittest_" + std::to_string(::getpid()) };
+
+    Shared_memory_publisher publisher { name, slot_count, slot_size };
+    Shared_memory_reader reader { name };
+
+    std::mutex received_mutex {};
+    std::vector<std::vector<std::uint8_t>> received {};
+    std::vector<std::vector<std::uint8_t>> configurations {};
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(publisher.open());
+        ASSERT_TRUE(reader.open());
+
+        reader.set_raw_fft_data_callback([this](const std::vector<std::uint8_t>& message) {
+            std::lock_guard lock { received_mutex };
+            received.push_back(message);
+        });
+        reader.set_raw_configuration_data_callback([this](const std::vector<std::uint8_t>& message) {
+            std::lock_guard lock { received_mutex };
+            configurations.push_back(message);
+        });
+    }
+
+    void TearDown() override
+    {
+        reader.close();
+        publisher.close();
+    }
+
+    // An FFT message whose payload is filled with value
+    //
+    static std::vector<std::uint8_t> fft_message(std::uint8_t value, std::size_t payload_size = 100)
+    {
+        Message msg {};
+        msg.type(Message::Type::fft_data);
+        msg.append(std::vector<std::uint8_t>(payload_size, value));
+        return msg.relinquish();
+    }
+
+    // Message n of a stream: n, then a size and fill that vary with n
+    //
+    static std::vector<std::uint8_t> numbered_message(std::uint32_t n)
+    {
+        std::vector<std::uint8_t> payload(100 + n % 800, static_cast<std::uint8_t>(n));
+        payload[0] = static_cast<std::uint8_t>(n >> 24);
+        payload[1] = static_cast<std::uint8_t>(n >> 16);
+        payload[2] = static_cast<std::uint8_t>(n >> 8);
+        payload[3] = static_cast<std::uint8_t>(n);
+
+        Message msg {};
+        msg.type(Message::Type::fft_data);
+        msg.append(std::move(payload));
+        return msg.relinquish();
+    }
+
+    static std::vector<std::uint8_t> configuration_message(std::uint16_t encoder_size)
+    {
+        Network::Colossus_protocol::Configuration config {};
+        config.encoder_size(encoder_size);
+
+        Message msg {};
+        msg.type(Message::Type::configuration);
+        msg.append(config);
+        return msg.relinquish();
+    }
+
+    // Returns false if count messages have not arrived within a second
+    //
+    bool wait_for(std::size_t count)
+    {
+        for (auto deadline = std::chrono::steady_clock::now() + 1s; std::chrono::steady_clock::now() < deadline;) {
+            {
+                std::lock_guard lock { received_mutex };
+                if (received.size() >= count) return true;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return false;
+    }
+};
+
+
+TEST_F(given_a_shared_memory_ring, WhenMessagesArePublishedTheReaderShouldReceiveThemInOrder)
+{
+    std::vector<std::vector<std::uint8_t>> published {};
+    for (std::uint8_t n = 0; n < 10; ++n) {
+        published.push_back(fft_message(n, 10 + n));
+        publisher.publish(published.back());
+    }
+
+    reader.start();
+    ASSERT_TRUE(wait_for(published.size()));
+    reader.stop();
+
+    ASSERT_EQ(published, received);
+    ASSERT_EQ(10u, publisher.messages_published());
+    ASSERT_EQ(0u, reader.messages_lost());
+}
+
+
+TEST_F(given_a_shared_memory_ring, WhenTheReaderFallsARingBehindItShouldSkipToTheOldestAndCountTheLoss)
+{
+    std::vector<std::vector<std::uint8_t>> published {};
+    for (std::uint8_t n = 0; n < 2 * slot_count + 5; ++n) {
+        published.push_back(fft_message(n));
+        publisher.publish(published.back());
+    }
+
+    reader.start();
+    ASSERT_TRUE(wait_for(slot_count));
+    reader.stop();
+
+    std::vector<std::vector<std::uint8_t>> expected { published.end() - slot_count, published.end() };
+    ASSERT_EQ(expected, received);
+    ASSERT_EQ(slot_count + 5, reader.messages_lost());
+}
+
+
+TEST_F(given_a_shared_memory_ring, WhenAMessageIsLargerThanASlotItShouldNotBePublished)
+{
+    publisher.publish(fft_message(1, slot_size));
+    publisher.publish(fft_message(2));
+    publisher.publish(std::vector<std::uint8_t>(Message::header_size() - 1));
+
+    reader.start();
+    ASSERT_TRUE(wait_for(1));
+    reader.stop();
+
+    ASSERT_EQ(1u, publisher.messages_oversized());
+    ASSERT_EQ(1u, publisher.messages_published());
+    ASSERT_EQ(std::vector<std::vector<std::uint8_t>> { fft_message(2) }, received);
+}
+
+
+TEST_F(given_a_shared_memory_ring, WhenAReaderAttachesLateItShouldReceiveTheLatestConfiguration)
+{
+    reader.close();
+    publisher.publish(configuration_message(5600));
+    publisher.publish(configuration_message(2800));
+    publisher.publish(fft_message(1));
+
+    // Only messages published after the reader opens are read from the
+    // ring; the configuration is read once, from its own slot
+    //
+    ASSERT_TRUE(reader.open());
+    publisher.publish(fft_message(2));
+
+    reader.start();
+    ASSERT_TRUE(wait_for(1));
+    std::this_thread::sleep_for(10ms);
+    reader.stop();
+
+    std::lock_guard lock { received_mutex };
+    ASSERT_EQ(std::vector<std::vector<std::uint8_t>> { configuration_message(2800) }, configurations);
+    ASSERT_EQ(std::vector<std::vector<std::uint8_t>> { fft_message(2) }, received);
+    ASSERT_EQ(2u, publisher.messages_published());
+}
+
+
+TEST_F(given_a_shared_memory_ring, WhenPublishingConcurrentlyEveryMessageShouldBeWholeOrCountedLost)
+{
+    constexpr std::uint32_t message_count { 20000 };
+
+    reader.start();
+    std::thread writer { [this] {
+        for (std::uint32_t n = 0; n < message_count; ++n) {
+            publisher.publish(numbered_message(n));
+        }
+    } };
+    writer.join();
+
+    for (auto deadline = std::chrono::steady_clock::now() + 1s; std::chrono::steady_clock::now() < deadline;) {
+        {
+            std::lock_guard lock { received_mutex };
+            if (received.size() + reader.messages_lost() == message_count) break;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    reader.stop();
+
+    ASSERT_EQ(message_count, received.size() + reader.messages_lost());
+
+    // Each message should be in order, and whole
+    //
+    std::int64_t last = -1;
+    for (auto& message : received) {
+        ASSERT_GE(message.size(), Message::header_size() + 4);
+        auto payload = message.data() + Message::header_size();
+        auto n       = (std::uint32_t { payload[0] } << 24) | (payload[1] << 16) | (payload[2] << 8) | payload[3];
+
+        ASSERT_GT(n, last);
+        ASSERT_EQ(numbered_message(n), message) << n;
+        last = n;
+    }
+}
+
+
+TEST_F(given_a_shared_memory_ring, WhenNoRingExistsTheReaderShouldNotOpen)
+{
+    Shared_memory_reader missing { name + "_missing" };
+    ASSERT_FALSE(missing.open());
+}
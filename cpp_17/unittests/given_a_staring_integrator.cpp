@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "../rotation/staring_integrator.h"
+
+using namespace Navtech;
+using namespace std::chrono_literals;
+
+class given_a_staring_integrator : public ::testing::Test {
+protected:
+    static constexpr std::uint16_t range_in_bins { 120 };
+    static constexpr std::uint16_t encoder_size { 5600 };
+
+    Staring_integrator integrator {};
+    std::vector<Rotation_frame_handle> products {};
+    std::mt19937 random { 2856 };
+
+    const std::chrono::steady_clock::time_point start { std::chrono::steady_clock::now() };
+    std::uint16_t sweep { 0 };
+
+    void configure(Staring_profile profile, std::size_t pool_size = 8)
+    {
+        integrator.set_profile(profile);
+        integrator.set_pool_size(pool_size);
+        integrator.configure(range_in_bins, encoder_size);
+        integrator.set_callback([this](const Rotation_frame_handle& frame) { products.push_back(frame); });
+    }
+
+    std::vector<std::uint8_t> make_fft()
+    {
+        std::vector<std::uint8_t> fft(range_in_bins);
+        for (auto& sample : fft) {
+            sample = static_cast<std::uint8_t>(random() % 256);
+        }
+        return fft;
+    }
+
+    void add(const std::vector<std::uint8_t>& fft,
+             std::chrono::milliseconds at,
+             const Continuity& continuity = Continuity {})
+    {
+        Azimuth_record record {};
+        record.azimuth       = 1234;
+        record.sweep_counter = ++sweep;
+        record.continuity    = continuity;
+        integrator.add(record, fft.data(), fft.size(), start + at);
+    }
+
+    void add(std::chrono::milliseconds at, const Continuity& continuity = Continuity {})
+    {
+        add(make_fft(), at, continuity);
+    }
+};
+
+
+TEST_F(given_a_staring_integrator, WhenFlushingEveryFftTheProductShouldBeTheWindow)
+{
+    const std::uint16_t window_length { 4 };
+    configure({ window_length, Integration_mode::max, 0ms }, 16);
+
+    std::deque<std::vector<std::uint8_t>> window {};
+    for (auto n = 0; n < 10; ++n) {
+        window.push_back(make_fft());
+        if (window.size() > window_length) window.pop_front();
+        add(window.back(), std::chrono::milliseconds { n });
+
+        ASSERT_EQ(static_cast<std::size_t>(n + 1), products.size());
+        auto& product = *products.back();
+        ASSERT_EQ(1u, product.azimuth_samples());
+        ASSERT_EQ(static_cast<std::uint64_t>(n + 1), product.rotation());
+        ASSERT_EQ(sweep, product.record(0).sweep_counter);
+
+        for (std::size_t bin = 0; bin < range_in_bins; ++bin) {
+            std::uint8_t expected { 0 };
+            for (auto& fft : window) {
+                expected = std::max(expected, fft[bin]);
+            }
+            ASSERT_EQ(expected, product.row(0)[bin]) << n << ", " << bin;
+        }
+    }
+}
+
+
+TEST_F(given_a_staring_integrator, WhenFftsArriveProductsShouldBeDeliveredEachInterval)
+{
+    configure({ 4, Integration_mode::mean, 100ms });
+
+    // The interval is timed from the first FFT
+    //
+    for (auto at : { 0ms, 30ms, 60ms, 99ms }) {
+        add(at);
+    }
+    ASSERT_TRUE(products.empty());
+
+    add(100ms);
+    ASSERT_EQ(1u, products.size());
+    add(150ms);
+    add(199ms);
+    ASSERT_EQ(1u, products.size());
+    add(200ms);
+    ASSERT_EQ(2u, products.size());
+
+    add(210ms);
+    ASSERT_EQ(300ms, integrator.next_flush() - start);
+}
+
+
+TEST_F(given_a_staring_integrator, WhenFftsStopPollShouldDeliverThoseSinceTheLastProduct)
+{
+    configure({ 4, Integration_mode::mean, 100ms });
+
+    ASSERT_EQ(std::chrono::steady_clock::time_point::max(), integrator.next_flush());
+    ASSERT_FALSE(integrator.poll(start + 1s));
+
+    add(0ms);
+    add(100ms);
+    add(120ms);
+    ASSERT_EQ(1u, products.size());
+    ASSERT_EQ(200ms, integrator.next_flush() - start);
+
+    ASSERT_FALSE(integrator.poll(start + 199ms));
+    ASSERT_TRUE(integrator.poll(start + 200ms));
+    ASSERT_EQ(2u, products.size());
+    ASSERT_EQ(sweep, products.back()->record(0).sweep_counter);
+
+    // Nothing is delivered again until another FFT arrives
+    //
+    ASSERT_EQ(std::chrono::steady_clock::time_point::max(), integrator.next_flush());
+    ASSERT_FALSE(integrator.poll(start + 1s));
+    integrator.flush();
+    ASSERT_EQ(2u, products.size());
+
+    add(1s + 10ms);
+    integrator.flush();
+    ASSERT_EQ(3u, products.size());
+}
+
+
+TEST_F(given_a_staring_integrator, WhenEveryFrameIsHeldProductsShouldBeDropped)
+{
+    configure({ 4, Integration_mode::mean, 0ms }, 2);
+
+    add(0ms);
+    add(1ms);
+    add(2ms);
+    ASSERT_EQ(2u, products.size());
+    ASSERT_EQ(2u, integrator.products_delivered());
+    ASSERT_EQ(1u, integrator.products_dropped());
+
+    products.clear();
+    add(3ms);
+    ASSERT_EQ(1u, products.size());
+    ASSERT_EQ(3u, integrator.products_delivered());
+    ASSERT_EQ(1u, integrator.products_dropped());
+}
+
+
+TEST_F(given_a_staring_integrator, WhenProductsAreDeliveredTheirContinuityShouldCoverTheFftsSinceTheLast)
+{
+    configure({ 4, Integration_mode::mean, 100ms });
+
+    add(0ms);
+    add(10ms, Continuity { 3, false, true });
+    add(20ms, Continuity { 0, true, false });
+    add(100ms, Continuity { 2, false, false });
+    ASSERT_EQ(1u, products.size());
+
+    auto& first = products.back()->continuity();
+    ASSERT_EQ(4u, first.azimuths_received);
+    ASSERT_EQ(2u, first.gaps);
+    ASSERT_EQ(5u, first.azimuths_missing);
+    ASSERT_EQ(1u, first.azimuths_duplicated);
+    ASSERT_EQ(1u, first.sweep_discontinuities);
+
+    add(150ms);
+    add(200ms, Continuity { 0, true, false });
+    ASSERT_EQ(2u, products.size());
+
+    auto& second = products.back()->continuity();
+    ASSERT_EQ(2u, second.azimuths_received);
+    ASSERT_EQ(0u, second.gaps);
+    ASSERT_EQ(0u, second.azimuths_missing);
+    ASSERT_EQ(1u, second.azimuths_duplicated);
+    ASSERT_EQ(0u, second.sweep_discontinuities);
+
+    // Counting starts again when reset
+    //
+    add(210ms, Continuity { 1, false, false });
+    integrator.reset();
+    add(220ms);
+    integrator.flush();
+    ASSERT_EQ(1u, products.back()->continuity().azimuths_received);
+    ASSERT_EQ(0u, products.back()->continuity().gaps);
+}
@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "../rotation/temporal_integrator.h"
+
+using namespace Navtech;
+
+// Each mode and window is checked against a brute-force integration of
+// the rows held in a deque, after every row, including while the window
+// is part-filled.
+//
+class given_a_temporal_integrator : public ::testing::Test {
+protected:
+    static constexpr std::size_t cells { 37 };
+
+    Temporal_integrator integrator {};
+    std::deque<std::vector<std::uint8_t>> window {};
+    std::mt19937 random { 2856 };
+
+    std::vector<std::uint8_t> make_row(std::size_t size = cells)
+    {
+        std::vector<std::uint8_t> row(size);
+        for (auto& sample : row) {
+            sample = static_cast<std::uint8_t>(random() % 256);
+        }
+        return row;
+    }
+
+    // The rows a window of length should hold after row is added
+    //
+    void push(const std::vector<std::uint8_t>& row, std::uint16_t length, Integration_window windowing)
+    {
+        if (window.size() == length) {
+            if (windowing == Integration_window::block) window.clear();
+            else window.pop_front();
+        }
+        window.push_back(row);
+        window.back().resize(cells, 0);
+    }
+
+    std::vector<double> expected(Integration_mode mode) const
+    {
+        std::vector<double> result(cells, 0.0);
+        if (window.empty()) return result;
+
+        for (std::size_t cell = 0; cell < cells; ++cell) {
+            double total   = 0.0;
+            double maximum = 0.0;
+            for (auto& row : window) {
+                total += (mode == Integration_mode::power_mean) ? std::pow(10.0, row[cell] / 20.0) : row[cell];
+                maximum = std::max<double>(maximum, row[cell]);
+            }
+
+            auto mean = total / window.size();
+            if (mode == Integration_mode::max) result[cell] = maximum;
+            else if (mode == Integration_mode::mean) result[cell] = mean;
+            else result[cell] = 20.0 * std::log10(mean);
+        }
+        return result;
+    }
+
+    // The running power sums lose precision as loud rows leave them,
+    // until they are recalculated at the end of each block
+    //
+    void assert_integrated(Integration_mode mode, int row_count) const
+    {
+        auto reference = expected(mode);
+        auto tolerance = (mode == Integration_mode::power_mean) ? 1e-2 : 1e-9;
+
+        std::vector<double> precise(cells);
+        std::vector<std::uint8_t> rounded(cells + 16, 0xcc);
+        integrator.result(precise.data());
+        integrator.result(rounded.data());
+
+        for (std::size_t cell = 0; cell < cells; ++cell) {
+            ASSERT_NEAR(reference[cell], precise[cell], tolerance) << row_count << ", " << cell;
+            ASSERT_NEAR(reference[cell], rounded[cell], 0.5 + tolerance) << row_count << ", " << cell;
+        }
+        for (auto cell = cells; cell < rounded.size(); ++cell) {
+            ASSERT_EQ(0xcc, rounded[cell]) << row_count << ", " << cell;
+        }
+    }
+};
+
+
+TEST_F(given_a_temporal_integrator, WhenRowsAreAddedEveryModeAndWindowShouldMatchBruteForce)
+{
+    for (auto mode : { Integration_mode::mean, Integration_mode::max, Integration_mode::power_mean }) {
+        for (auto windowing : { Integration_window::sliding, Integration_window::block }) {
+            for (std::uint16_t length : { 1, 2, 3, 5, 8, 13 }) {
+                integrator.configure(cells, length, mode, windowing);
+                window.clear();
+
+                for (auto n = 0; n < 5 * length + 3; ++n) {
+                    auto row = make_row();
+                    push(row, length, windowing);
+
+                    ASSERT_EQ(window.size() == length, integrator.add(row.data(), row.size()));
+                    ASSERT_EQ(window.size(), integrator.rows());
+                    ASSERT_EQ(window.size() == length, integrator.full());
+                    assert_integrated(mode, n);
+                }
+            }
+        }
+    }
+}
+
+
+TEST_F(given_a_temporal_integrator, WhenASlidingMaxPeakLeavesTheWindowItShouldNoLongerBeTheResult)
+{
+    const std::uint16_t length { 4 };
+    integrator.configure(1, length, Integration_mode::max);
+
+    // One large sample, at each position in a block, followed by small
+    // ones until it has left the window
+    //
+    for (auto position = 0; position < length; ++position) {
+        integrator.reset();
+        std::uint8_t result {};
+
+        for (auto n = 0; n < 3 * length; ++n) {
+            std::uint8_t sample = (n == position) ? 200 : static_cast<std::uint8_t>(n);
+            integrator.add(&sample, 1);
+            integrator.result(&result);
+
+            auto expected = (n >= position && n < position + length) ? 200 : n;
+            ASSERT_EQ(expected, result) << position << ", " << n;
+        }
+    }
+}
+
+
+TEST_F(given_a_temporal_integrator, WhenRowsAreWrittenInPlaceTheyShouldMatchAddedRows)
+{
+    Temporal_integrator added {};
+
+    for (auto mode : { Integration_mode::mean, Integration_mode::max, Integration_mode::power_mean }) {
+        integrator.configure(cells, 6, mode);
+        added.configure(cells, 6, mode);
+
+        for (auto n = 0; n < 20; ++n) {
+            auto row = make_row();
+            added.add(row.data(), row.size());
+
+            // Asking for the row again before commit() gives the same row
+            //
+            auto dest = integrator.next_row();
+            ASSERT_EQ(dest, integrator.next_row());
+            std::copy(row.begin(), row.end(), dest);
+            ASSERT_EQ(added.full(), integrator.commit());
+            ASSERT_FALSE(integrator.commit());
+
+            std::vector<double> expected(cells), actual(cells);
+            added.result(expected.data());
+            integrator.result(actual.data());
+            ASSERT_EQ(expected, actual) << n;
+        }
+    }
+}
+
+
+TEST_F(given_a_temporal_integrator, WhenAddingShortOrLongRowsTheyShouldBePaddedOrTruncated)
+{
+    integrator.configure(cells, 3, Integration_mode::mean, Integration_window::block);
+
+    for (auto size : { cells / 2, cells + 10, std::size_t { 0 } }) {
+        auto row = make_row(size);
+        push(row, 3, Integration_window::block);
+        integrator.add(row.data(), row.size());
+        assert_integrated(Integration_mode::mean, static_cast<int>(size));
+    }
+}
+
+
+TEST_F(given_a_temporal_integrator, WhenAskedForPartOfTheResultItShouldMatchTheWhole)
+{
+    integrator.configure(cells, 5, Integration_mode::max);
+    for (auto n = 0; n < 7; ++n) {
+        auto row = make_row();
+        integrator.add(row.data(), row.size());
+    }
+
+    std::vector<std::uint8_t> whole(cells);
+    integrator.result(whole.data());
+
+    for (std::size_t first = 0; first <= cells + 2; ++first) {
+        std::vector<std::uint8_t> part(cells + 16, 0xcc);
+        integrator.result(part.data(), first, 10);
+
+        auto count = std::min<std::size_t>(10, cells - std::min(first, cells));
+        for (std::size_t cell = 0; cell < count; ++cell) {
+            ASSERT_EQ(whole[first + cell], part[cell]) << first << ", " << cell;
+        }
+        for (auto cell = count; cell < part.size(); ++cell) {
+            ASSERT_EQ(0xcc, part[cell]) << first << ", " << cell;
+        }
+    }
+}
+
+
+TEST_F(given_a_temporal_integrator, WhenResetTheWindowShouldBeEmpty)
+{
+    for (auto mode : { Integration_mode::mean, Integration_mode::max, Integration_mode::power_mean }) {
+        integrator.configure(cells, 4, mode);
+        for (auto n = 0; n < 9; ++n) {
+            auto row = make_row();
+            integrator.add(row.data(), row.size());
+        }
+
+        integrator.reset();
+        window.clear();
+        ASSERT_EQ(0u, integrator.rows());
+        ASSERT_FALSE(integrator.full());
+        assert_integrated(mode, 0);
+
+        for (auto n = 0; n < 9; ++n) {
+            auto row = make_row();
+            push(row, 4, Integration_window::sliding);
+            integrator.add(row.data(), row.size());
+            assert_integrated(mode, n);
+        }
+    }
+}
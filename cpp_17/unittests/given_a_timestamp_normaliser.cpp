@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../rotation/rotation_frame_pool.h"
+#include "../rotation/timestamp_normaliser.h"
+
+using namespace Navtech;
+using namespace std::chrono_literals;
+
+class given_a_timestamp_normaliser : public ::testing::Test {
+protected:
+    static constexpr std::uint16_t azimuth_samples { 400 };
+    static constexpr std::uint16_t encoder_size { 5600 };
+    static constexpr std::uint16_t encoder_step { encoder_size / azimuth_samples };
+
+    // 4 Hz: 250 ms a rotation, 625 us an azimuth sample
+    //
+    static constexpr std::uint32_t rotation_rate { 4000 };
+    static constexpr std::chrono::nanoseconds azimuth_time { 625us };
+
+    const Radar_time start { to_radar_time(1700000000, 123456789) };
+
+    Timestamp_normaliser normaliser {};
+    Rotation_frame_pool pool { 1, azimuth_samples, 16, encoder_size, Page_size::standard };
+    Rotation_frame_handle frame { pool.acquire() };
+    std::vector<Radar_time> out {};
+
+    void SetUp() override { normaliser.configure(encoder_size, rotation_rate); }
+
+    static std::uint32_t seconds(Radar_time time)
+    {
+        return static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count());
+    }
+
+    static std::uint32_t split_seconds(Radar_time time)
+    {
+        return static_cast<std::uint32_t>((time.time_since_epoch() % 1s).count());
+    }
+
+    Radar_time normalise(std::uint32_t index, Radar_time time)
+    {
+        return normaliser.normalise(static_cast<std::uint16_t>((index % azimuth_samples) * encoder_step),
+                                    seconds(time),
+                                    split_seconds(time));
+    }
+
+    Radar_time normalise_missing(std::uint32_t index)
+    {
+        return normaliser.normalise(static_cast<std::uint16_t>((index % azimuth_samples) * encoder_step), 0, 0);
+    }
+
+    // Row index (first_row + n) holds the time of the nth azimuth after
+    // start, with an extra step added from row step_at
+    //
+    void make_rotation(std::uint16_t first_row,
+                       const std::set<std::uint16_t>& missing,
+                       std::uint16_t step_at         = azimuth_samples,
+                       std::chrono::nanoseconds step = 0ns)
+    {
+        auto& rotation = frame.writable();
+        rotation.clear();
+        std::uint8_t data[16] {};
+
+        for (std::uint16_t n = 0; n < azimuth_samples; ++n) {
+            auto row = static_cast<std::uint16_t>((first_row + n) % azimuth_samples);
+            rotation.invalidate(row);
+            if (missing.count(row) != 0) continue;
+
+            auto time = start + azimuth_time * n + ((n >= step_at) ? step : 0ns);
+            Azimuth_record record {};
+            record.azimuth           = static_cast<std::uint16_t>(row * encoder_step);
+            record.ntp_seconds       = seconds(time);
+            record.ntp_split_seconds = split_seconds(time);
+            rotation.write(row, record, data, sizeof data);
+        }
+    }
+};
+
+
+TEST_F(given_a_timestamp_normaliser, WhenConvertingTimestampsTheyShouldKeepTheirNanoseconds)
+{
+    ASSERT_EQ(1700000000s + 123456789ns, to_radar_time(1700000000, 123456789).time_since_epoch());
+    ASSERT_TRUE(is_valid_timestamp(1700000000, 0));
+    ASSERT_TRUE(is_valid_timestamp(0, 1));
+    ASSERT_FALSE(is_valid_timestamp(0, 0));
+    ASSERT_FALSE(is_valid_timestamp(1700000000, nanoseconds_per_second));
+}
+
+
+TEST_F(given_a_timestamp_normaliser, WhenTimestampsAreGoodTheyShouldBeUnchanged)
+{
+    for (std::uint32_t n = 0; n < 3u * azimuth_samples; ++n) {
+        auto time = start + azimuth_time * n + std::chrono::nanoseconds { (n * 7919) % 20000 };
+        ASSERT_EQ(time, normalise(n, time)) << n;
+    }
+
+    auto counters = normaliser.counters();
+    ASSERT_EQ(3u * azimuth_samples, counters.timestamps);
+    ASSERT_EQ(0u, counters.interpolated);
+    ASSERT_EQ(0u, counters.steps);
+}
+
+
+TEST_F(given_a_timestamp_normaliser, WhenATimestampIsMissingOrRepeatedItShouldBePredicted)
+{
+    normalise(10, start);
+    ASSERT_EQ(start + azimuth_time, normalise_missing(11));
+    ASSERT_EQ(start + azimuth_time * 4, normalise_missing(14));
+
+    // Repeating the last timestamp on a later azimuth is a stale stamp;
+    // on the same azimuth it is a duplicate and kept
+    //
+    auto time = start + azimuth_time * 5;
+    ASSERT_EQ(time, normalise(15, time));
+    ASSERT_EQ(time + azimuth_time, normalise(16, time));
+    ASSERT_EQ(time + azimuth_time, normalise(16, time + azimuth_time));
+
+    ASSERT_EQ(3u, normaliser.counters().interpolated);
+    ASSERT_EQ(0u, normaliser.counters().steps);
+}
+
+
+TEST_F(given_a_timestamp_normaliser, WhenTheClockStepsTheStepShouldBeKeptAndFollowed)
+{
+    normalise(0, start);
+    normalise(1, start + azimuth_time);
+
+    auto stepped = start + azimuth_time * 2 + 2s;
+    ASSERT_EQ(stepped, normalise(2, stepped));
+    ASSERT_EQ(1u, normaliser.counters().steps);
+
+    // Within the tolerance of the prediction is not a step
+    //
+    ASSERT_EQ(stepped + azimuth_time, normalise_missing(3));
+    ASSERT_EQ(stepped + azimuth_time * 2 + 9ms, normalise(4, stepped + azimuth_time * 2 + 9ms));
+    ASSERT_EQ(1u, normaliser.counters().steps);
+
+    ASSERT_EQ(stepped - 1s, normalise(5, stepped - 1s));
+    ASSERT_EQ(2u, normaliser.counters().steps);
+}
+
+
+TEST_F(given_a_timestamp_normaliser, WhenNoRotationRateIsKnownMissingTimestampsShouldRepeat)
+{
+    normaliser.configure(encoder_size, 0);
+
+    normalise(0, start);
+    ASSERT_EQ(start, normalise_missing(5));
+    ASSERT_EQ(start + 10s, normalise(6, start + 10s));
+    ASSERT_EQ(0u, normaliser.counters().steps);
+}
+
+
+TEST_F(given_a_timestamp_normaliser, WhenNoTimestampHasArrivedMissingOnesShouldBeAtTheEpoch)
+{
+    ASSERT_EQ(Radar_time {}, normalise_missing(0));
+    ASSERT_EQ(start, normalise(1, start));
+    ASSERT_EQ(start + azimuth_time, normalise_missing(2));
+}
+
+
+TEST_F(given_a_timestamp_normaliser, WhenAFrameHasGapsTheyShouldBeInterpolated)
+{
+    std::mt19937 random { 2856 };
+
+    for (auto trial = 0; trial < 50; ++trial) {
+        auto first_row = static_cast<std::uint16_t>(random() % azimuth_samples);
+        std::set<std::uint16_t> missing {};
+        for (auto n = random() % 200; n > 0; --n) {
+            missing.insert(static_cast<std::uint16_t>(random() % azimuth_samples));
+        }
+
+        make_rotation(first_row, missing);
+        ASSERT_TRUE(normaliser.normalise(*frame, out, first_row));
+        ASSERT_EQ(azimuth_samples, out.size());
+
+        for (std::uint16_t n = 0; n < azimuth_samples; ++n) {
+            auto row = (first_row + n) % azimuth_samples;
+            ASSERT_EQ(start + azimuth_time * n, out[row]) << trial << ", " << n;
+        }
+    }
+}
+
+
+TEST_F(given_a_timestamp_normaliser, WhenAFrameStepsInAGapTheGapShouldFollowTheEarlierTime)
+{
+    std::set<std::uint16_t> missing { 100, 101, 102, 103, 104 };
+    make_rotation(0, missing, 103, 1s);
+    ASSERT_TRUE(normaliser.normalise(*frame, out));
+
+    for (std::uint16_t row = 0; row < azimuth_samples; ++row) {
+        auto expected = start + azimuth_time * row + ((row >= 105) ? 1s : 0s);
+        ASSERT_EQ(expected, out[row]) << row;
+    }
+}
+
+
+TEST_F(given_a_timestamp_normaliser, WhenAFrameHasNoTimestampsItShouldNotNormalise)
+{
+    std::set<std::uint16_t> missing {};
+    for (std::uint16_t row = 0; row < azimuth_samples; ++row) {
+        missing.insert(row);
+    }
+    make_rotation(0, missing);
+
+    ASSERT_FALSE(normaliser.normalise(*frame, out));
+    ASSERT_EQ(azimuth_samples, out.size());
+    for (auto& time : out) {
+        ASSERT_EQ(Radar_time {}, time);
+    }
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "../rotation/azimuth_resampler.h"
+#include "../rotation/rotation_frame_pool.h"
+
+using namespace Navtech;
+
+class given_an_azimuth_resampler : public ::testing::Test {
+protected:
+    static constexpr std::uint16_t azimuth_samples { 400 };
+    static constexpr std::uint16_t range_in_bins { 200 };
+    static constexpr std::uint16_t encoder_size { 5600 };
+    static constexpr std::uint16_t encoder_step { encoder_size / azimuth_samples };
+
+    Rotation_frame_pool pool { 2, azimuth_samples, range_in_bins, encoder_size, Page_size::standard };
+    Rotation_frame_handle in { pool.acquire() };
+    Rotation_frame_handle out { pool.acquire() };
+    Azimuth_resampler resampler {};
+    std::mt19937 random { 2856 };
+
+    // Fill in, each row's azimuth up to max_jitter encoder counts past
+    // its grid point
+    //
+    void make_rotation(std::uint16_t max_jitter, const std::set<std::uint16_t>& missing = {})
+    {
+        auto& frame = in.writable();
+        frame.clear();
+
+        std::vector<std::uint8_t> data(range_in_bins);
+        for (std::uint16_t index = 0; index < azimuth_samples; ++index) {
+            if (missing.count(index) != 0) {
+                frame.invalidate(index);
+                continue;
+            }
+
+            for (auto& sample : data) {
+                sample = static_cast<std::uint8_t>(random() % 256);
+            }
+
+            Azimuth_record record {};
+            record.azimuth     = static_cast<std::uint16_t>(index * encoder_step + random() % (max_jitter + 1));
+            record.ntp_seconds = index;
+            frame.write(index, record, data.data(), data.size());
+        }
+    }
+
+    // Brute force: for each output row, search outwards for the nearest
+    // received azimuth at or before its grid point and the nearest after
+    // it, and blend them by their encoder positions.
+    //
+    void assert_resampled(std::uint16_t max_gap)
+    {
+        const std::int64_t samples = azimuth_samples;
+        const std::int64_t encoder = encoder_size;
+
+        for (std::int64_t i = 0; i < samples; ++i) {
+            auto grid = i * encoder_step;
+
+            std::int64_t before = -1, before_position = 0;
+            for (std::int64_t d = 0; d < samples && before < 0; ++d) {
+                auto row = (i - d + samples) % samples;
+                if (!in->is_valid(row)) continue;
+
+                auto position = in->record(row).azimuth - ((row > i) ? encoder : 0);
+                if (position <= grid) {
+                    before          = row;
+                    before_position = position;
+                }
+            }
+
+            std::int64_t after = -1, after_position = 0;
+            for (std::int64_t d = 0; d <= samples && after < 0; ++d) {
+                auto row = (i + d) % samples;
+                if (!in->is_valid(row)) continue;
+
+                auto position = in->record(row).azimuth + ((row < i || d == samples) ? encoder : 0);
+                if (position > grid) {
+                    after          = row;
+                    after_position = position;
+                }
+            }
+            ASSERT_GE(before, 0);
+            ASSERT_GE(after, 0);
+
+            // Positions in units of 1 / samples of an encoder count, as the
+            // resampler rounds its weights
+            //
+            auto span        = (after_position - before_position) * samples;
+            auto offset      = (grid - before_position) * samples;
+            auto weight      = std::min<std::int64_t>((offset * 256 + span / 2) / span, 256);
+            auto rows_missed = (after - before + samples - 1) % samples;
+            auto filled      = (weight == 0) || (rows_missed <= max_gap);
+
+            auto index = static_cast<std::uint16_t>(i);
+            ASSERT_EQ(filled, out->is_valid(index)) << i;
+
+            for (std::uint16_t bin = 0; bin < range_in_bins; ++bin) {
+                auto a        = in->row(static_cast<std::uint16_t>(before))[bin];
+                auto b        = in->row(static_cast<std::uint16_t>(after))[bin];
+                auto expected = filled ? (a * (256 - weight) + b * weight + 128) / 256 : 0;
+                ASSERT_EQ(expected, out->row(index)[bin]) << i << ", " << bin;
+            }
+            if (!filled) continue;
+
+            auto nearer = (weight < 128) ? before : after;
+            ASSERT_EQ(grid, out->record(index).azimuth) << i;
+            ASSERT_EQ(static_cast<std::uint32_t>(nearer), out->record(index).ntp_seconds) << i;
+        }
+    }
+};
+
+
+TEST_F(given_an_azimuth_resampler, WhenAzimuthsAreOnTheGridTheRotationShouldBeUnchanged)
+{
+    make_rotation(0);
+    ASSERT_TRUE(resampler.resample(*in, out.writable()));
+
+    ASSERT_TRUE(out->is_complete());
+    for (std::uint16_t index = 0; index < azimuth_samples; ++index) {
+        ASSERT_EQ(0, std::memcmp(in->row(index), out->row(index), range_in_bins)) << index;
+        ASSERT_EQ(in->record(index).azimuth, out->record(index).azimuth);
+    }
+}
+
+
+TEST_F(given_an_azimuth_resampler, WhenAzimuthsAreOffTheGridTheyShouldBeInterpolatedByPosition)
+{
+    for (auto trial = 0; trial < 10; ++trial) {
+        make_rotation(encoder_step - 1);
+        ASSERT_TRUE(resampler.resample(*in, out.writable()));
+        assert_resampled(resampler.max_gap());
+        ASSERT_TRUE(out->is_complete());
+    }
+}
+
+
+TEST_F(given_an_azimuth_resampler, WhenAzimuthsAreMissingTheyShouldBeFilledAcrossTheWrap)
+{
+    make_rotation(encoder_step - 1, { 0, 1, 2, 100, 101, 250, 397, 398, 399 });
+    ASSERT_TRUE(resampler.resample(*in, out.writable()));
+    assert_resampled(resampler.max_gap());
+    ASSERT_TRUE(out->is_complete());
+}
+
+
+TEST_F(given_an_azimuth_resampler, WhenAGapIsWiderThanTheMaximumItShouldBeLeftEmpty)
+{
+    std::set<std::uint16_t> missing { 10, 11, 50, 51, 52, 53, 54, 200 };
+    for (std::uint16_t index = 300; index < 320; ++index) {
+        missing.insert(index);
+    }
+
+    resampler.max_gap(2);
+    make_rotation(encoder_step - 1, missing);
+    ASSERT_TRUE(resampler.resample(*in, out.writable()));
+    assert_resampled(2);
+
+    ASSERT_FALSE(out->is_valid(52));
+    ASSERT_FALSE(out->is_valid(310));
+    ASSERT_TRUE(out->is_valid(11));
+    ASSERT_TRUE(out->is_valid(200));
+}
+
+
+TEST_F(given_an_azimuth_resampler, WhenFewerThanTwoAzimuthsAreReceivedItShouldNotResample)
+{
+    std::set<std::uint16_t> missing {};
+    for (std::uint16_t index = 1; index < azimuth_samples; ++index) {
+        missing.insert(index);
+    }
+    make_rotation(0, missing);
+    out.writable().rotation(99);
+
+    ASSERT_FALSE(resampler.resample(*in, out.writable()));
+    ASSERT_EQ(99u, out->rotation());
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../navigation/peak_kernels.h"
+
+using namespace Navtech;
+
+// The search made by Peak_finder::find_peak_bin on double samples, which
+// the kernels must match bit for bit
+//
+static std::uint16_t reference_peak_bin(const std::vector<double>& data,
+                                        std::uint16_t start_bin,
+                                        std::uint16_t end_bin,
+                                        std::uint8_t bins_to_operate_upon,
+                                        double threshold,
+                                        bool& awaiting_rise)
+{
+    if (start_bin > (end_bin - bins_to_operate_upon)) return end_bin;
+
+    for (auto peakBin = start_bin; peakBin <= end_bin - bins_to_operate_upon; peakBin++) {
+        if (awaiting_rise && data[peakBin] > data[peakBin + 1]) { continue; }
+        else if (awaiting_rise) {
+            awaiting_rise = false;
+        }
+        if (data[peakBin] > threshold && data[peakBin + 1] < data[peakBin]) {
+            awaiting_rise = true;
+            return peakBin;
+        }
+    }
+
+    return end_bin;
+}
+
+
+class given_peak_kernels : public ::testing::Test {
+protected:
+    std::mt19937 random { 2856 };
+
+    // Slowly varying data, with plateaus, and occasional spikes
+    //
+    std::vector<std::uint8_t> random_row(std::size_t size)
+    {
+        std::vector<std::uint8_t> row(size);
+        int level = 60;
+        for (auto& sample : row) {
+            level  = std::clamp(level + static_cast<int>(random() % 7) - 3, 0, 255);
+            auto spike = (random() % 37 == 0);
+            sample     = static_cast<std::uint8_t>(spike ? random() % 256 : level);
+        }
+        return row;
+    }
+
+    std::vector<std::uint32_t> falling {};
+    std::vector<std::uint32_t> candidates {};
+
+    void find_candidates(const std::vector<std::uint8_t>& row, double threshold)
+    {
+        falling.assign(Peak_kernels::mask_words(row.size()), 0xffffffff);
+        candidates.assign(falling.size(), 0xffffffff);
+        Peak_kernels::find_candidates(row.data(), row.size(), threshold, falling.data(), candidates.data());
+    }
+
+    bool is_set(const std::vector<std::uint32_t>& mask, std::size_t bin) const
+    {
+        return (mask[bin / 32] >> (bin % 32)) & 1;
+    }
+};
+
+
+TEST_F(given_peak_kernels, WhenFindingCandidatesTheMasksShouldMatchTheSamples)
+{
+    for (auto threshold : { -1.0, 0.0, 59.5, 60.0, 64.9, 120.0, 254.0, 255.0, 300.0 }) {
+        for (std::size_t size : { 1, 2, 31, 32, 33, 64, 65, 100, 257, 2856 }) {
+            auto row = random_row(size);
+            find_candidates(row, threshold);
+
+            for (std::size_t bin = 0; bin < size; ++bin) {
+                auto fall = (bin + 1 < size) && row[bin] > row[bin + 1];
+                ASSERT_EQ(fall, is_set(falling, bin)) << "bin " << bin << " of " << size;
+                ASSERT_EQ(fall && row[bin] > threshold, is_set(candidates, bin))
+                    << "bin " << bin << " of " << size << " threshold " << threshold;
+            }
+            for (auto bin = size; bin < falling.size() * 32; ++bin) {
+                ASSERT_FALSE(is_set(falling, bin));
+                ASSERT_FALSE(is_set(candidates, bin));
+            }
+        }
+    }
+}
+
+
+TEST_F(given_peak_kernels, WhenSearchingForPeaksTheBinsShouldMatchTheScalarSearch)
+{
+    for (auto trial = 0; trial < 200; ++trial) {
+        auto size      = static_cast<std::uint16_t>(16 + random() % 3000);
+        auto threshold = static_cast<double>(random() % 140);
+        auto bins      = static_cast<std::uint8_t>(5 + random() % 11);
+        auto row       = random_row(size);
+        std::vector<double> samples(row.begin(), row.end());
+
+        find_candidates(row, threshold);
+
+        std::uint16_t expected_bin = 0;
+        std::uint16_t actual_bin   = 0;
+        std::uint16_t start        = static_cast<std::uint16_t>(random() % 60);
+        bool expected_rise         = false;
+        bool actual_rise           = false;
+
+        while (expected_bin != size) {
+            expected_bin = reference_peak_bin(samples, start, size, bins, threshold, expected_rise);
+            actual_bin   = Peak_kernels::next_peak(falling.data(), candidates.data(), start, size, bins, actual_rise);
+
+            ASSERT_EQ(expected_bin, actual_bin) << "trial " << trial << " from " << start;
+            ASSERT_EQ(expected_rise, actual_rise) << "trial " << trial << " from " << start;
+            start = static_cast<std::uint16_t>(expected_bin + bins);
+        }
+    }
+}
+
+
+TEST_F(given_peak_kernels, WhenListingCandidatesEveryCandidateShouldBeListedInOrder)
+{
+    auto row = random_row(1000);
+    find_candidates(row, 50.0);
+
+    std::vector<std::uint16_t> bins(row.size());
+    auto count = Peak_kernels::candidate_bins(candidates.data(), 10, row.size(), bins.data(), bins.size());
+
+    std::vector<std::uint16_t> expected {};
+    for (std::size_t bin = 10; bin + 1 < row.size(); ++bin) {
+        if (row[bin] > row[bin + 1] && row[bin] > 50) expected.push_back(bin);
+    }
+
+    ASSERT_EQ(expected.size(), count);
+    for (std::size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(expected[i], bins[i]);
+    }
+
+    ASSERT_EQ(3u, Peak_kernels::candidate_bins(candidates.data(), 10, row.size(), bins.data(), 3));
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "../navigation/peak_resolve.h"
+#include "../navigation/vector_maths.h"
+
+using namespace Navtech;
+
+// The fit made by Peak_finder before the weights were precomputed:
+// the moments and the normal equations solved for every peak
+//
+static double reference_resolve(const std::vector<double>& data, std::uint16_t peak_bin, std::uint8_t bins)
+{
+    const std::uint8_t bins_to_offset = (bins - 1) / 2;
+    double x[Peak_resolve::max_bins]  = { 0.0 };
+    double y[Peak_resolve::max_bins]  = { 0.0 };
+    auto startValue                   = 0 - bins_to_offset;
+
+    for (auto index = 0; index < bins; index++)
+        x[index] = startValue++;
+
+    auto startBin = peak_bin - bins_to_offset;
+
+    for (auto index = 0; index < bins; index++)
+        y[index] = data[startBin + index];
+
+    double Sx = 0.0, Sx2 = 0.0, Sx3 = 0.0, Sx4 = 0.0;
+    double x2[Peak_resolve::max_bins] = { 0.0 }, x3[Peak_resolve::max_bins] = { 0.0 },
+           x4[Peak_resolve::max_bins] = { 0.0 };
+
+    Vector_maths::scalar_sum(x, bins, Sx);
+    Vector_maths::scalar_square(x, bins, Sx2);
+    Vector_maths::vector_cube(x, bins, x3);
+    Vector_maths::scalar_sum(x3, bins, Sx3);
+    Vector_maths::vector_square(x, bins, x2);
+    Vector_maths::vector_multiply(x2, x2, bins, x4);
+    Vector_maths::scalar_sum(x4, bins, Sx4);
+
+    double Sy = 0.0, Sxy = 0.0, Sx2y = 0.0;
+    double xy[Peak_resolve::max_bins] = { 0.0 }, x2y[Peak_resolve::max_bins] = { 0.0 };
+    Vector_maths::scalar_sum(y, bins, Sy);
+    Vector_maths::vector_multiply(x, y, bins, xy);
+    Vector_maths::scalar_sum(xy, bins, Sxy);
+    Vector_maths::vector_multiply(x2, y, bins, x2y);
+    Vector_maths::scalar_sum(x2y, bins, Sx2y);
+
+    double A[4] = { Sx2, Sx3, Sx4, Sx2y };
+    double B[4] = { Sx, Sx2, Sx3, Sxy };
+    double C[4] = { (double)bins, Sx, Sx2, Sy };
+
+    double F = C[0] / A[0];
+    for (auto index = 0; index <= 3; index++)
+        C[index] = C[index] - (F * A[index]);
+
+    F = B[0] / A[0];
+    for (auto index = 0; index <= 3; index++)
+        B[index] = B[index] - (F * A[index]);
+
+    F = C[1] / B[1];
+    for (auto index = 1; index <= 3; index++)
+        C[index] -= F * B[index];
+
+    double b2 = C[3] / C[2];
+    double b1 = (B[3] - B[2] * b2) / B[1];
+
+    return -b1 / (2 * b2) + startBin - (double)(0 - bins_to_offset);
+}
+
+
+class given_peak_resolve : public ::testing::Test {
+protected:
+    std::mt19937 random { 2856 };
+
+    // A peak at peak_bin, with noise and, for buffered data, fractional samples
+    //
+    std::vector<double> peak_row(std::uint16_t peak_bin, bool fractional)
+    {
+        std::vector<double> row(64);
+        auto centre = peak_bin + (static_cast<double>(random() % 100) - 50.0) / 100.0;
+        auto width  = 1.0 + (random() % 80) / 10.0;
+        for (std::size_t bin = 0; bin < row.size(); ++bin) {
+            auto distance = (bin - centre) / width;
+            auto sample   = 40.0 + 180.0 / (1.0 + distance * distance) + random() % 9;
+            row[bin]      = fractional ? sample + (random() % 1000) / 1000.0 : std::floor(sample);
+        }
+        return row;
+    }
+};
+
+
+TEST_F(given_peak_resolve, WhenResolvingAPeakItShouldMatchTheNormalEquations)
+{
+    for (auto bins = Peak_resolve::min_bins; bins <= Peak_resolve::max_bins; ++bins) {
+        auto resolver = Peak_resolve::resolver(bins);
+        ASSERT_NE(nullptr, resolver);
+
+        for (auto trial = 0; trial < 500; ++trial) {
+            auto row = peak_row(32, trial % 2 == 1);
+
+            auto expected = reference_resolve(row, 32, bins);
+            auto actual   = 32 + resolver(&row[32 - (bins - 1) / 2]);
+
+            ASSERT_NEAR(expected, actual, 1e-9) << bins << " bins, trial " << trial;
+        }
+    }
+}
+
+
+TEST_F(given_peak_resolve, WhenResolvingASymmetricPeakItShouldBeAtThePeakBin)
+{
+    std::vector<double> row { 0, 0, 20, 40, 60, 80, 100, 120, 100, 80, 60, 40, 20, 0, 0, 0 };
+
+    for (auto bins : { 5, 7, 9, 11, 13 }) {
+        auto resolver = Peak_resolve::resolver(static_cast<std::uint8_t>(bins));
+        ASSERT_EQ(0.0, resolver(&row[7 - (bins - 1) / 2]));
+    }
+}
+
+
+TEST_F(given_peak_resolve, WhenTheWindowIsOutOfRangeThereShouldBeNoResolver)
+{
+    ASSERT_EQ(nullptr, Peak_resolve::resolver(Peak_resolve::min_bins - 1));
+    ASSERT_EQ(nullptr, Peak_resolve::resolver(Peak_resolve::max_bins + 1));
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "../rotation/power_codes.h"
+
+using namespace Navtech;
+
+class given_power_codes : public ::testing::Test {
+protected:
+    // The mean power of samples lies between the power of code 0 and
+    // that of code 255
+    //
+    static constexpr double min_power { 1.0 };
+    const double max_power { std::pow(10.0, 255 / 20.0) };
+
+    // The bound given for half_db()
+    //
+    static constexpr double tolerance { 2e-10 };
+
+    std::mt19937 random { 2856 };
+};
+
+
+TEST_F(given_power_codes, WhenConvertingACodeToPowerItShouldMatchPow)
+{
+    for (auto code = 0; code < 256; ++code) {
+        ASSERT_DOUBLE_EQ(std::pow(10.0, code / 20.0), Power_codes::linear_power(static_cast<std::uint8_t>(code)));
+    }
+}
+
+
+TEST_F(given_power_codes, WhenConvertingACodesPowerBackItShouldGiveTheCode)
+{
+    for (auto code = 0; code < 256; ++code) {
+        auto power = Power_codes::linear_power(static_cast<std::uint8_t>(code));
+        ASSERT_NEAR(code, Power_codes::half_db(power), tolerance);
+    }
+}
+
+
+TEST_F(given_power_codes, WhenConvertingAnyMeanPowerItShouldMatchLog10)
+{
+    std::uniform_real_distribution<double> half_dbs { 0.0, 255.0 };
+
+    for (auto trial = 0; trial < 1000000; ++trial) {
+        auto power = std::clamp(std::pow(10.0, half_dbs(random) / 20.0), min_power, max_power);
+        ASSERT_NEAR(20.0 * std::log10(power), Power_codes::half_db(power), tolerance) << power;
+    }
+
+    // Powers either side of each power of two, where the mantissa
+    // series is least accurate
+    //
+    for (auto power = 1.0; power <= max_power; power *= 2.0) {
+        for (auto near : { power, std::nextafter(power, 0.0), power * std::sqrt(2.0), power * 1.999999 }) {
+            if (near < min_power || near > max_power) continue;
+            ASSERT_NEAR(20.0 * std::log10(near), Power_codes::half_db(near), tolerance) << near;
+        }
+    }
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../rotation/rotation_assembler.h"
+
+using namespace Navtech;
+
+class given_rotation_sectors : public ::testing::Test {
+protected:
+    static constexpr std::uint16_t azimuth_samples { 400 };
+    static constexpr std::uint16_t range_in_bins { 64 };
+    static constexpr std::uint16_t encoder_size { 5600 };
+
+    // Copied as each sector is delivered, since the frame is still being
+    // written
+    //
+    struct Received_sector
+    {
+        std::uint16_t first_azimuth;
+        std::uint16_t azimuth_count;
+        std::uint16_t sector;
+        bool last_in_rotation;
+        std::vector<bool> valid;
+        std::vector<std::vector<std::uint8_t>> rows;
+    };
+
+    Rotation_assembler assembler {};
+    std::vector<Received_sector> sectors {};
+    std::vector<std::vector<std::uint8_t>> written { azimuth_samples, std::vector<std::uint8_t>(range_in_bins) };
+    std::mt19937 random { 2856 };
+
+    void SetUp() override
+    {
+        assembler.set_pool_size(2, Page_size::standard);
+        assembler.configure(azimuth_samples, range_in_bins, encoder_size);
+    }
+
+    void record_sector(const Rotation_sector& sector)
+    {
+        Received_sector received { sector.first_azimuth, sector.azimuth_count, sector.sector, sector.last_in_rotation };
+        for (std::uint16_t n = 0; n < sector.azimuth_count; ++n) {
+            received.valid.push_back(sector.is_valid(n));
+            received.rows.emplace_back(sector.row(n), sector.row(n) + range_in_bins);
+        }
+        sectors.push_back(std::move(received));
+    }
+
+    void rotate(std::uint16_t first, std::uint16_t last, const std::set<std::uint16_t>& missing = {})
+    {
+        for (auto index = first; index < last; ++index) {
+            Azimuth_record record {};
+            record.azimuth = static_cast<std::uint16_t>(index * (encoder_size / azimuth_samples));
+            if (missing.count(index) != 0) continue;
+
+            for (auto& sample : written[index]) {
+                sample = static_cast<std::uint8_t>(random() % 256);
+            }
+            assembler.add(record, written[index].data(), written[index].size());
+        }
+    }
+
+    // The first azimuth of the next rotation, which completes this one
+    //
+    void start_next_rotation()
+    {
+        std::vector<std::uint8_t> data(range_in_bins, 0xff);
+        assembler.add(Azimuth_record {}, data.data(), data.size());
+    }
+
+    // Brute force: the sectors of one rotation should tile it in order,
+    // each holding the rows written to it
+    //
+    void assert_tiled(std::uint16_t sector_size, const std::set<std::uint16_t>& missing = {})
+    {
+        std::size_t expected_count = (azimuth_samples + sector_size - 1) / sector_size;
+        ASSERT_EQ(expected_count, sectors.size());
+
+        for (std::size_t s = 0; s < sectors.size(); ++s) {
+            auto& sector = sectors[s];
+            ASSERT_EQ(s, sector.sector);
+            ASSERT_EQ(s * sector_size, sector.first_azimuth);
+            ASSERT_EQ(std::min<std::size_t>(sector_size, azimuth_samples - s * sector_size), sector.azimuth_count);
+            ASSERT_EQ(s + 1 == sectors.size(), sector.last_in_rotation);
+
+            for (std::uint16_t n = 0; n < sector.azimuth_count; ++n) {
+                auto index    = sector.first_azimuth + n;
+                auto received = (missing.count(index) == 0);
+                ASSERT_EQ(received, sector.valid[n]) << index;
+                ASSERT_EQ(received ? written[index] : std::vector<std::uint8_t>(range_in_bins), sector.rows[n])
+                    << index;
+            }
+        }
+    }
+};
+
+
+TEST_F(given_rotation_sectors, WhenEachSectorHasPassedItShouldBeDeliveredInOrder)
+{
+    assembler.set_sector_callback([this](const Rotation_sector& sector) { record_sector(sector); }, 64);
+
+    rotate(300, azimuth_samples);
+    ASSERT_TRUE(sectors.empty());
+
+    rotate(0, 64);
+    ASSERT_TRUE(sectors.empty());
+
+    // The first azimuth of the next sector completes the one before
+    //
+    rotate(64, 65);
+    ASSERT_EQ(1u, sectors.size());
+
+    rotate(65, azimuth_samples);
+    ASSERT_EQ(6u, sectors.size());
+
+    start_next_rotation();
+    assert_tiled(64);
+}
+
+
+TEST_F(given_rotation_sectors, WhenAzimuthsAreMissingTheirRowsShouldBeBlankedBeforeDelivery)
+{
+    assembler.set_sector_callback([this](const Rotation_sector& sector) { record_sector(sector); }, 50);
+
+    // Fill both frames first, so that missing rows would hold stale data
+    //
+    rotate(0, azimuth_samples);
+    rotate(0, azimuth_samples);
+    rotate(0, azimuth_samples);
+
+    // With azimuth 0 missing, azimuth 1 completes the previous rotation
+    //
+    std::set<std::uint16_t> missing { 0, 49, 50, 51, 120, 121, 122, 123, 399 };
+    rotate(0, 2, missing);
+    sectors.clear();
+    rotate(2, azimuth_samples, missing);
+    start_next_rotation();
+
+    assert_tiled(50, missing);
+}
+
+
+TEST_F(given_rotation_sectors, WhenSectorsAreGivenInDegreesTheyShouldBeRoundedToAzimuths)
+{
+    assembler.set_sector_callback_degrees([this](const Rotation_sector& sector) { record_sector(sector); }, 45.0f);
+
+    rotate(100, azimuth_samples);
+    rotate(0, azimuth_samples);
+    start_next_rotation();
+
+    assert_tiled(50);
+}
+
+
+TEST_F(given_rotation_sectors, WhenTheSectorSizeDoesNotDivideTheRotationTheLastShouldBeSmaller)
+{
+    assembler.set_sector_callback([this](const Rotation_sector& sector) { record_sector(sector); }, 67);
+
+    rotate(100, azimuth_samples);
+    rotate(0, azimuth_samples);
+    start_next_rotation();
+
+    assert_tiled(67);
+    ASSERT_EQ(400u - 5 * 67, sectors.back().azimuth_count);
+}
+
+
+TEST_F(given_rotation_sectors, WhenTheRotationIsDeliveredItShouldFollowItsLastSector)
+{
+    std::vector<std::string> events {};
+    assembler.set_sector_callback(
+        [&events](const Rotation_sector& sector) {
+            events.push_back(sector.last_in_rotation ? "last sector" : "sector");
+        },
+        100);
+    assembler.set_rotation_callback([&events](const Rotation_frame_handle&) { events.push_back("rotation"); });
+
+    rotate(100, azimuth_samples);
+    rotate(0, azimuth_samples);
+    start_next_rotation();
+
+    std::vector<std::string> expected { "sector", "sector", "sector", "last sector", "rotation" };
+    ASSERT_EQ(expected, events);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../rotation/row_kernels.h"
+
+using namespace Navtech;
+
+// The vectorised kernels are checked against plain per-sample loops, at
+// sizes either side of the vector width and at unaligned offsets.
+//
+class given_row_kernels : public ::testing::Test {
+protected:
+    std::mt19937 random { 2856 };
+
+    std::vector<std::size_t> sizes()
+    {
+        std::vector<std::size_t> result { 0, 1, 2, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129 };
+        for (auto n = 0; n < 200; ++n) {
+            result.push_back(random() % 3000);
+        }
+        return result;
+    }
+
+    std::vector<std::uint8_t> make_row(std::size_t size)
+    {
+        std::vector<std::uint8_t> row(size);
+        for (auto& sample : row) {
+            sample = static_cast<std::uint8_t>(random() % 256);
+        }
+        return row;
+    }
+};
+
+
+TEST_F(given_row_kernels, WhenBlendingRowsTheResultShouldMatchTheScalarFormula)
+{
+    for (auto size : sizes()) {
+        auto offset = random() % 16;
+        auto first  = make_row(size + offset);
+        auto second = make_row(size + offset);
+
+        for (std::uint16_t weight : { 0, 1, 64, 127, 128, 129, 200, 255, 256, static_cast<int>(random() % 257) }) {
+            std::vector<std::uint8_t> out(size + offset + 16, 0xcc);
+            Row_kernels::blend(first.data() + offset, second.data() + offset, out.data() + offset, size, weight);
+
+            for (std::size_t n = 0; n < size; ++n) {
+                auto expected = (first[offset + n] * (256 - weight) + second[offset + n] * weight + 128) / 256;
+                ASSERT_EQ(expected, out[offset + n]) << size << ", " << weight << ", " << n;
+            }
+            for (auto n = size + offset; n < out.size(); ++n) {
+                ASSERT_EQ(0xcc, out[n]) << size << ", " << weight << ", " << n;
+            }
+        }
+    }
+}
+
+
+TEST_F(given_row_kernels, WhenReducingRowsTheResultShouldMatchTheGroupMaximumAndMean)
+{
+    for (auto size : sizes()) {
+        auto offset = random() % 16;
+        auto in     = make_row(size + offset);
+
+        for (std::uint16_t factor = 1; factor <= 9; ++factor) {
+            auto groups = (size + factor - 1) / factor;
+            std::vector<std::uint8_t> maxima(groups + 16, 0xcc);
+            std::vector<std::uint8_t> means(groups + 16, 0xcc);
+            Row_kernels::reduce_max(in.data() + offset, size, maxima.data(), factor);
+            Row_kernels::reduce_mean(in.data() + offset, size, means.data(), factor);
+
+            for (std::size_t group = 0; group < groups; ++group) {
+                auto start = offset + group * factor;
+                auto count = std::min<std::size_t>(factor, size - group * factor);
+
+                std::uint32_t maximum = 0;
+                std::uint32_t sum     = 0;
+                for (std::size_t n = 0; n < count; ++n) {
+                    maximum = std::max<std::uint32_t>(maximum, in[start + n]);
+                    sum += in[start + n];
+                }
+                ASSERT_EQ(maximum, maxima[group]) << size << ", " << factor << ", " << group;
+                ASSERT_EQ((sum + count / 2) / count, means[group]) << size << ", " << factor << ", " << group;
+            }
+            for (auto group = groups; group < maxima.size(); ++group) {
+                ASSERT_EQ(0xcc, maxima[group]) << size << ", " << factor;
+                ASSERT_EQ(0xcc, means[group]) << size << ", " << factor;
+            }
+        }
+    }
+}
+
+
+TEST_F(given_row_kernels, WhenClippingARowOnlySamplesBeyondKeepShouldBeZeroed)
+{
+    for (auto size : sizes()) {
+        auto offset = random() % 16;
+        auto row    = make_row(size + offset);
+
+        for (std::size_t keep : { std::size_t { 0 }, size / 2, size - std::min<std::size_t>(size, 1), size, size + 5,
+                                  static_cast<std::size_t>(random() % (size + 1)) }) {
+            auto out = row;
+            out.resize(size + offset + 16, 0xcc);
+            Row_kernels::clip(out.data() + offset, size, keep);
+
+            for (std::size_t n = 0; n < size; ++n) {
+                auto expected = (n < keep) ? row[offset + n] : 0;
+                ASSERT_EQ(expected, out[offset + n]) << size << ", " << keep << ", " << n;
+            }
+            for (std::size_t n = 0; n < offset; ++n) {
+                ASSERT_EQ(row[n], out[n]) << size << ", " << keep << ", " << n;
+            }
+            for (auto n = size + offset; n < out.size(); ++n) {
+                ASSERT_EQ(0xcc, out[n]) << size << ", " << keep << ", " << n;
+            }
+        }
+    }
+}
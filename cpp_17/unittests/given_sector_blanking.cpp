@@ -0,0 +1,331 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "../navigation/sector_blanking.h"
+#include "../network/colossus_messages.h"
+#include "../network/radar_client.h"
+
+using namespace Navtech;
+using namespace std::chrono_literals;
+using Network::Colossus_protocol::Message;
+using Utility::Angle;
+
+class given_a_blanking_mask : public ::testing::Test {
+protected:
+    std::mt19937 random { 2856 };
+
+    // The mask against contains() for the angle of every encoder position
+    //
+    static void assert_matches(const Blanking_sector_list& sectors, std::uint16_t encoder_size)
+    {
+        Blanking_mask mask { sectors, encoder_size };
+        ASSERT_EQ(encoder_size, mask.encoder_size());
+
+        std::uint32_t blanked { 0 };
+        for (std::uint32_t azimuth = 0; azimuth < encoder_size; ++azimuth) {
+            auto expected = sectors.contains(Angle { (azimuth * 360.0f) / encoder_size });
+            ASSERT_EQ(expected, mask.is_blanked(static_cast<std::uint16_t>(azimuth))) << sectors << azimuth;
+            if (expected) ++blanked;
+        }
+        ASSERT_EQ(blanked == 0, mask.empty()) << sectors;
+
+        // Positions past the encoder size are never blanked
+        //
+        for (std::uint32_t azimuth = encoder_size; azimuth < encoder_size + 130u && azimuth <= 0xffff; ++azimuth) {
+            ASSERT_FALSE(mask.is_blanked(static_cast<std::uint16_t>(azimuth))) << sectors << azimuth;
+        }
+    }
+
+    Sector random_sector()
+    {
+        std::uniform_real_distribution<float> angle { 0.0f, 360.0f };
+        return Sector { Angle { angle(random) }, Angle { angle(random) } };
+    }
+};
+
+
+TEST_F(given_a_blanking_mask, WhenASectorWrapsThroughZeroItShouldContainBothEnds)
+{
+    Sector sector { 350_deg, 10_deg };
+
+    for (auto angle : { 350.0f, 355.0f, 359.99f, 0.0f, 5.0f, 10.0f }) {
+        ASSERT_TRUE(sector.contains(Angle { angle })) << angle;
+    }
+    for (auto angle : { 10.01f, 180.0f, 349.99f }) {
+        ASSERT_FALSE(sector.contains(Angle { angle })) << angle;
+    }
+
+    Blanking_mask mask { Blanking_sector_list { sector }, 5600 };
+    ASSERT_TRUE(mask.is_blanked(0));
+    ASSERT_TRUE(mask.is_blanked(155));
+    ASSERT_FALSE(mask.is_blanked(156));
+    ASSERT_TRUE(mask.is_blanked(5445));
+    ASSERT_TRUE(mask.is_blanked(5599));
+    ASSERT_FALSE(mask.is_blanked(5444));
+}
+
+
+TEST_F(given_a_blanking_mask, WhenTheListIsEmptyNothingShouldBeBlanked)
+{
+    Blanking_mask mask { Blanking_sector_list {}, 5600 };
+
+    ASSERT_TRUE(mask.empty());
+    for (std::uint16_t azimuth = 0; azimuth < 5600; ++azimuth) {
+        ASSERT_FALSE(mask.is_blanked(azimuth)) << azimuth;
+    }
+
+    Blanking_mask unused {};
+    ASSERT_TRUE(unused.empty());
+    ASSERT_FALSE(unused.is_blanked(0));
+}
+
+
+TEST_F(given_a_blanking_mask, WhenASectorCoversTheWholeCircleEveryPositionShouldBeBlanked)
+{
+    // 360 degrees is the same angle as 0, so a whole circle ends just
+    // before it starts
+    //
+    for (std::uint16_t encoder_size : { 5600, 2800, 64 }) {
+        auto step = 360.0f / encoder_size;
+
+        Blanking_mask mask { Blanking_sector_list { Sector { 90_deg, Angle { 90.0f - step / 2 } } }, encoder_size };
+        for (std::uint16_t azimuth = 0; azimuth < encoder_size; ++azimuth) {
+            ASSERT_TRUE(mask.is_blanked(azimuth)) << encoder_size << ", " << azimuth;
+        }
+
+        Blanking_mask halves { Blanking_sector_list { Sector { 0_deg, 180_deg }, Sector { 180_deg, 0_deg } },
+                               encoder_size };
+        for (std::uint16_t azimuth = 0; azimuth < encoder_size; ++azimuth) {
+            ASSERT_TRUE(halves.is_blanked(azimuth)) << encoder_size << ", " << azimuth;
+        }
+    }
+}
+
+
+TEST_F(given_a_blanking_mask, WhenCompiledItShouldMatchContainsAtEveryEncoderPosition)
+{
+    for (std::uint16_t encoder_size : { 5600, 4096, 2800, 100, 63, 1 }) {
+        for (auto n = 0; n < 20; ++n) {
+            Blanking_sector_list sectors {};
+            for (auto count = random() % 9; count > 0; --count) {
+                sectors.add(random_sector());
+            }
+            assert_matches(sectors, encoder_size);
+        }
+    }
+
+    // Sectors of a single angle, on and between encoder positions
+    //
+    assert_matches(Blanking_sector_list { Sector { 45_deg, 45_deg }, Sector { 100.01_deg, 100.01_deg } }, 5600);
+}
+
+
+TEST_F(given_a_blanking_mask, WhenRecompiledOrClearedTheOldSectorsShouldBeForgotten)
+{
+    Blanking_mask mask { Blanking_sector_list { Sector { 0_deg, 90_deg } }, 5600 };
+    mask.compile(Blanking_sector_list { Sector { 180_deg, 270_deg } }, 2800);
+
+    ASSERT_EQ(2800, mask.encoder_size());
+    ASSERT_FALSE(mask.is_blanked(100));
+    ASSERT_TRUE(mask.is_blanked(1400));
+
+    mask.clear();
+    ASSERT_TRUE(mask.empty());
+    ASSERT_EQ(0, mask.encoder_size());
+    ASSERT_FALSE(mask.is_blanked(1400));
+}
+
+
+// A Radar_client with client blanking, fed one rotation of FFT data by a
+// radar on loopback
+//
+class given_a_radar_client_with_client_blanking : public ::testing::Test {
+protected:
+    static constexpr std::uint16_t encoder_size { 5600 };
+    static constexpr std::uint16_t azimuth_samples { 400 };
+    static constexpr std::uint16_t encoder_step { encoder_size / azimuth_samples };
+    static constexpr std::uint16_t range_in_bins { 100 };
+
+    const Blanking_sector_list sectors { Sector { 90_deg, 180_deg }, Sector { 350_deg, 10_deg } };
+
+    std::uint16_t port { 0 };
+    int listener { -1 };
+    int radar { -1 };
+    Owner_of<Radar_client> client {};
+
+    std::mutex received_mutex {};
+    std::vector<Fft_data::Pointer> ffts {};
+    std::vector<Rotation_frame_handle> rotations {};
+    std::vector<std::uint16_t> sent {};
+
+    void SetUp() override
+    {
+        listener = ::socket(AF_INET, SOCK_STREAM, 0);
+
+        sockaddr_in addr {};
+        addr.sin_family      = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addr_size  = sizeof(addr);
+        ASSERT_EQ(0, ::bind(listener, reinterpret_cast<sockaddr*>(&addr), addr_size));
+        ASSERT_EQ(0, ::listen(listener, 1));
+        ASSERT_EQ(0, ::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &addr_size));
+        port = ntohs(addr.sin_port);
+
+        client = allocate_owned<Radar_client>(Utility::IP_address { "127.0.0.1" }, port);
+        client->set_rotation_pool_size(4, Page_size::standard);
+        client->set_fft_data_callback([this](const Fft_data::Pointer& fft) {
+            std::lock_guard lock { received_mutex };
+            ffts.push_back(fft);
+        });
+        client->set_rotation_callback([this](const Rotation_frame_handle& frame) {
+            std::lock_guard lock { received_mutex };
+            rotations.push_back(frame);
+        });
+    }
+
+    void TearDown() override
+    {
+        client->stop();
+        if (radar != -1) ::close(radar);
+        ::close(listener);
+    }
+
+    void send(const std::vector<std::uint8_t>& data) const { ::send(radar, data.data(), data.size(), MSG_NOSIGNAL); }
+
+    static std::vector<std::uint8_t> configuration()
+    {
+        Network::Colossus_protocol::Configuration config {};
+        config.encoder_size(encoder_size);
+        config.azimuth_samples(azimuth_samples);
+        config.range_in_bins(range_in_bins);
+
+        Colossus::Protobuf::ConfigurationData protobuf {};
+        protobuf.set_rangeresolutionmetres(0.175f);
+
+        Message msg {};
+        msg.type(Message::Type::configuration);
+        msg.append(config);
+        msg.append(protobuf.SerializeAsString());
+        return msg.relinquish();
+    }
+
+    // Every bin of azimuth index n holds n % 200 + 1, so that none is zero
+    //
+    static std::vector<std::uint8_t> fft(std::uint16_t index)
+    {
+        Network::Colossus_protocol::Fft_data header {};
+        header.azimuth(static_cast<std::uint16_t>(index * encoder_step));
+        header.sweep_counter(index);
+
+        Message msg {};
+        msg.type(Message::Type::fft_data);
+        msg.append(header);
+        msg.append(std::vector<std::uint8_t>(range_in_bins, static_cast<std::uint8_t>(index % 200 + 1)));
+        return msg.relinquish();
+    }
+
+    static bool is_blanked(std::uint16_t index, const Blanking_sector_list& list)
+    {
+        return list.contains(Angle { (index * encoder_step * 360.0f) / encoder_size });
+    }
+
+    // The end of a rotation, which is discarded as partial, a whole
+    // rotation, and the first azimuth of the next to complete it
+    //
+    void run(Blanking_action action)
+    {
+        client->set_client_blanking(sectors, action);
+        client->start();
+
+        pollfd pfd { listener, POLLIN, 0 };
+        ASSERT_EQ(1, ::poll(&pfd, 1, 5000));
+        radar = ::accept(listener, nullptr, nullptr);
+        ASSERT_NE(-1, radar);
+
+        for (std::uint16_t index = azimuth_samples - 10; index < azimuth_samples; ++index) {
+            sent.push_back(index);
+        }
+        for (std::uint16_t index = 0; index <= azimuth_samples; ++index) {
+            sent.push_back(index % azimuth_samples);
+        }
+
+        send(configuration());
+        for (auto index : sent) {
+            send(fft(index));
+        }
+
+        for (auto deadline = std::chrono::steady_clock::now() + 2s; std::chrono::steady_clock::now() < deadline;) {
+            {
+                std::lock_guard lock { received_mutex };
+                if (!rotations.empty()) break;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        client->stop();
+        ASSERT_EQ(1u, rotations.size());
+    }
+};
+
+
+TEST_F(given_a_radar_client_with_client_blanking, WhenDroppingBlankedAzimuthsShouldNotBeDelivered)
+{
+    run(Blanking_action::drop);
+
+    std::vector<std::uint16_t> expected {};
+    for (auto index : sent) {
+        if (!is_blanked(index, sectors)) expected.push_back(index * encoder_step);
+    }
+
+    std::vector<std::uint16_t> delivered {};
+    for (auto& fft : ffts) {
+        delivered.push_back(fft->azimuth);
+    }
+    ASSERT_EQ(expected, delivered);
+
+    auto& frame = *rotations[0];
+    for (std::uint16_t index = 0; index < azimuth_samples; ++index) {
+        ASSERT_EQ(!is_blanked(index, sectors), frame.is_valid(index)) << index;
+        auto expected_sample = is_blanked(index, sectors) ? 0 : index % 200 + 1;
+        ASSERT_EQ(expected_sample, frame.row(index)[0]) << index;
+    }
+}
+
+
+TEST_F(given_a_radar_client_with_client_blanking, WhenZeroingBlankedAzimuthsShouldBeDeliveredWithoutData)
+{
+    run(Blanking_action::zero);
+
+    ASSERT_EQ(sent.size(), ffts.size());
+    for (std::size_t n = 0; n < sent.size(); ++n) {
+        auto index = sent[n];
+        auto& fft  = ffts[n];
+        ASSERT_EQ(index * encoder_step, fft->azimuth);
+        ASSERT_EQ(range_in_bins, fft->data.size()) << index;
+
+        auto expected_sample = is_blanked(index, sectors) ? 0 : index % 200 + 1;
+        ASSERT_EQ(std::vector<std::uint8_t>(range_in_bins, expected_sample), fft->data) << index;
+    }
+
+    // Zeroed azimuths were received, so their rows are valid
+    //
+    auto& frame = *rotations[0];
+    for (std::uint16_t index = 0; index < azimuth_samples; ++index) {
+        ASSERT_TRUE(frame.is_valid(index)) << index;
+        auto expected_sample = is_blanked(index, sectors) ? 0 : index % 200 + 1;
+        for (std::uint16_t bin = 0; bin < range_in_bins; ++bin) {
+            ASSERT_EQ(expected_sample, frame.row(index)[bin]) << index << ", " << bin;
+        }
+    }
+}
@@ -63,8 +63,8 @@ void Laser_scan_publisher::publish_laser_scan(const Navtech::Fft_data::Pointer&
     message.angle_increment = M_PI / 180 * 360 / azimuth_samples;
     message.time_increment = 1.0 / expected_rotation_rate / azimuth_samples;
     message.scan_time = 1.0 / expected_rotation_rate;
-    message.range_min = 1.0 * bin_size;
-    message.range_max = range_in_bins * bin_size;
+    message.range_min = range_table->range(1);
+    message.range_max = range_table->range(range_in_bins);
     message.ranges.resize(azimuth_samples);
     message.ranges = range_values;
     message.intensities.resize(azimuth_samples);
@@ -80,7 +80,7 @@ void Laser_scan_publisher::fft_data_handler(const Navtech::Fft_data::Pointer& da
                     break;
                 }
     }
-    float range = bin_size * first_peak_bin_index;
+    float range = range_table->range(data->first_bin + first_peak_bin_index);
     float intensity = data->data[first_peak_bin_index];
     int azimuth_index = static_cast<int>(data->angle / (360.0 / azimuth_samples));
 
@@ -191,6 +191,9 @@ void Laser_scan_publisher::configuration_data_handler(const Navtech::Configurati
 
     azimuth_samples = data->azimuth_samples;
     bin_size = data->bin_size;
+    if (data->range_table) {
+        range_table = data->range_table;
+    }
     end_bin = data->range_in_bins;
     range_in_bins = data->range_in_bins;
     expected_rotation_rate = data->expected_rotation_rate;
@@ -108,8 +108,8 @@ void Navigation_mode_point_cloud_publisher::publish_point_cloud(const Navtech::N
     for (unsigned i = 0; i < intensity_values.size(); i++) {
 
         float current_azimuth = (azimuth_values[i] * 0.9) * (M_PI / 180.0);
-        float point_x = bin_values[i] * cos(current_azimuth);
-        float point_y = bin_values[i] * sin(current_azimuth);
+        float point_x = range_values[i] * cos(current_azimuth);
+        float point_y = range_values[i] * sin(current_azimuth);
 
         auto vec = floats_to_uint8_t_vector(point_x, point_y, 0, intensity_values[i]);
         data_vector.insert(data_vector.end(), vec.begin(), vec.end());
@@ -205,11 +205,11 @@ void Navigation_mode_point_cloud_publisher::navigation_data_handler(const Navtec
 
         for (unsigned peak_index = 0; peak_index < data->peaks.size(); peak_index++) {
             float target_range = std::get<float>(data->peaks[peak_index]);
-            int bin_index = static_cast<int>(target_range / bin_size);
+            int bin_index = static_cast<int>(range_table->bin_at(target_range));
             float target_power = (std::get<uint16_t>(data->peaks[peak_index]) / 10.0);
             if ((bin_index >= start_bin) && (bin_index < end_bin)) {
                 azimuth_values.push_back(adjusted_azimuth_index);
-                bin_values.push_back(bin_index);
+                range_values.push_back(target_range);
                 intensity_values.push_back(target_power);
             }
         }
@@ -219,7 +219,7 @@ void Navigation_mode_point_cloud_publisher::navigation_data_handler(const Navtec
         rotation_count++;
         rotated_once = true;
         publish_point_cloud(data);
-        bin_values.clear();
+        range_values.clear();
         azimuth_values.clear();
         intensity_values.clear();
     }
@@ -370,6 +370,9 @@ void Navigation_mode_point_cloud_publisher::configuration_data_handler(const Nav
 
     azimuth_samples = data->azimuth_samples;
     bin_size = data->bin_size;
+    if (data->range_table) {
+        range_table = data->range_table;
+    }
     range_in_bins = data->range_in_bins;
     expected_rotation_rate = data->expected_rotation_rate;
     config_message.azimuth_samples = Navtech::Utility::to_vector(Navtech::Utility::to_uint16_network(data->azimuth_samples));
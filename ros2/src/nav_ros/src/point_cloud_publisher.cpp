@@ -97,8 +97,8 @@ void Point_cloud_publisher::publish_point_cloud(const Navtech::Fft_data::Pointer
     for (unsigned i = 0; i < intensity_values.size(); i++) {
 
         float current_azimuth = (azimuth_values[i] * 0.9) * (M_PI / 180.0);
-        float point_x = bin_values[i] * cos(current_azimuth);
-        float point_y = bin_values[i] * sin(current_azimuth);
+        float point_x = range_values[i] * cos(current_azimuth);
+        float point_y = range_values[i] * sin(current_azimuth);
 
         auto vec = Point_cloud_publisher::floats_to_uint8_t_vector(point_x, point_y, 0, intensity_values[i]);
         data_vector.insert(data_vector.end(), vec.begin(), vec.end());
@@ -139,7 +139,7 @@ void Point_cloud_publisher::fft_data_handler(const Navtech::Fft_data::Pointer& d
             if ((bin_index >= start_bin) && (bin_index < end_bin)) {
                 if (data->data[bin_index] > power_threshold) {
                     azimuth_values.push_back(adjusted_azimuth_index);
-                    bin_values.push_back(bin_index);
+                    range_values.push_back(range_table->range(data->first_bin + bin_index));
                     intensity_values.push_back(data->data[bin_index]);
                 }
             }
@@ -150,7 +150,7 @@ void Point_cloud_publisher::fft_data_handler(const Navtech::Fft_data::Pointer& d
         rotation_count++;
         rotated_once = true;
         Point_cloud_publisher::publish_point_cloud(data);
-        bin_values.clear();
+        range_values.clear();
         azimuth_values.clear();
         intensity_values.clear();
     }
@@ -239,6 +239,9 @@ void Point_cloud_publisher::configuration_data_handler(const Navtech::Configurat
 
     azimuth_samples = data->azimuth_samples;
     bin_size = data->bin_size;
+    if (data->range_table) {
+        range_table = data->range_table;
+    }
     end_bin = data->range_in_bins;
     range_in_bins = data->range_in_bins;
     expected_rotation_rate = data->expected_rotation_rate;
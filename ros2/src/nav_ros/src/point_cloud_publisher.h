@@ -54,11 +54,12 @@ private:
     uint16_t azimuth_offset{ 0 };
 
     std::vector <float> azimuth_values;
-    std::vector <float> bin_values;
+    std::vector <float> range_values;
     std::vector <float> intensity_values;
 
     int azimuth_samples{ 0 };
     float bin_size{ 0 };
+    Navtech::Range_table::Pointer range_table{ std::make_shared<const Navtech::Range_table>() };
     int range_in_bins{ 0 };
     int expected_rotation_rate{ 0 };
     int last_azimuth{ 0 };